@@ -0,0 +1,248 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file alphabet.cc
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// The alphabet tables and the routines that use them. Each 256-entry table
+/// is an initializer list of calls to a constexpr function of the byte
+/// value, so the compiler fills it in and it is placed in read-only data.
+
+#include "alphabet.hh"
+#include "seq.hh"
+
+#include <cstring>
+
+namespace bios {
+
+namespace alphabet {
+
+// Expands to f(0), f(1), ..., f(255).
+#define ALPHABET_ROW(f, i) \
+  f(i), f(i + 1), f(i + 2), f(i + 3), f(i + 4), f(i + 5), f(i + 6), \
+  f(i + 7), f(i + 8), f(i + 9), f(i + 10), f(i + 11), f(i + 12), \
+  f(i + 13), f(i + 14), f(i + 15)
+#define ALPHABET_TABLE(f) \
+  ALPHABET_ROW(f, 0), ALPHABET_ROW(f, 16), ALPHABET_ROW(f, 32), \
+  ALPHABET_ROW(f, 48), ALPHABET_ROW(f, 64), ALPHABET_ROW(f, 80), \
+  ALPHABET_ROW(f, 96), ALPHABET_ROW(f, 112), ALPHABET_ROW(f, 128), \
+  ALPHABET_ROW(f, 144), ALPHABET_ROW(f, 160), ALPHABET_ROW(f, 176), \
+  ALPHABET_ROW(f, 192), ALPHABET_ROW(f, 208), ALPHABET_ROW(f, 224), \
+  ALPHABET_ROW(f, 240)
+
+// Character classes in the C locale, as used by the old runtime-built
+// tables.
+static constexpr bool is_lower(unsigned c) {
+  return c >= 'a' && c <= 'z';
+}
+
+static constexpr bool is_upper(unsigned c) {
+  return c >= 'A' && c <= 'Z';
+}
+
+static constexpr unsigned to_lower(unsigned c) {
+  return is_upper(c) ? c + ('a' - 'A') : c;
+}
+
+static constexpr unsigned to_upper(unsigned c) {
+  return is_lower(c) ? c - ('a' - 'A') : c;
+}
+
+static constexpr bool is_space_or_digit(unsigned c) {
+  return c == ' ' || (c >= '\t' && c <= '\r') || (c >= '0' && c <= '9');
+}
+
+static constexpr bool is_nucleotide_char(unsigned c) {
+  return to_lower(c) == 'a' || to_lower(c) == 'c' || to_lower(c) == 'g' ||
+      to_lower(c) == 't' || to_lower(c) == 'u' || to_lower(c) == 'n';
+}
+
+static constexpr int8_t base_val(unsigned c) {
+  return to_lower(c) == 't' ? T_BASE_VAL
+      : to_lower(c) == 'u' ? U_BASE_VAL
+      : to_lower(c) == 'c' ? C_BASE_VAL
+      : to_lower(c) == 'a' ? A_BASE_VAL
+      : to_lower(c) == 'g' ? G_BASE_VAL
+      : -1;
+}
+
+static constexpr int8_t nt_val_lower(unsigned c) {
+  return is_lower(c) ? base_val(c) : -1;
+}
+
+static constexpr int8_t nt_val_upper(unsigned c) {
+  return is_upper(c) ? base_val(c) : -1;
+}
+
+static constexpr int8_t nt_val_5(unsigned c) {
+  return base_val(c) >= 0 ? base_val(c)
+      : is_space_or_digit(c) ? -1
+      : N_BASE_VAL;
+}
+
+static constexpr int8_t nt_val_no_n(unsigned c) {
+  return base_val(c) >= 0 ? base_val(c) : T_BASE_VAL;
+}
+
+static constexpr int8_t nt_val_masked(unsigned c) {
+  return is_space_or_digit(c) ? -1
+      : (base_val(c) >= 0 ? base_val(c) : N_BASE_VAL) |
+        (is_lower(c) ? MASKED_BASE_BIT : 0);
+}
+
+static constexpr char val_to_nt(unsigned v) {
+  return (v & ~MASKED_BASE_BIT) == T_BASE_VAL ? 't'
+      : (v & ~MASKED_BASE_BIT) == C_BASE_VAL ? 'c'
+      : (v & ~MASKED_BASE_BIT) == A_BASE_VAL ? 'a'
+      : (v & ~MASKED_BASE_BIT) == G_BASE_VAL ? 'g'
+      : (v & ~MASKED_BASE_BIT) == N_BASE_VAL ? 'n'
+      : 0;
+}
+
+static constexpr char val_to_nt_masked(unsigned v) {
+  return v > (N_BASE_VAL | MASKED_BASE_BIT) ? 0
+      : v & MASKED_BASE_BIT ? val_to_nt(v)
+      : to_upper(val_to_nt(v));
+}
+
+static constexpr char nt_char(unsigned c) {
+  return is_nucleotide_char(c) ? to_lower(c) : c == '-' ? 'n' : 0;
+}
+
+static constexpr char nt_mixed_case_char(unsigned c) {
+  return is_nucleotide_char(c) ? c : c == '-' ? 'n' : 0;
+}
+
+constexpr char kValToAa[20] = {
+  'A', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'K', 'L',
+  'M', 'N', 'P', 'Q', 'R', 'S', 'T', 'V', 'W', 'Y',
+};
+
+static constexpr int8_t aa_index(unsigned upper, int i) {
+  return i == 20 ? -1
+      : static_cast<unsigned>(kValToAa[i]) == upper ? i
+      : aa_index(upper, i + 1);
+}
+
+static constexpr int8_t aa_val(unsigned c) {
+  return aa_index(to_upper(c), 0);
+}
+
+static constexpr char aa_char(unsigned c) {
+  return aa_val(c) >= 0 || to_upper(c) == 'X' ? to_upper(c) : 0;
+}
+
+constexpr int8_t kNtVal[256] = {ALPHABET_TABLE(base_val)};
+constexpr int8_t kNtValLower[256] = {ALPHABET_TABLE(nt_val_lower)};
+constexpr int8_t kNtValUpper[256] = {ALPHABET_TABLE(nt_val_upper)};
+constexpr int8_t kNtVal5[256] = {ALPHABET_TABLE(nt_val_5)};
+constexpr int8_t kNtValNoN[256] = {ALPHABET_TABLE(nt_val_no_n)};
+constexpr int8_t kNtValMasked[256] = {ALPHABET_TABLE(nt_val_masked)};
+constexpr char kValToNt[16] = {ALPHABET_ROW(val_to_nt, 0)};
+constexpr char kValToNtMasked[256] = {ALPHABET_TABLE(val_to_nt_masked)};
+constexpr char kNtChars[256] = {ALPHABET_TABLE(nt_char)};
+constexpr char kNtMixedCaseChars[256] = {ALPHABET_TABLE(nt_mixed_case_char)};
+constexpr int8_t kAaVal[256] = {ALPHABET_TABLE(aa_val)};
+constexpr char kAaChars[256] = {ALPHABET_TABLE(aa_char)};
+
+#undef ALPHABET_TABLE
+#undef ALPHABET_ROW
+
+namespace {
+
+struct CodonRow {
+  const char* codon;  // Lower case.
+  char protein_code;  // Upper case. The "Standard" code.
+  char mito_code;     // Upper case. Vertebrate mitochondrial translations.
+};
+
+}  // namespace
+
+// Indexed by codon value; 0 marks a stop codon.
+static constexpr CodonRow kCodonTable[64] = {
+  {"ttt", 'F', 'F'}, {"ttc", 'F', 'F'}, {"tta", 'L', 'L'}, {"ttg", 'L', 'L'},
+  {"tct", 'S', 'S'}, {"tcc", 'S', 'S'}, {"tca", 'S', 'S'}, {"tcg", 'S', 'S'},
+  {"tat", 'Y', 'Y'}, {"tac", 'Y', 'Y'}, {"taa", 0, 0}, {"tag", 0, 0},
+  {"tgt", 'C', 'C'}, {"tgc", 'C', 'C'}, {"tga", 0, 'W'}, {"tgg", 'W', 'W'},
+
+  {"ctt", 'L', 'L'}, {"ctc", 'L', 'L'}, {"cta", 'L', 'L'}, {"ctg", 'L', 'L'},
+  {"cct", 'P', 'P'}, {"ccc", 'P', 'P'}, {"cca", 'P', 'P'}, {"ccg", 'P', 'P'},
+  {"cat", 'H', 'H'}, {"cac", 'H', 'H'}, {"caa", 'Q', 'Q'}, {"cag", 'Q', 'Q'},
+  {"cgt", 'R', 'R'}, {"cgc", 'R', 'R'}, {"cga", 'R', 'R'}, {"cgg", 'R', 'R'},
+
+  {"att", 'I', 'I'}, {"atc", 'I', 'I'}, {"ata", 'I', 'M'}, {"atg", 'M', 'M'},
+  {"act", 'T', 'T'}, {"acc", 'T', 'T'}, {"aca", 'T', 'T'}, {"acg", 'T', 'T'},
+  {"aat", 'N', 'N'}, {"aac", 'N', 'N'}, {"aaa", 'K', 'K'}, {"aag", 'K', 'K'},
+  {"agt", 'S', 'S'}, {"agc", 'S', 'S'}, {"aga", 'R', 0}, {"agg", 'R', 0},
+
+  {"gtt", 'V', 'V'}, {"gtc", 'V', 'V'}, {"gta", 'V', 'V'}, {"gtg", 'V', 'V'},
+  {"gct", 'A', 'A'}, {"gcc", 'A', 'A'}, {"gca", 'A', 'A'}, {"gcg", 'A', 'A'},
+  {"gat", 'D', 'D'}, {"gac", 'D', 'D'}, {"gaa", 'E', 'E'}, {"gag", 'E', 'E'},
+  {"ggt", 'G', 'G'}, {"ggc", 'G', 'G'}, {"gga", 'G', 'G'}, {"ggg", 'G', 'G'},
+};
+
+int codon_val(const char* start) {
+  int v1 = nt_val(start[0]);
+  int v2 = nt_val(start[1]);
+  int v3 = nt_val(start[2]);
+  if ((v1 | v2 | v3) < 0) {
+    return -1;
+  }
+  return (v1 << 4) | (v2 << 2) | v3;
+}
+
+char lookup_codon(const char* dna) {
+  int val = codon_val(dna);
+  return val < 0 ? 'X' : kCodonTable[val].protein_code;
+}
+
+char lookup_mitochondrial_codon(const char* dna) {
+  int val = codon_val(dna);
+  return val < 0 ? 'X' : kCodonTable[val].mito_code;
+}
+
+const char* val_to_codon(int val) {
+  return kCodonTable[val].codon;
+}
+
+void filter(const char* in, char* out, const char table[256]) {
+  char c;
+  while ((c = *in++) != 0) {
+    if ((c = table[static_cast<uint8_t>(c)]) != 0) {
+      *out++ = c;
+    }
+  }
+  *out = 0;
+}
+
+void base_histogram(const char* dna, int size, int histogram[4]) {
+  memset(histogram, 0, 4 * sizeof(int));
+  for (int i = 0; i < size; ++i) {
+    int val = nt_val(dna[i]);
+    if (val >= 0) {
+      ++histogram[val];
+    }
+  }
+}
+
+}; // namespace alphabet
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
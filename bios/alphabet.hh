@@ -0,0 +1,110 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file alphabet.hh
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// Lookup tables for the nucleotide and amino acid alphabets, and the
+/// routines built on them. The tables are constexpr data computed by the
+/// compiler, so they cost nothing at startup and are read without going
+/// through Sequencer::GetInstance(). Base values are those of seq.hh:
+/// T = 0, C = 1, A = 2, G = 3, N = 4, with MASKED_BASE_BIT for lower case.
+
+#ifndef BIOS_ALPHABET_H__
+#define BIOS_ALPHABET_H__
+
+#include <stdint.h>
+
+namespace bios {
+
+namespace alphabet {
+
+/// Base value of ACGTU in either case, -1 for anything else.
+extern const int8_t kNtVal[256];
+
+/// Like kNtVal, but only for lower-case bases.
+extern const int8_t kNtValLower[256];
+
+/// Like kNtVal, but only for upper-case bases.
+extern const int8_t kNtValUpper[256];
+
+/// Like kNtVal, but N_BASE_VAL for anything else except white space and
+/// digits, which stay -1.
+extern const int8_t kNtVal5[256];
+
+/// Like kNtVal, but T_BASE_VAL for anything else.
+extern const int8_t kNtValNoN[256];
+
+/// Like kNtVal5, with MASKED_BASE_BIT set for lower-case letters.
+extern const int8_t kNtValMasked[256];
+
+/// Lower-case base for a value from kNtVal5, with or without
+/// MASKED_BASE_BIT.
+extern const char kValToNt[16];
+
+/// Base for a value from kNtValMasked, in lower case if it is masked.
+extern const char kValToNtMasked[256];
+
+/// Lower-case base for ACGTUN in either case, 'n' for '-', 0 otherwise.
+extern const char kNtChars[256];
+
+/// Like kNtChars, but keeping the case.
+extern const char kNtMixedCaseChars[256];
+
+/// Index 0-19 of an amino acid letter in either case, -1 otherwise.
+extern const int8_t kAaVal[256];
+
+/// Upper-case letter for an amino acid or X in either case, 0 otherwise.
+extern const char kAaChars[256];
+
+/// Amino acid letter for an index 0-19.
+extern const char kValToAa[20];
+
+/// @brief Returns the base value of c, or -1 if it is not a base.
+static inline int nt_val(char c) {
+  return kNtVal[static_cast<uint8_t>(c)];
+}
+
+/// @brief Returns the amino acid of the codon at dna in the standard code,
+///        0 for a stop codon, or 'X' if the codon has a non-base in it.
+char lookup_codon(const char* dna);
+
+/// @brief Like lookup_codon(), in the vertebrate mitochondrial code.
+char lookup_mitochondrial_codon(const char* dna);
+
+/// @brief Returns the value 0-63 of the codon at start, or -1 if it has a
+///        non-base in it.
+int codon_val(const char* start);
+
+/// @brief Returns the lower-case codon with value val, 0-63.
+const char* val_to_codon(int val);
+
+/// @brief Copies the NUL-terminated string in to out through table,
+///        dropping characters that map to 0, and NUL-terminates out.
+void filter(const char* in, char* out, const char table[256]);
+
+/// @brief Counts the bases in dna by value, ignoring non-bases.
+void base_histogram(const char* dna, int size, int histogram[4]);
+
+}; // namespace alphabet
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
+#endif /* BIOS_ALPHABET_H__ */
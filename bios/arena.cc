@@ -0,0 +1,124 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file arena.cc
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// Implementation of the arena allocator.
+
+#include "arena.hh"
+
+namespace bios {
+
+const size_t Arena::kDefaultBlockSize;
+const size_t Arena::kMaxAlignment;
+const size_t Arena::kCleanupSize;
+
+Arena::Arena(size_t block_size)
+    : block_size_(block_size),
+      blocks_(NULL),
+      ptr_(NULL),
+      limit_(NULL),
+      cleanups_(NULL),
+      bytes_reserved_(0),
+      bytes_used_(0) {
+}
+
+Arena::~Arena() {
+  RunCleanups();
+  while (blocks_ != NULL) {
+    Block* next = blocks_->next;
+    ::operator delete(blocks_);
+    blocks_ = next;
+  }
+}
+
+void Arena::RunCleanups() {
+  // Newest first, so objects are destroyed in the reverse order of creation.
+  for (Cleanup* cleanup = cleanups_; cleanup != NULL; ) {
+    Cleanup* next = cleanup->next;
+    cleanup->destroy(reinterpret_cast<char*>(cleanup) + kCleanupSize);
+    cleanup = next;
+  }
+  cleanups_ = NULL;
+}
+
+void* Arena::AllocateSlow(size_t size, size_t alignment) {
+  size_t needed = size + alignment - 1;
+  if (needed > block_size_ / 4) {
+    // Large requests get a block of their own, so the rest of the current
+    // block is not wasted. It goes behind the current block in the list.
+    Block* block = static_cast<Block*>(
+        ::operator new(sizeof(Block) + needed));
+    block->size = needed;
+    if (blocks_ == NULL) {
+      block->next = NULL;
+      blocks_ = block;
+    } else {
+      block->next = blocks_->next;
+      blocks_->next = block;
+    }
+    bytes_reserved_ += needed;
+    bytes_used_ += needed;
+    uintptr_t p = reinterpret_cast<uintptr_t>(block + 1);
+    p = (p + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+    return reinterpret_cast<void*>(p);
+  }
+
+  Block* block = static_cast<Block*>(
+      ::operator new(sizeof(Block) + block_size_));
+  block->size = block_size_;
+  block->next = blocks_;
+  blocks_ = block;
+  bytes_reserved_ += block_size_;
+  ptr_ = reinterpret_cast<char*>(block + 1);
+  limit_ = ptr_ + block_size_;
+  return Allocate(size, alignment);
+}
+
+void Arena::Reset() {
+  RunCleanups();
+  // Keep the oldest regular block; it is the one every arena needs.
+  Block* keep = NULL;
+  while (blocks_ != NULL) {
+    Block* next = blocks_->next;
+    if (keep == NULL && next == NULL && blocks_->size == block_size_) {
+      keep = blocks_;
+    } else {
+      ::operator delete(blocks_);
+    }
+    blocks_ = next;
+  }
+  blocks_ = keep;
+  bytes_used_ = 0;
+  if (keep == NULL) {
+    bytes_reserved_ = 0;
+    ptr_ = NULL;
+    limit_ = NULL;
+  } else {
+    keep->next = NULL;
+    bytes_reserved_ = block_size_;
+    ptr_ = reinterpret_cast<char*>(keep + 1);
+    limit_ = ptr_ + block_size_;
+  }
+}
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
@@ -23,21 +23,32 @@
 /// This is the header for the module for parsing BED files.
 
 #include "bed.hh"
+#include "arena.hh"
+#include "numparse.hh"
+#include "writer.hh"
 
 namespace bios {
 
-Bed::Bed() {
-  sub_blocks_ = std::vector<SubBlock>();
-}
+// Number of columns in BED3 and BED12 lines.
+static const size_t kBedMinFieldsCount = 3;
+static const size_t kBedMaxFieldsCount = 12;
 
-Bed::~Bed() {
-  sub_blocks_.clear();
+Bed::Bed()
+    : chromosome_id_(SymbolTable::kEmptySymbol),
+      start_(0),
+      end_(0),
+      extended_(false),
+      score_(0),
+      strand_('.'),
+      thick_start_(0),
+      thick_end_(0),
+      block_count_(0) {
 }
 
 std::string Bed::ToString() {
   std::stringstream string_buffer;
   if (extended_) {
-    string_buffer << chromosome_.c_str() << "\t";
+    string_buffer << chromosome() << "\t";
     string_buffer << start_ << "\t";
     string_buffer << end_ << "\t";
     string_buffer << name_.c_str() << "\t";
@@ -56,14 +67,53 @@ std::string Bed::ToString() {
       string_buffer << ((i < sub_blocks_.size() - 1) ? "," : "");
     }
   } else {
-    string_buffer << chromosome_.c_str() << "\t";
+    string_buffer << chromosome() << "\t";
     string_buffer << start_ << "\t";
     string_buffer << end_;
   }
   return string_buffer.str();
 }
 
-BedParser::BedParser() {
+void Bed::AppendTo(RecordWriter* writer) {
+  writer->Append(chromosome());
+  writer->AppendChar('\t');
+  writer->AppendUint(start_);
+  writer->AppendChar('\t');
+  writer->AppendUint(end_);
+  if (extended_) {
+    writer->AppendChar('\t');
+    writer->Append(name_);
+    writer->AppendChar('\t');
+    writer->AppendUint(score_);
+    writer->AppendChar('\t');
+    writer->AppendChar(strand_);
+    writer->AppendChar('\t');
+    writer->AppendUint(thick_start_);
+    writer->AppendChar('\t');
+    writer->AppendUint(thick_end_);
+    writer->AppendChar('\t');
+    writer->Append(item_rgb_);
+    writer->AppendChar('\t');
+    writer->AppendUint(block_count_);
+    writer->AppendChar('\t');
+    for (uint32_t i = 0; i < sub_blocks_.size(); ++i) {
+      writer->AppendUint(sub_blocks_[i].size);
+      writer->AppendChar((i < sub_blocks_.size() - 1) ? ',' : '\t');
+    }
+    for (uint32_t i = 0; i < sub_blocks_.size(); ++i) {
+      writer->AppendUint(sub_blocks_[i].start);
+      if (i < sub_blocks_.size() - 1) {
+        writer->AppendChar(',');
+      }
+    }
+  }
+  writer->AppendChar('\n');
+}
+
+BedParser::BedParser()
+    : stream_(NULL),
+      field_mask_(kBedAllFields),
+      max_fields_(kBedMaxFieldsCount) {
 }
 
 BedParser::~BedParser() {
@@ -72,70 +122,257 @@ BedParser::~BedParser() {
   }
 }
 
-void BedParser::InitFromFile(const char* filename) {
-  stream_ = new FileLineStream(filename);
-  stream_->SetBuffer(1);
+void BedParser::InitFromFile(const char* filename,
+                             FileLineStream::ReadMode mode) {
+  InitFromStream(new FileLineStream(filename, mode));
 }
 
 void BedParser::InitFromCommand(const char* command) {
-  stream_ = new PipeLineStream(command);
+  InitFromStream(new PipeLineStream(command));
+}
+
+void BedParser::InitFromStream(LineStream* stream) {
+  stream_ = stream;
   stream_->SetBuffer(1);
 }
 
-Bed* BedParser::NextEntry(void) {
+// Parses a comma-separated list of block sizes or starts into the given
+// member of each sub-block. A trailing comma is allowed.
+static bool ParseBlockList(const StringPiece& list, uint32_t block_count,
+                           uint32_t SubBlock::*member, const char* what,
+                           int line_number, std::vector<SubBlock>* blocks) {
+  Tokenizer items(list, ",", false);
+  StringPiece item;
+  uint32_t i = 0;
+  for (; items.Next(&item); ++i) {
+    if (i == block_count) {
+      if (item.empty()) {
+        break;
+      }
+      num::report_parse_error(what, list, num::kParseInvalid, line_number);
+      return false;
+    }
+    if (!num::parse_field(item, &((*blocks)[i].*member), what,
+                          line_number)) {
+      return false;
+    }
+  }
+  if (i < block_count) {
+    num::report_parse_error(what, list, num::kParseInvalid, line_number);
+    return false;
+  }
+  return true;
+}
+
+void BedParser::SetFieldMask(uint32_t field_mask) {
+  // The block lists cannot be parsed without their length.
+  if (field_mask & (kBedBlockSizes | kBedBlockStarts)) {
+    field_mask |= kBedBlockCount;
+  }
+  field_mask_ = field_mask;
+  max_fields_ = kBedMinFieldsCount;
+  for (size_t i = kBedMinFieldsCount; i < kBedMaxFieldsCount; ++i) {
+    if (field_mask & (1U << i)) {
+      max_fields_ = i + 1;
+    }
+  }
+}
+
+bool BedParser::ParseRecord(const StringPiece& line, int line_number,
+                            Record* record) {
+  // Tab-separated, or space-separated as allowed in custom tracks. Only
+  // the columns up to the last requested one are split.
+  char separator = line.find('\t') == StringPiece::npos ? ' ' : '\t';
+  size_t num_fields = fields_.Split(line, separator, max_fields_);
+  if (num_fields != kBedMinFieldsCount && num_fields < max_fields_) {
+    num::report_field_count_error(
+        "BED", num_fields < kBedMinFieldsCount ? kBedMinFieldsCount
+                                               : max_fields_,
+        num_fields, line_number);
+    return false;
+  }
+  // Unrequested fields keep the defaults of the Bed constructor.
+  *record = Record();
+  sub_blocks_.clear();
+  if (field_mask_ & kBedChromosome) {
+    record->chromosome = fields_[0];
+  }
+  if ((field_mask_ & kBedStart) &&
+      !num::parse_field(fields_[1], &record->start, "BED start",
+                        line_number)) {
+    return false;
+  }
+  if ((field_mask_ & kBedEnd) &&
+      !num::parse_field(fields_[2], &record->end, "BED end", line_number)) {
+    return false;
+  }
+  record->extended = num_fields > kBedMinFieldsCount;
+  if (num_fields == kBedMinFieldsCount) {
+    return true;
+  }
+
+  if (field_mask_ & kBedName) {
+    record->name = fields_[3];
+  }
+  if ((field_mask_ & kBedScore) &&
+      !num::parse_field(fields_[4], &record->score, "BED score",
+                        line_number)) {
+    return false;
+  }
+  if (field_mask_ & kBedStrand) {
+    if (fields_[5].size() != 1) {
+      num::report_parse_error("BED strand", fields_[5], num::kParseInvalid,
+                              line_number);
+      return false;
+    }
+    record->strand = fields_[5][0];
+  }
+  if ((field_mask_ & kBedThickStart) &&
+      !num::parse_field(fields_[6], &record->thick_start, "BED thickStart",
+                        line_number)) {
+    return false;
+  }
+  if ((field_mask_ & kBedThickEnd) &&
+      !num::parse_field(fields_[7], &record->thick_end, "BED thickEnd",
+                        line_number)) {
+    return false;
+  }
+  if (field_mask_ & kBedItemRgb) {
+    record->item_rgb = fields_[8];
+  }
+  if ((field_mask_ & kBedBlockCount) &&
+      !num::parse_field(fields_[9], &record->block_count, "BED blockCount",
+                        line_number)) {
+    return false;
+  }
+  if (field_mask_ & (kBedBlockSizes | kBedBlockStarts)) {
+    sub_blocks_.resize(record->block_count);
+    if ((field_mask_ & kBedBlockSizes) &&
+        !ParseBlockList(fields_[10], record->block_count, &SubBlock::size,
+                        "BED blockSizes", line_number, &sub_blocks_)) {
+      return false;
+    }
+    if ((field_mask_ & kBedBlockStarts) &&
+        !ParseBlockList(fields_[11], record->block_count, &SubBlock::start,
+                        "BED blockStarts", line_number, &sub_blocks_)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool BedParser::NextRecord(Record* record) {
   if (stream_ == NULL) {
-    return NULL;
+    return false;
   }
-  for (std::string line; stream_->GetLine(line); ) {
-    std::cout << line << std::endl;
-    if (string::starts_with(line, "track") || 
-        string::starts_with(line, "browser")) {
+  for (StringPiece line; stream_->GetLine(&line); ) {
+    if (line.empty() || line.starts_with("track") ||
+        line.starts_with("browser") || line[0] == '#') {
       continue;
     }
-    Bed* bed = new Bed();
-    WordIter w(line, "\t", true);
-    std::string chromosome(w.Next());
-    bed->set_chromosome(chromosome);
-    bed->set_start(atoi(w.Next()));
-    bed->set_end(atoi(w.Next()));
-    char *next = w.Next();
-    if (next != NULL) {
-      std::string name(next);
-      bed->set_name(name);
-      bed->set_extended(true);
-      bed->set_score(atoi(w.Next()));
-      bed->set_strand(w.Next()[0]);
-      bed->set_thick_start(atoi(w.Next()));
-      bed->set_thick_end(atoi(w.Next()));
-      std::string item_rgb(w.Next());
-      bed->set_item_rgb(item_rgb);
-      bed->set_block_count(atoi(w.Next()));
-      WordIter wsizes(w.Next(), ",", true);
-      WordIter wstarts(w.Next(), ",", true); 
-      for (uint32_t i = 0; i < bed->block_count(); ++i) {
-        SubBlock sub_block;
-        sub_block.size = atoi(wsizes.Next());
-        sub_block.start = atoi(wstarts.Next());
-        bed->AddSubBlock(sub_block);
-      }
-    } else {
-      bed->set_extended(false);
+    if (ParseRecord(line, stream_->GetLineCount(), record)) {
+      return true;
     }
-    return bed;
+    // The line has been reported; skip it.
   }
-  return NULL;
+  return false;
+}
+
+void BedParser::FillEntry(const Record& record, Bed* bed) {
+  bed->set_chromosome_id(symbols_.Intern(record.chromosome));
+  bed->set_start(record.start);
+  bed->set_end(record.end);
+  bed->set_extended(record.extended);
+  bed->set_name(record.name.ToString());
+  bed->set_score(record.score);
+  bed->set_strand(record.strand);
+  bed->set_thick_start(record.thick_start);
+  bed->set_thick_end(record.thick_end);
+  bed->set_item_rgb(record.item_rgb.ToString());
+  bed->set_block_count(record.block_count);
+  bed->set_sub_blocks(sub_blocks_);
+}
+
+Bed* BedParser::NextEntry(void) {
+  Record record;
+  if (!NextRecord(&record)) {
+    return NULL;
+  }
+  Bed* bed = new Bed();
+  FillEntry(record, bed);
+  return bed;
+}
+
+Bed* BedParser::NextEntry(Arena* arena) {
+  Record record;
+  if (!NextRecord(&record)) {
+    return NULL;
+  }
+  Bed* bed = arena->New<Bed>();
+  FillEntry(record, bed);
+  return bed;
+}
+
+void BedBatch::clear() {
+  chromosome.clear();
+  start.clear();
+  end.clear();
+  extended.clear();
+  name.clear();
+  score.clear();
+  strand.clear();
+  thick_start.clear();
+  thick_end.clear();
+  item_rgb.clear();
+  block_count.clear();
+  block_sizes.clear();
+  block_starts.clear();
+}
+
+size_t BedParser::NextBatch(BedBatch* batch, size_t max_entries) {
+  batch->clear();
+  Record record;
+  while (batch->size() < max_entries && NextRecord(&record)) {
+    batch->chromosome.Append(record.chromosome);
+    batch->start.push_back(record.start);
+    batch->end.push_back(record.end);
+    batch->extended.push_back(record.extended);
+    batch->name.Append(record.name);
+    batch->score.push_back(record.score);
+    batch->strand.push_back(record.strand);
+    batch->thick_start.push_back(record.thick_start);
+    batch->thick_end.push_back(record.thick_end);
+    batch->item_rgb.Append(record.item_rgb);
+    batch->block_count.push_back(record.block_count);
+    for (uint32_t i = 0; i < sub_blocks_.size(); ++i) {
+      batch->block_sizes.AddValue(sub_blocks_[i].size);
+      batch->block_starts.AddValue(sub_blocks_[i].start);
+    }
+    batch->block_sizes.EndRow();
+    batch->block_starts.EndRow();
+  }
+  return batch->size();
 }
 
 std::vector<Bed> BedParser::GetAllEntries() {
   std::vector<Bed> beds = std::vector<Bed>();
-  Bed* current_bed;
-  while ((current_bed = NextEntry()) != NULL) {
-    beds.push_back(*current_bed);
-    delete current_bed;
+  Record record;
+  while (NextRecord(&record)) {
+    // Fill the entry in place rather than copying it from the heap.
+    beds.emplace_back();
+    FillEntry(record, &beds.back());
   }
   return beds;
 }
 
+size_t BedParser::GetAllEntries(Arena* arena, std::vector<Bed*>* entries) {
+  size_t count = 0;
+  for (Bed* bed; (bed = NextEntry(arena)) != NULL; ++count) {
+    entries->push_back(bed);
+  }
+  return count;
+}
+
 }; // namespace bios
 
 /* vim: set ai ts=2 sts=2 sw=2 et: */
@@ -32,12 +32,36 @@
 #include <vector>
 #include <stdint.h>
 
+#include "column.hh"
+#include "fields.hh"
 #include "string.hh"
+#include "symbol.hh"
 #include "worditer.hh"
 #include "linestream.hh"
 
 namespace bios {
 
+class Arena;
+class RecordWriter;
+
+/// @brief Columns of a BED line, combined into a mask for
+///        BedParser::SetFieldMask(). Bit i stands for column i.
+enum BedField {
+  kBedChromosome = 1 << 0,
+  kBedStart = 1 << 1,
+  kBedEnd = 1 << 2,
+  kBedName = 1 << 3,
+  kBedScore = 1 << 4,
+  kBedStrand = 1 << 5,
+  kBedThickStart = 1 << 6,
+  kBedThickEnd = 1 << 7,
+  kBedItemRgb = 1 << 8,
+  kBedBlockCount = 1 << 9,
+  kBedBlockSizes = 1 << 10,
+  kBedBlockStarts = 1 << 11,
+  kBedAllFields = (1 << 12) - 1
+};
+
 /// @struct SubBlock
 /// @brief  Struct representing a sub-block.
 ///
@@ -54,10 +78,12 @@ struct SubBlock {
 class Bed {
  public:
   Bed();
-  ~Bed();
 
   // Getters.
-  std::string chromosome() const { return chromosome_; }
+  const std::string& chromosome() const {
+    return SymbolTable::Global()->Name(chromosome_id_);
+  }
+  uint32_t chromosome_id() const { return chromosome_id_; }
   uint32_t start() const { return start_; }
   uint32_t end() const { return end_; }
   bool extended() const { return extended_; }
@@ -68,9 +94,15 @@ class Bed {
   uint32_t thick_end() const { return thick_end_; }
   std::string item_rgb() const { return item_rgb_; }
   uint32_t block_count() const { return block_count_; }
+  const std::vector<SubBlock>& sub_blocks() const { return sub_blocks_; }
 
   // Setters.
-  void set_chromosome(std::string chromosome) { chromosome_ = chromosome; }
+  void set_chromosome(const StringPiece& chromosome) {
+    chromosome_id_ = SymbolTable::Global()->Intern(chromosome);
+  }
+  void set_chromosome_id(uint32_t chromosome_id) {
+    chromosome_id_ = chromosome_id;
+  }
   void set_start(uint32_t start) { start_ = start; }
   void set_end(uint32_t end) { end_ = end; }
   void set_extended(bool extended) { extended_ = extended; }
@@ -81,14 +113,23 @@ class Bed {
   void set_thick_end(uint32_t thick_end) { thick_end_ = thick_end; }
   void set_item_rgb(std::string item_rgb) { item_rgb_ = item_rgb; }
   void set_block_count(uint32_t block_count) { block_count_ = block_count; }
+  void set_sub_blocks(const std::vector<SubBlock>& sub_blocks) {
+    sub_blocks_ = sub_blocks;
+  }
 
   std::string ToString();
+
+  /// @brief Appends the entry in the same format as ToString(), followed by
+  ///        a newline.
+  void AppendTo(RecordWriter* writer);
+
   void AddSubBlock(SubBlock& sub_block) {
     sub_blocks_.push_back(sub_block);
   }
 
   static bool Compare(Bed& a, Bed& b) {
-    int diff = strcmp(a.chromosome().c_str(), b.chromosome().c_str());
+    int diff = SymbolTable::Global()->Compare(a.chromosome_id_,
+                                              b.chromosome_id_);
     if (diff != 0) {
       return (diff < 0);
     }
@@ -99,7 +140,7 @@ class Bed {
   }
 
  private:
-  std::string chromosome_;
+  uint32_t chromosome_id_;
   uint32_t start_;
   uint32_t end_;
   bool extended_; 
@@ -115,6 +156,33 @@ class Bed {
   std::vector<SubBlock> sub_blocks_;
 };
 
+/// @struct BedBatch
+/// @brief A batch of BED entries stored column by column.
+///
+/// Row i of every column belongs to the i-th entry. Columns that were not
+/// requested with BedParser::SetFieldMask() hold the defaults of the Bed
+/// constructor, and empty strings and lists.
+struct BedBatch {
+  /// @brief Removes all entries, keeping the allocated memory.
+  void clear();
+
+  size_t size() const { return start.size(); }
+
+  StringColumn chromosome;
+  std::vector<uint32_t> start;
+  std::vector<uint32_t> end;
+  std::vector<uint8_t> extended;  // 1 for lines with more than 3 columns
+  StringColumn name;
+  std::vector<uint32_t> score;
+  std::vector<char> strand;
+  std::vector<uint32_t> thick_start;
+  std::vector<uint32_t> thick_end;
+  StringColumn item_rgb;
+  std::vector<uint32_t> block_count;
+  ListColumn<uint32_t> block_sizes;
+  ListColumn<uint32_t> block_starts;  // relative to start
+};
+
 /// @class BedParser
 /// @brief Class for parsing BED files.
 class BedParser {
@@ -128,7 +196,9 @@ class BedParser {
   /// InitFromCommand must be called before calling other parser methods.
   ///
   /// @param     filename     The name of the input file or '-' for stdin.
-  void InitFromFile(const char* filename);
+  /// @param     mode         How to read the file.
+  void InitFromFile(const char* filename,
+                    FileLineStream::ReadMode mode = FileLineStream::kReadMmap);
 
   /// @brief Initialize the BedParser from a command.
   ///
@@ -138,14 +208,57 @@ class BedParser {
   /// @param     filename     The command to be executed.
   void InitFromCommand(const char* command);
 
+  /// @brief Initialize the BedParser from a line stream.
+  ///
+  /// This method initializes the BedParser from an existing line stream, such
+  /// as a MemoryLineStream over BED data already held in memory. The parser
+  /// takes ownership of the stream.
+  ///
+  /// @param     stream       The line stream to read from.
+  void InitFromStream(LineStream* stream);
+
+  /// @brief Restricts parsing to the given columns.
+  ///
+  /// Columns after the last requested one are not split, and unrequested
+  /// columns are not converted or copied, so their members keep the values
+  /// set by the Bed constructor. Requesting the block sizes or starts also
+  /// parses the block count. Lines need only have the columns up to the
+  /// last requested one, or exactly three.
+  ///
+  /// @param     field_mask   A combination of BedField values. The default
+  ///                         is kBedAllFields.
+  void SetFieldMask(uint32_t field_mask);
+
   /// @brief Retrieve the next entry in the BED file.
   ///
-  /// This method retrieves the next entry in the BED file.
+  /// This method retrieves the next entry in the BED file. Lines with a
+  /// missing or malformed field are reported to stderr and skipped.
   ///
   /// @return    A pointer to the a Bed object representing the next entry in
   ///            the BED file.
   Bed* NextEntry();
 
+  /// @brief Retrieves the next entry, allocated in arena.
+  ///
+  /// The entry belongs to the arena and is destroyed when the arena is reset
+  /// or destroyed; do not delete it. Its name, itemRgb and block list are
+  /// not placed in the arena and may still be allocated on the heap.
+  ///
+  /// @return    The next entry, or NULL at the end of file.
+  Bed* NextEntry(Arena* arena);
+
+  /// @brief Parses the next entries into columns.
+  ///
+  /// This method parses up to max_entries entries into batch, replacing its
+  /// contents, without allocating an object per entry. Malformed lines are
+  /// reported and skipped as by NextEntry(). Reusing one batch for the
+  /// whole file reuses its memory.
+  ///
+  /// @param     batch        The batch to fill.
+  /// @param     max_entries  The maximum number of entries to parse.
+  /// @return    The number of entries in the batch, 0 at the end of file.
+  size_t NextBatch(BedBatch* batch, size_t max_entries);
+
   /// @brief Retrieves all entries from the BED file.
   ///
   /// This method parses the BED file and returns a vector containing all of
@@ -155,8 +268,58 @@ class BedParser {
   ///            the BED file.
   std::vector<Bed> GetAllEntries();
 
+  /// @brief Retrieves all remaining entries, allocated in arena.
+  ///
+  /// Unlike GetAllEntries(), which copies every entry into the returned
+  /// vector, the entries are created in place in arena and only pointers
+  /// are stored in entries.
+  ///
+  /// @param     arena    The arena that owns the entries.
+  /// @param     entries  Vector the entries are appended to.
+  /// @return    The number of entries appended.
+  size_t GetAllEntries(Arena* arena, std::vector<Bed*>* entries);
+
  private:
+  // The fields of one BED line, with strings as views into the line.
+  struct Record {
+    Record()
+        : start(0), end(0), extended(false), score(0), strand('.'),
+          thick_start(0), thick_end(0), block_count(0) {
+    }
+
+    StringPiece chromosome;
+    uint32_t start;
+    uint32_t end;
+    bool extended;
+    StringPiece name;
+    uint32_t score;
+    char strand;
+    uint32_t thick_start;
+    uint32_t thick_end;
+    StringPiece item_rgb;
+    uint32_t block_count;
+  };
+
+  /// @brief Parses the fields of a BED line into record, and the block
+  ///        lists into sub_blocks_.
+  ///
+  /// @return    false if a field is missing or malformed, after reporting it.
+  bool ParseRecord(const StringPiece& line, int line_number, Record* record);
+
+  /// @brief Parses the next well-formed line into record.
+  ///
+  /// @return    false at the end of file.
+  bool NextRecord(Record* record);
+
+  /// @brief Copies record and the sub-blocks parsed with it into bed.
+  void FillEntry(const Record& record, Bed* bed);
+
   LineStream* stream_;
+  FieldSplitter fields_;
+  std::vector<SubBlock> sub_blocks_;
+  SymbolCache symbols_;
+  uint32_t field_mask_;
+  size_t max_fields_;
 };
 
 }; // namespace bios
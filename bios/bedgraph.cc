@@ -23,6 +23,8 @@
 /// This is the header for the module for parsing BedGraphs files.
 
 #include "bedgraph.hh"
+#include "arena.hh"
+#include "numparse.hh"
 
 namespace bios {
 
@@ -34,52 +36,140 @@ BedGraphParser::~BedGraphParser() {
   delete stream_;
 }
 
-void BedGraphParser::InitFromFile(const char* filename) {  
-  stream_ = new FileLineStream(filename);
-  stream_->SetBuffer(1);
+void BedGraphParser::InitFromFile(const char* filename,
+                                  FileLineStream::ReadMode mode) {
+  InitFromStream(new FileLineStream(filename, mode));
 }
 
 void BedGraphParser::InitFromPipe(const char* command) {
-  stream_ = new PipeLineStream(command);
+  InitFromStream(new PipeLineStream(command));
+}
+
+void BedGraphParser::InitFromStream(LineStream* stream) {
+  stream_ = stream;
   stream_->SetBuffer(1);
 }
 
-BedGraph* BedGraphParser::NextEntry() {
-  for (std::string line; stream_->GetLine(line); ) {
-    if (!string::starts_with(line, "track")) {
-      BedGraph* bed_graph = new BedGraph();
-      WordIter  w(line, "\t", true);
-      std::string chromosome(w.Next());
-      bed_graph->set_chromosome(chromosome);
-      bed_graph->set_start(atoi(w.Next()));
-      bed_graph->set_end(atoi(w.Next()));
-      bed_graph->set_value(atof(w.Next()));
-      return bed_graph;
+// Number of columns in a bedGraph line.
+static const size_t kBedGraphFieldsCount = 4;
+
+bool BedGraphParser::NextRecord(StringPiece* chromosome, uint32_t* start,
+                                uint32_t* end, double* value) {
+  if (stream_ == NULL) {
+    return false;
+  }
+  for (StringPiece line; stream_->GetLine(&line); ) {
+    if (line.empty() || line.starts_with("track") ||
+        line.starts_with("browser") || line[0] == '#') {
+      continue;
+    }
+    int line_number = stream_->GetLineCount();
+    if (fields_.Split(line, '\t') < kBedGraphFieldsCount) {
+      num::report_field_count_error("bedGraph", kBedGraphFieldsCount,
+                                    fields_.size(), line_number);
+      continue;
     }
+    if (!num::parse_field(fields_[1], start, "bedGraph start",
+                          line_number) ||
+        !num::parse_field(fields_[2], end, "bedGraph end", line_number) ||
+        !num::parse_field(fields_[3], value, "bedGraph value",
+                          line_number)) {
+      continue;
+    }
+    *chromosome = fields_[0];
+    return true;
+  }
+  return false;
+}
+
+bool BedGraphParser::ParseNextEntry(BedGraph* bed_graph) {
+  StringPiece chromosome;
+  uint32_t start;
+  uint32_t end;
+  double value;
+  if (!NextRecord(&chromosome, &start, &end, &value)) {
+    return false;
   }
-  return NULL;
+  bed_graph->set_chromosome_id(symbols_.Intern(chromosome));
+  bed_graph->set_start(start);
+  bed_graph->set_end(end);
+  bed_graph->set_value(value);
+  return true;
+}
+
+BedGraph* BedGraphParser::NextEntry() {
+  BedGraph bed_graph;
+  if (!ParseNextEntry(&bed_graph)) {
+    return NULL;
+  }
+  return new BedGraph(bed_graph);
+}
+
+BedGraph* BedGraphParser::NextEntry(Arena* arena) {
+  BedGraph bed_graph;
+  if (!ParseNextEntry(&bed_graph)) {
+    return NULL;
+  }
+  BedGraph* entry = arena->New<BedGraph>();
+  *entry = bed_graph;
+  return entry;
+}
+
+void BedGraphBatch::clear() {
+  chromosome.clear();
+  start.clear();
+  end.clear();
+  value.clear();
+}
+
+size_t BedGraphParser::NextBatch(BedGraphBatch* batch, size_t max_entries) {
+  batch->clear();
+  StringPiece chromosome;
+  uint32_t start;
+  uint32_t end;
+  double value;
+  while (batch->size() < max_entries &&
+         NextRecord(&chromosome, &start, &end, &value)) {
+    batch->chromosome.Append(chromosome);
+    batch->start.push_back(start);
+    batch->end.push_back(end);
+    batch->value.push_back(value);
+  }
+  return batch->size();
 }
 
 std::vector<BedGraph> BedGraphParser::GetAllEntries() {
   std::vector<BedGraph> bed_graphs = std::vector<BedGraph>();
-  BedGraph* bed_graph;
-  int i = 0;
-  while ((bed_graph = NextEntry()) != NULL) {
-    bed_graphs.push_back(*bed_graph);
-    delete bed_graph;
-    ++i;
+  for (BedGraph bed_graph; ParseNextEntry(&bed_graph); ) {
+    bed_graphs.push_back(bed_graph);
   }
   return bed_graphs;
 }
 
+size_t BedGraphParser::GetAllEntries(Arena* arena,
+                                     std::vector<BedGraph*>* entries) {
+  size_t count = 0;
+  for (BedGraph* bed_graph; (bed_graph = NextEntry(arena)) != NULL;
+       ++count) {
+    entries->push_back(bed_graph);
+  }
+  return count;
+}
+
 std::vector<double> BedGraphParser::GetValuesForRegion(
     std::vector<BedGraph>& bed_graphs, std::string chromosome, 
     uint32_t start, uint32_t end) {
   std::vector<double> entries = std::vector<double>();
   std::vector<BedGraph*> bed_graph_ptrs = std::vector<BedGraph*>();
   
+  uint32_t chromosome_id;
+  if (!SymbolTable::Global()->Find(chromosome, &chromosome_id)) {
+    // No entry has ever been on this chromosome. Interning the name would
+    // grow the global table for every unknown query.
+    return entries;
+  }
   BedGraph test_bed_graph;
-  test_bed_graph.set_chromosome(chromosome);
+  test_bed_graph.set_chromosome_id(chromosome_id);
   test_bed_graph.set_start(start);
   test_bed_graph.set_end(end);
   std::vector<BedGraph>::iterator it = std::find(bed_graphs.begin(), 
@@ -89,7 +179,7 @@ std::vector<double> BedGraphParser::GetValuesForRegion(
   int32_t i = index;
   while (i >= 0) {
     BedGraph* bed_graph = &bed_graphs[i];
-    if (chromosome != bed_graph->chromosome() || bed_graph->end() < start) {
+    if (chromosome_id != bed_graph->chromosome_id() || bed_graph->end() < start) {
       break;
     }
     bed_graph_ptrs.push_back(bed_graph);
@@ -98,7 +188,7 @@ std::vector<double> BedGraphParser::GetValuesForRegion(
   i = index + 1;
   while (i < bed_graphs.size()) {
     BedGraph* bed_graph = &bed_graphs[i];
-    if (chromosome != bed_graph->chromosome() || bed_graph->start() > end) {
+    if (chromosome_id != bed_graph->chromosome_id() || bed_graph->start() > end) {
       break;
     }
     bed_graph_ptrs.push_back(bed_graph);
@@ -32,32 +32,44 @@
 #include <iostream>
 #include <stdint.h>
 
+#include "column.hh"
+#include "fields.hh"
 #include "worditer.hh"
 #include "string.hh"
+#include "symbol.hh"
 #include "linestream.hh"
 
 namespace bios {
 
+class Arena;
+
 /// @class BedGraph
 /// @brief Class representing a BedGraph file entry.
 class BedGraph {
  public:
-  BedGraph() {}
-  ~BedGraph() {}
+  BedGraph() : chromosome_id_(SymbolTable::kEmptySymbol) {}
 
-  std::string chromosome() const { return chromosome_; }
+  const std::string& chromosome() const {
+    return SymbolTable::Global()->Name(chromosome_id_);
+  }
+  uint32_t chromosome_id() const { return chromosome_id_; }
   uint32_t start() const { return start_; }
   uint32_t end() const { return end_; }
   double value() const { return value_; }
 
-  void set_chromosome(std::string chromosome) { chromosome_ = chromosome; }
+  void set_chromosome(const StringPiece& chromosome) {
+    chromosome_id_ = SymbolTable::Global()->Intern(chromosome);
+  }
+  void set_chromosome_id(uint32_t chromosome_id) {
+    chromosome_id_ = chromosome_id;
+  }
   void set_start(uint32_t start) { start_ = start; }
   void set_end(uint32_t end) { end_ = end; }
   void set_value(double value) { value_ = value; }
 
   static bool Compare(BedGraph& a, BedGraph& b) {
     int diff;
-    diff = strcmp(a.chromosome().c_str(), b.chromosome().c_str());
+    diff = SymbolTable::Global()->Compare(a.chromosome_id_, b.chromosome_id_);
     if (diff < 0) {
       return true;
     }
@@ -68,19 +80,33 @@ class BedGraph {
   }
 
   bool operator==(const BedGraph& other) {
-    return (chromosome_ == other.chromosome() &&
+    return (chromosome_id_ == other.chromosome_id() &&
             start_ == other.start() &&
             end_ == other.end() &&
             value_ == other.value());
   }
 
  private:
-  std::string chromosome_;
+  uint32_t chromosome_id_;
   uint32_t start_;
   uint32_t end_;
   double value_;
 };
 
+/// @struct BedGraphBatch
+/// @brief A batch of BedGraph entries stored column by column.
+struct BedGraphBatch {
+  /// @brief Removes all entries, keeping the allocated memory.
+  void clear();
+
+  size_t size() const { return start.size(); }
+
+  StringColumn chromosome;
+  std::vector<uint32_t> start;
+  std::vector<uint32_t> end;
+  std::vector<double> value;
+};
+
 /// @class BedGraphParser
 /// @brief Parser for parsing BedGraph files.
 class BedGraphParser {
@@ -95,7 +121,9 @@ class BedGraphParser {
   /// any of the other parser methods.
   ///
   /// @param     filename    The name of the BedGraph file or '-' for stdin.
-  void InitFromFile(const char* filename);
+  /// @param     mode        How to read the file.
+  void InitFromFile(const char* filename,
+                    FileLineStream::ReadMode mode = FileLineStream::kReadMmap);
   
   /// @brief Initialize the BedGraphParser from a clommand.
   ///
@@ -107,15 +135,43 @@ class BedGraphParser {
   /// @param     command     The command to be executed.
   void InitFromPipe(const char* command);
 
+  /// @brief Initialize the BedGraphParser from a line stream.
+  ///
+  /// This method initializes the BedGraphParser from an existing line stream,
+  /// such as a MemoryLineStream over data already held in memory. The parser
+  /// takes ownership of the stream.
+  ///
+  /// @param     stream      The line stream to read from.
+  void InitFromStream(LineStream* stream);
+
   /// @brief Retrieve the next entry from the BedGraph file.
   ///
   /// This method returns a pointer to a BedGraph object representing the next
-  /// entry from the BedGraph file.
+  /// entry from the BedGraph file. Lines with a missing or malformed field
+  /// are reported to stderr and skipped.
   ///
   /// @return    A BedGraph object representing the next entry from the
   ///            BedGraph file or NULL if the end of file is reached.
   BedGraph* NextEntry();
 
+  /// @brief Retrieves the next entry, allocated in arena.
+  ///
+  /// The entry belongs to the arena; do not delete it.
+  ///
+  /// @return    The next entry, or NULL at the end of file.
+  BedGraph* NextEntry(Arena* arena);
+
+  /// @brief Parses the next entries into columns.
+  ///
+  /// This method parses up to max_entries entries into batch, replacing its
+  /// contents, without allocating an object per entry. Reusing one batch
+  /// for the whole file reuses its memory.
+  ///
+  /// @param     batch        The batch to fill.
+  /// @param     max_entries  The maximum number of entries to parse.
+  /// @return    The number of entries in the batch, 0 at the end of file.
+  size_t NextBatch(BedGraphBatch* batch, size_t max_entries);
+
   /// @brief Retrieve all entries from the BedGraph file.
   ///
   /// This method returns an std::vector containing BedGraph objects
@@ -125,6 +181,12 @@ class BedGraphParser {
   ///            BedGraph file.
   std::vector<BedGraph> GetAllEntries();
 
+  /// @brief Retrieves all remaining entries, allocated in arena, and
+  ///        appends pointers to them to entries.
+  ///
+  /// @return    The number of entries appended.
+  size_t GetAllEntries(Arena* arena, std::vector<BedGraph*>* entries);
+
   /// @brief Get the BedGraph values for all entries in the specified
   ///        chromosomal region.
   ///
@@ -139,7 +201,21 @@ class BedGraphParser {
       uint32_t start, uint32_t end);
 
  private:
+  /// @brief Parses the next well-formed line into bed_graph.
+  ///
+  /// @return    false at the end of file.
+  bool ParseNextEntry(BedGraph* bed_graph);
+
+  /// @brief Parses the next well-formed line. The chromosome is a view into
+  ///        the line.
+  ///
+  /// @return    false at the end of file.
+  bool NextRecord(StringPiece* chromosome, uint32_t* start, uint32_t* end,
+                  double* value);
+
   LineStream* stream_;
+  FieldSplitter fields_;
+  SymbolCache symbols_;
 };
 
 }; // namespace bios
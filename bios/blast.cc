@@ -23,6 +23,7 @@
 /// This is the header for the module for parsing tab-delimited BLAST output.
 
 #include "blast.hh"
+#include "numparse.hh"
 
 namespace bios {
 
@@ -32,48 +33,145 @@ BlastQuery::BlastQuery() {
 BlastQuery::~BlastQuery() {
 }
 
-void BlastQuery::ProcessLine(std::string& line) {
+// Number of fields after the query name in a tabular BLAST line.
+static const size_t kBlastFieldsCount = 11;
+
+// Returns field without leading spaces. Some BLAST versions right-align
+// numeric columns such as the bit score.
+static StringPiece StripLeadingSpaces(StringPiece field) {
+  while (!field.empty() && field[0] == ' ') {
+    field.remove_prefix(1);
+  }
+  return field;
+}
+
+// Returns the number of leading fields needed for the columns in
+// field_mask.
+static size_t RequiredFields(uint32_t field_mask) {
+  size_t required = 0;
+  for (size_t i = 0; i < kBlastFieldsCount; ++i) {
+    if (field_mask & (1U << i)) {
+      required = i + 1;
+    }
+  }
+  return required;
+}
+
+// Parses the numeric column for field into value if field_mask includes it.
+template <typename T>
+static bool ParseColumn(const FieldSplitter& fields, uint32_t field_mask,
+                        BlastField field, const char* what, int line_number,
+                        T* value) {
+  if (!(field_mask & field)) {
+    return true;
+  }
+  return num::parse_field(StripLeadingSpaces(fields[__builtin_ctz(field)]),
+                          value, what, line_number);
+}
+
+bool BlastQuery::ProcessLine(const StringPiece& line, int line_number,
+                             uint32_t field_mask) {
+  FieldSplitter fields;
+  fields.Split(line, '\t', RequiredFields(field_mask));
+  return ProcessFields(fields, line_number, field_mask);
+}
+
+// Parses the numeric columns in field_mask into entry, after checking that
+// the line has all the columns needed.
+static bool ParseNumericColumns(const FieldSplitter& fields,
+                                uint32_t field_mask, int line_number,
+                                BlastEntry* entry) {
+  size_t required = RequiredFields(field_mask);
+  if (fields.size() < required) {
+    num::report_field_count_error("BLAST", required + 1, fields.size() + 1,
+                                  line_number);
+    return false;
+  }
+  return
+      ParseColumn(fields, field_mask, kBlastPercentIdentity,
+                  "BLAST percent identity", line_number,
+                  &entry->percent_identity) &&
+      ParseColumn(fields, field_mask, kBlastAlignmentLength,
+                  "BLAST alignment length", line_number,
+                  &entry->alignment_length) &&
+      ParseColumn(fields, field_mask, kBlastMismatches,
+                  "BLAST mismatches", line_number, &entry->mis_matches) &&
+      ParseColumn(fields, field_mask, kBlastGapOpenings,
+                  "BLAST gap openings", line_number, &entry->gap_openings) &&
+      ParseColumn(fields, field_mask, kBlastQueryStart,
+                  "BLAST query start", line_number, &entry->q_start) &&
+      ParseColumn(fields, field_mask, kBlastQueryEnd,
+                  "BLAST query end", line_number, &entry->q_end) &&
+      ParseColumn(fields, field_mask, kBlastTargetStart,
+                  "BLAST subject start", line_number, &entry->t_start) &&
+      ParseColumn(fields, field_mask, kBlastTargetEnd,
+                  "BLAST subject end", line_number, &entry->t_end) &&
+      ParseColumn(fields, field_mask, kBlastEvalue,
+                  "BLAST e-value", line_number, &entry->evalue) &&
+      ParseColumn(fields, field_mask, kBlastBitScore,
+                  "BLAST bit score", line_number, &entry->bit_score);
+}
+
+bool BlastQuery::ProcessFields(const FieldSplitter& fields, int line_number,
+                               uint32_t field_mask) {
   BlastEntry entry;
-  WordIter w(line, "\t", false);
-  std::string t_name(w.Next());
-  entry.t_name = t_name;
-  entry.percent_identity = atof(w.Next());
-  entry.alignment_length = atoi(w.Next());
-  entry.mis_matches = atoi(w.Next());
-  entry.gap_openings = atoi(w.Next());
-  entry.q_start = atoi(w.Next());
-  entry.q_end = atoi(w.Next());
-  entry.t_start = atoi(w.Next());
-  entry.t_end = atoi(w.Next());
-  entry.evalue = atof(w.Next());
-  entry.bit_score = atof(w.Next());
+  if (!ParseNumericColumns(fields, field_mask, line_number, &entry)) {
+    return false;
+  }
+  if (field_mask & kBlastTargetName) {
+    fields[0].CopyToString(&entry.t_name);
+  }
   entries.push_back(entry);
+  return true;
 }
 
-BlastEntry::BlastEntry() {
+BlastEntry::BlastEntry()
+    : percent_identity(0.0),
+      alignment_length(0),
+      mis_matches(0),
+      gap_openings(0),
+      q_start(0),
+      q_end(0),
+      t_start(0),
+      t_end(0),
+      evalue(0.0),
+      bit_score(0.0) {
 }
 
 BlastEntry::~BlastEntry() {
 }
 
 BlastParser::BlastParser()
-    : stream_(NULL) {
+    : stream_(NULL),
+      blast_query_(NULL),
+      field_mask_(kBlastAllFields),
+      max_fields_(kBlastFieldsCount) {
 }
 
 BlastParser::~BlastParser() {
   delete stream_;
+  delete blast_query_;
 }
 
-void BlastParser::InitFromFile(const char* filename) {
-  stream_ = new FileLineStream(filename);
-  stream_->SetBuffer(1);
+void BlastParser::InitFromFile(const char* filename,
+                               FileLineStream::ReadMode mode) {
+  InitFromStream(new FileLineStream(filename, mode));
 }
 
 void BlastParser::InitFromPipe(const char* command) {
-  stream_ = new PipeLineStream(command);
+  InitFromStream(new PipeLineStream(command));
+}
+
+void BlastParser::InitFromStream(LineStream* stream) {
+  stream_ = stream;
   stream_->SetBuffer(1);
 }
 
+void BlastParser::SetFieldMask(uint32_t field_mask) {
+  field_mask_ = field_mask;
+  max_fields_ = RequiredFields(field_mask);
+}
+
 BlastQuery* BlastParser::NextQuery() {
   if (blast_query_ != NULL) {
     delete blast_query_;
@@ -86,28 +184,28 @@ BlastQuery* BlastParser::NextQuery() {
 
   blast_query_ = new BlastQuery;
   int first = 1;
-  for (std::string line; stream_->GetLine(line); ) {
+  for (StringPiece line; stream_->GetLine(&line); ) {
     if (line.empty()) {
       continue;
     }
     size_t pos = line.find('\t');
-    if (pos == std::string::npos) {
+    if (pos == StringPiece::npos) {
       continue;
     }
 
-    query_name_.replace(0, pos + 1, line);
-    if (first == 1 || prev_query_name_ == query_name_) {
-      std::string query_line = line.substr(pos + 1, line.size() - pos);
-      blast_query_->ProcessLine(query_line);
-    } else {
-      stream_->Back(line);
-      return blast_query_;
-    }
+    StringPiece query_name = line.substr(0, pos);
     if (first == 1) {
+      query_name.CopyToString(&query_name_);
       blast_query_->q_name = query_name_;
       first = 0;
+    } else if (query_name != query_name_) {
+      stream_->Back(line);
+      return blast_query_;
     }
-    prev_query_name_ = query_name_;
+    // Malformed lines are reported and skipped.
+    fields_.Split(line.substr(pos + 1), '\t', max_fields_);
+    blast_query_->ProcessFields(fields_, stream_->GetLineCount(),
+                                field_mask_);
   }
 
   if (first == 1) {
@@ -117,6 +215,55 @@ BlastQuery* BlastParser::NextQuery() {
   }
 }
 
+void BlastBatch::clear() {
+  q_name.clear();
+  t_name.clear();
+  percent_identity.clear();
+  alignment_length.clear();
+  mis_matches.clear();
+  gap_openings.clear();
+  q_start.clear();
+  q_end.clear();
+  t_start.clear();
+  t_end.clear();
+  evalue.clear();
+  bit_score.clear();
+}
+
+size_t BlastParser::NextBatch(BlastBatch* batch, size_t max_entries) {
+  batch->clear();
+  if (stream_ == NULL) {
+    return 0;
+  }
+  for (StringPiece line; batch->size() < max_entries &&
+           stream_->GetLine(&line); ) {
+    size_t pos = line.find('\t');
+    if (pos == StringPiece::npos) {
+      continue;
+    }
+    fields_.Split(line.substr(pos + 1), '\t', max_fields_);
+    BlastEntry entry;
+    if (!ParseNumericColumns(fields_, field_mask_, stream_->GetLineCount(),
+                             &entry)) {
+      continue;
+    }
+    batch->q_name.Append(line.substr(0, pos));
+    batch->t_name.Append((field_mask_ & kBlastTargetName) ? fields_[0]
+                                                          : StringPiece());
+    batch->percent_identity.push_back(entry.percent_identity);
+    batch->alignment_length.push_back(entry.alignment_length);
+    batch->mis_matches.push_back(entry.mis_matches);
+    batch->gap_openings.push_back(entry.gap_openings);
+    batch->q_start.push_back(entry.q_start);
+    batch->q_end.push_back(entry.q_end);
+    batch->t_start.push_back(entry.t_start);
+    batch->t_end.push_back(entry.t_end);
+    batch->evalue.push_back(entry.evalue);
+    batch->bit_score.push_back(entry.bit_score);
+  }
+  return batch->size();
+}
+
 }; // namespace bios
 
 /* vim: set ai ts=2 sts=2 sw=2 et: */
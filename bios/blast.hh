@@ -28,11 +28,31 @@
 #include <vector>
 #include <string>
 
+#include "column.hh"
+#include "fields.hh"
 #include "worditer.hh"
 #include "linestream.hh"
 
 namespace bios {
 
+/// @brief Columns of a tabular BLAST line after the query name, combined
+///        into a mask for BlastParser::SetFieldMask(). Bit i stands for
+///        the i-th column after the query name.
+enum BlastField {
+  kBlastTargetName = 1 << 0,
+  kBlastPercentIdentity = 1 << 1,
+  kBlastAlignmentLength = 1 << 2,
+  kBlastMismatches = 1 << 3,
+  kBlastGapOpenings = 1 << 4,
+  kBlastQueryStart = 1 << 5,
+  kBlastQueryEnd = 1 << 6,
+  kBlastTargetStart = 1 << 7,
+  kBlastTargetEnd = 1 << 8,
+  kBlastEvalue = 1 << 9,
+  kBlastBitScore = 1 << 10,
+  kBlastAllFields = (1 << 11) - 1
+};
+
 /// @struct BlastEntry
 /// @brief Structure representing a singe BLAST entry.
 struct BlastEntry {
@@ -57,12 +77,54 @@ struct BlastEntry {
 struct BlastQuery {
   BlastQuery();
   ~BlastQuery();
-  void ProcessLine(std::string& line);
+
+  /// @brief Parses a BLAST line without its query name into an entry.
+  ///
+  /// @param    line         The fields after the query name.
+  /// @param    line_number  The line number for error messages, or 0.
+  /// @param    field_mask   The columns to parse, as BlastField values.
+  ///                        Other members of the entry are left zero.
+  /// @return   false if a field is missing or malformed, after reporting it
+  ///           to stderr. No entry is added in that case.
+  bool ProcessLine(const StringPiece& line, int line_number = 0,
+                   uint32_t field_mask = kBlastAllFields);
+
+  /// @brief Like ProcessLine(), for a line that has already been split.
+  ///        Callers parsing many lines should split them with one
+  ///        FieldSplitter and call this, as BlastParser does, since
+  ///        ProcessLine() allocates a splitter for each line.
+  bool ProcessFields(const FieldSplitter& fields, int line_number,
+                     uint32_t field_mask);
 
   std::string q_name;
   std::vector<BlastEntry> entries;
 };
 
+/// @struct BlastBatch
+/// @brief A batch of BLAST lines stored column by column.
+///
+/// Row i of every column belongs to the i-th line. Columns that were not
+/// requested with BlastParser::SetFieldMask() hold zeros or empty strings.
+struct BlastBatch {
+  /// @brief Removes all rows, keeping the allocated memory.
+  void clear();
+
+  size_t size() const { return q_name.size(); }
+
+  StringColumn q_name;
+  StringColumn t_name;
+  std::vector<double> percent_identity;
+  std::vector<int> alignment_length;
+  std::vector<int> mis_matches;
+  std::vector<int> gap_openings;
+  std::vector<int> q_start;
+  std::vector<int> q_end;
+  std::vector<int> t_start;
+  std::vector<int> t_end;
+  std::vector<double> evalue;
+  std::vector<double> bit_score;
+};
+
 /// @class BlastParser
 /// @brief Class for parsing tab-delimited BLAST output.
 class BlastParser {
@@ -84,7 +146,9 @@ class BlastParser {
   /// the other parser methods are called.
   ///
   /// @param    filename  The name of the file to read from or '-' for stdin.
-  void InitFromFile(const char* filename);
+  /// @param    mode      How to read the file.
+  void InitFromFile(const char* filename,
+                    FileLineStream::ReadMode mode = FileLineStream::kReadMmap);
   
   /// @brief Initializes the BlastParser from a file.
   ///
@@ -95,6 +159,25 @@ class BlastParser {
   /// @param    filename  The name of the file to read from or '-' for stdin.
   void InitFromPipe(const char* command);
 
+  /// @brief Initializes the BlastParser from a line stream.
+  ///
+  /// This method initializes the BlastParser from an existing line stream,
+  /// such as a MemoryLineStream over output already held in memory. The
+  /// parser takes ownership of the stream.
+  ///
+  /// @param    stream    The line stream to read from.
+  void InitFromStream(LineStream* stream);
+
+  /// @brief Restricts parsing to the given columns.
+  ///
+  /// Columns after the last requested one are not split, and unrequested
+  /// columns are not converted or copied, so they are left zero or empty in
+  /// the entries. The query name is always read, to group the lines.
+  ///
+  /// @param    field_mask  A combination of BlastField values. The default
+  ///                       is kBlastAllFields.
+  void SetFieldMask(uint32_t field_mask);
+
   /// @brief Returns the next BLAST query from the file.
   ///
   /// This method returns a pointer to a BlastQuery representing the next
@@ -103,11 +186,24 @@ class BlastParser {
   /// @return   A pointer to the next BlastQuery from the BLAST file.
   BlastQuery* NextQuery();
 
+  /// @brief Parses the next lines into columns.
+  ///
+  /// This method parses up to max_entries lines into batch, replacing its
+  /// contents, without grouping them by query or allocating an object per
+  /// line. Malformed lines are reported and skipped.
+  ///
+  /// @param    batch        The batch to fill.
+  /// @param    max_entries  The maximum number of lines to parse.
+  /// @return   The number of rows in the batch, 0 at the end of file.
+  size_t NextBatch(BlastBatch* batch, size_t max_entries);
+
  private:
   LineStream* stream_;
   std::string query_name_;
-  std::string prev_query_name_;
   BlastQuery* blast_query_;
+  FieldSplitter fields_;
+  uint32_t field_mask_;
+  size_t max_fields_;
 };
 
 }; // namespace bios
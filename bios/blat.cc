@@ -23,13 +23,18 @@
 /// This is the header for the module for parsing tab-delimited BLAST output.
 
 #include "blat.hh"
+#include "numparse.hh"
 
 namespace bios {
 
 const int kPslHeaderLinesCount = 5;
 
+// Number of fields in a PSL line.
+static const size_t kPslFieldsCount = 21;
+
 BlatParser::BlatParser() 
-    : stream_(NULL) {
+    : stream_(NULL),
+      blat_query_(NULL) {
 }
 
 BlatParser::~BlatParser() {
@@ -39,17 +44,17 @@ BlatParser::~BlatParser() {
   }
 }
 
-void BlatParser::InitFromFile(const char* filename) {
-  stream_ = new FileLineStream(filename);
-  stream_->SetBuffer(1);
-  std::string line;
-  for (int i = 0; i < kPslHeaderLinesCount; ++i) {
-    stream_->GetLine(line);
-  }
+void BlatParser::InitFromFile(const char* filename,
+                              FileLineStream::ReadMode mode) {
+  InitFromStream(new FileLineStream(filename, mode));
 }
 
 void BlatParser::InitFromPipe(const char* command) {
-  stream_ = new PipeLineStream(command);
+  InitFromStream(new PipeLineStream(command));
+}
+
+void BlatParser::InitFromStream(LineStream* stream) {
+  stream_ = stream;
   stream_->SetBuffer(1);
   std::string line;
   for (int i = 0; i < kPslHeaderLinesCount; ++i) {
@@ -57,15 +62,75 @@ void BlatParser::InitFromPipe(const char* command) {
   }
 }
 
-void BlatParser::ProcessCommaSeparatedList(std::vector<int>& results, 
-                                           std::string& str) {
-  WordIter w(str, ",", false);
-  for (char* tok; (tok = w.Next()) != NULL; ) {
-    if (tok[0] == '\0') {
+bool BlatParser::ProcessCommaSeparatedList(std::vector<int>& results,
+                                           const StringPiece& str,
+                                           const char* what) {
+  Tokenizer items(str, ",", false);
+  for (StringPiece item; items.Next(&item); ) {
+    if (item.empty()) {
       continue;
     }
-    results.push_back(atoi(tok));
+    int value;
+    if (!num::parse_field(item, &value, what, stream_->GetLineCount())) {
+      return false;
+    }
+    results.push_back(value);
   }
+  return true;
+}
+
+bool BlatParser::ProcessLine(PslEntry* entry) {
+  int line_number = stream_->GetLineCount();
+  if (fields_.size() < kPslFieldsCount) {
+    num::report_field_count_error("PSL", kPslFieldsCount, fields_.size(),
+                                  line_number);
+    return false;
+  }
+  if (!num::parse_field(fields_[0], &entry->matches, "PSL matches",
+                        line_number) ||
+      !num::parse_field(fields_[1], &entry->mismatches, "PSL misMatches",
+                        line_number) ||
+      !num::parse_field(fields_[2], &entry->repmatches, "PSL repMatches",
+                        line_number) ||
+      !num::parse_field(fields_[3], &entry->n_count, "PSL nCount",
+                        line_number) ||
+      !num::parse_field(fields_[4], &entry->q_num_insert, "PSL qNumInsert",
+                        line_number) ||
+      !num::parse_field(fields_[5], &entry->q_base_insert, "PSL qBaseInsert",
+                        line_number) ||
+      !num::parse_field(fields_[6], &entry->t_num_insert, "PSL tNumInsert",
+                        line_number) ||
+      !num::parse_field(fields_[7], &entry->t_base_insert, "PSL tBaseInsert",
+                        line_number) ||
+      !num::parse_field(fields_[10], &entry->q_size, "PSL qSize",
+                        line_number) ||
+      !num::parse_field(fields_[11], &entry->q_start, "PSL qStart",
+                        line_number) ||
+      !num::parse_field(fields_[12], &entry->q_end, "PSL qEnd",
+                        line_number) ||
+      !num::parse_field(fields_[14], &entry->t_size, "PSL tSize",
+                        line_number) ||
+      !num::parse_field(fields_[15], &entry->t_start, "PSL tStart",
+                        line_number) ||
+      !num::parse_field(fields_[16], &entry->t_end, "PSL tEnd",
+                        line_number) ||
+      !num::parse_field(fields_[17], &entry->block_count, "PSL blockCount",
+                        line_number)) {
+    return false;
+  }
+  if (fields_[8].empty()) {
+    num::report_parse_error("PSL strand", fields_[8], num::kParseEmpty,
+                            line_number);
+    return false;
+  }
+  entry->strand = fields_[8][0];
+  entry->t_name_id = symbols_.Intern(fields_[13]);
+  return ProcessCommaSeparatedList(entry->block_sizes, fields_[18],
+                                   "PSL blockSizes") &&
+      ProcessCommaSeparatedList(entry->q_starts, fields_[19],
+                                "PSL qStarts") &&
+      ProcessCommaSeparatedList(entry->t_starts, fields_[20],
+                                "PSL tStarts");
 }
 
 BlatQuery* BlatParser::NextQuery() {
@@ -80,57 +145,28 @@ BlatQuery* BlatParser::NextQuery() {
 
   blat_query_ = new BlatQuery;
   int first = 1;
-  for (std::string line; stream_->GetLine(line); ) {
+  for (StringPiece line; stream_->GetLine(&line); ) {
     if (line.empty()) {
       continue;
     }
-    WordIter w(line, "\t", false);
-    int matches = atoi(w.Next());
-    int mismatches = atoi(w.Next());
-    int repmatches = atoi(w.Next());
-    int n_count = atoi(w.Next());
-    int q_num_insert = atoi(w.Next());
-    int q_base_insert = atoi(w.Next());
-    int t_num_insert = atoi(w.Next());
-    int t_base_insert = atoi(w.Next());
-    char strand = (w.Next())[0];
-    std::string query_name(w.Next());
-    query_name_ = query_name;
-    if (first == 1 || prev_query_name_ == query_name_) {
-      PslEntry psl_entry;
-      psl_entry.matches = matches;
-      psl_entry.mismatches = mismatches;
-      psl_entry.repmatches = repmatches;
-      psl_entry.n_count = n_count;
-      psl_entry.q_num_insert = q_num_insert;
-      psl_entry.q_base_insert = q_base_insert;
-      psl_entry.t_num_insert = t_num_insert;
-      psl_entry.t_base_insert = t_base_insert;
-      psl_entry.strand = strand;
-      psl_entry.q_size = atoi(w.Next());
-      psl_entry.q_start = atoi(w.Next());
-      psl_entry.q_end = atoi(w.Next());
-      std::string name(w.Next());
-      psl_entry.t_name = name;
-      psl_entry.t_size = atoi(w.Next());
-      psl_entry.t_start = atoi(w.Next());
-      psl_entry.t_end = atoi(w.Next());
-      psl_entry.block_count = atoi(w.Next());
-      std::string block_sizes(w.Next());
-      std::string q_starts(w.Next());
-      std::string t_starts(w.Next());
-      ProcessCommaSeparatedList(psl_entry.block_sizes, block_sizes);
-      ProcessCommaSeparatedList(psl_entry.q_starts, q_starts);
-      ProcessCommaSeparatedList(psl_entry.t_starts, t_starts);
-    } else {
-      stream_->Back(line);
-      return blat_query_;
+    fields_.Split(line, '\t');
+    StringPiece query_name;
+    if (fields_.size() > 9) {
+      query_name = fields_[9];
     }
     if (first == 1) {
-      blat_query_->q_name = query_name;
+      query_name.CopyToString(&query_name_);
+      blat_query_->q_name = query_name_;
       first = 0;
+    } else if (query_name != query_name_) {
+      stream_->Back(line);
+      return blat_query_;
+    }
+    // Malformed lines are reported and skipped.
+    PslEntry psl_entry;
+    if (ProcessLine(&psl_entry)) {
+      blat_query_->entries.push_back(psl_entry);
     }
-    prev_query_name_ = query_name;
   }
   if (first == 1) {
     return NULL;
@@ -28,6 +28,8 @@
 #include <vector>
 #include <string>
 
+#include "fields.hh"
+#include "symbol.hh"
 #include "worditer.hh"
 #include "linestream.hh"
 
@@ -36,6 +38,12 @@ namespace bios {
 /// @struct PslEntry
 /// @brief A structure representing a PSL entry.
 struct PslEntry {
+  PslEntry() : t_name_id(SymbolTable::kEmptySymbol) {}
+
+  const std::string& t_name() const {
+    return SymbolTable::Global()->Name(t_name_id);
+  }
+
   int matches;       // Number of bases that match that aren't repeats
   int mismatches;    // Number of bases that don't match
   int repmatches;    // Number of bases that match but are part of repeats
@@ -48,7 +56,7 @@ struct PslEntry {
   int q_size;        // Query sequence size
   int q_start;       // Alignment start position in query
   int q_end;         // Alignment end position in query
-  std::string t_name;   // Target sequence name
+  uint32_t t_name_id; // Target sequence name, interned in SymbolTable
   int t_size;        // Target sequence size
   int t_start;       // Alignment start position in target
   int t_end;         // Alignment end position in target
@@ -83,7 +91,9 @@ class BlatParser {
   /// standard input.
   ///
   /// @param    filename  The name of the file or '-' for stdin.
-  void InitFromFile(const char* filename);
+  /// @param    mode      How to read the file.
+  void InitFromFile(const char* filename,
+                    FileLineStream::ReadMode mode = FileLineStream::kReadMmap);
   
   /// @brief Initializes the BlatParser from a command.
   ///
@@ -93,29 +103,49 @@ class BlatParser {
   /// @param    command  The command to be executed.
   void InitFromPipe(const char* command);
 
+  /// @brief Initializes the BlatParser from a line stream.
+  ///
+  /// This method initializes the BlatParser from an existing line stream,
+  /// such as a MemoryLineStream over PSL data already held in memory. The
+  /// parser takes ownership of the stream.
+  ///
+  /// @param    stream   The line stream to read from.
+  void InitFromStream(LineStream* stream);
+
   /// @brief Returns the next BLAT query from the file.
   ///
   /// This method returns a pointer to a BlatQuery object representing the next
-  /// BLAT query from the file.
+  /// BLAT query from the file. Lines with a missing or malformed field are
+  /// reported to stderr and skipped.
   ///
   /// @return   A pointer to a BlatQuery object for the next BLAT query.
   BlatQuery* NextQuery();
 
  private:
-  /// @brief Processes a line from the PSL BLAT file.
+  /// @brief Processes a comma-separated list from the PSL BLAT file.
   ///
-  /// This method tokenizes a comma-separated line from the PSL BLAT file and
+  /// This method tokenizes a comma-separated field from the PSL BLAT file and
   /// pushes all tokens into a vector of ints.
   ///
   /// @param    results   The vector to store the resulting ints.
-  /// @param    str       The string to process.
-  void ProcessCommaSeparatedList(std::vector<int>& results, std::string& str);
+  /// @param    str       The field to process.
+  /// @param    what      The name of the field for error messages.
+  /// @return   false if an item is not a number, after reporting it.
+  bool ProcessCommaSeparatedList(std::vector<int>& results,
+                                 const StringPiece& str, const char* what);
+
+  /// @brief Parses the fields of the current line into entry.
+  ///
+  /// @param    entry     The entry to fill.
+  /// @return   false if a field is missing or malformed, after reporting it.
+  bool ProcessLine(PslEntry* entry);
 
  private:
   LineStream* stream_;
+  FieldSplitter fields_;
+  SymbolCache symbols_;
   BlatQuery* blat_query_;
   std::string query_name_;
-  std::string prev_query_name_;
 };
 
 }; // namespace bios
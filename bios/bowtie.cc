@@ -23,59 +23,28 @@
 /// This is the header for the module for parsing bowtie output files.
 
 #include "bowtie.hh"
+#include "numparse.hh"
 
-namespace bios {
-
-BowtieEntry::BowtieEntry() {
-  mismatches_ = std::vector<BowtieMismatch>();
-}
+#include <utility>
 
-BowtieEntry::BowtieEntry(const BowtieEntry& src_entry) {
-  const std::vector<BowtieMismatch>& src_mismatches = src_entry.mismatches();
-  for (std::vector<BowtieMismatch>::const_iterator it = src_mismatches.begin();
-      it != src_mismatches.end(); ++it) {
-    const BowtieMismatch& src_mismatch = *it;
-    BowtieMismatch dest_mismatch;
-    dest_mismatch.offset = src_mismatch.offset;
-    dest_mismatch.reference_base = src_mismatch.reference_base;
-    dest_mismatch.read_base = src_mismatch.read_base;
-    mismatches_.push_back(dest_mismatch);
-  }
-  chromosome_ = src_entry.chromosome();
-  sequence_ = src_entry.sequence();
-  quality_ = src_entry.quality();
-  position_ = src_entry.position();
-  strand_ = src_entry.strand();
-}
+namespace bios {
 
-BowtieEntry::~BowtieEntry() {
-  mismatches_.clear();
+BowtieEntry::BowtieEntry()
+    : chromosome_id_(SymbolTable::kEmptySymbol),
+      position_(0),
+      strand_('\0') {
 }
 
 BowtieQuery::BowtieQuery() {
-  entries_ = std::vector<BowtieEntry>();
-}
-
-BowtieQuery::BowtieQuery(const BowtieQuery& src_query) {
-  sequence_name_ = src_query.sequence_name();
-  const std::vector<BowtieEntry>& src_entries = src_query.entries();
-  for (std::vector<BowtieEntry>::const_iterator it = src_entries.begin();
-      it != src_entries.end(); ++it) {
-    const BowtieEntry& src_entry = *it;
-    BowtieEntry dest_entry(src_entry);
-    entries_.push_back(dest_entry);
-  }
-}
-
-BowtieQuery::~BowtieQuery() {
-  entries_.clear();
 }
 
 BowtieParser::BowtieParser()
-    : stream_(NULL) {
+    : stream_(NULL),
+      bowtie_query_(NULL) {
 }
 
 BowtieParser::~BowtieParser() {
+  delete bowtie_query_;
   delete stream_;
 }
 
@@ -83,46 +52,98 @@ BowtieParser::~BowtieParser() {
  * Initialize the bowtieParser module from file.
  * @param[in] fileName File name, use "-" to denote stdin
  */
-void BowtieParser::InitFromFile(const char* filename) {
-  stream_ = new FileLineStream(filename);
-  stream_->SetBuffer(1);
+void BowtieParser::InitFromFile(const char* filename,
+                                FileLineStream::ReadMode mode) {
+  InitFromStream(new FileLineStream(filename, mode));
 }
 
 void BowtieParser::InitFromPipe(const char* command) {
-  stream_ = new PipeLineStream(command);
+  InitFromStream(new PipeLineStream(command));
+}
+
+void BowtieParser::InitFromStream(LineStream* stream) {
+  stream_ = stream;
   stream_->SetBuffer(1);
 }
 
-void BowtieEntry::ProcessMismatches(char* token) {
-  if (token[0] == '\0') {
-    return;
+// Number of fields after the read name in a bowtie line.
+static const size_t kBowtieFieldsCount = 7;
+
+// Parses a comma-separated list of mismatches into mismatches.
+static bool ParseMismatches(const StringPiece& token, int line_number,
+                            std::vector<BowtieMismatch>* mismatches) {
+  if (token.empty()) {
+    return true;
   }
-  WordIter w(token, ",", false);
-  for (char* item; (item = w.Next()) != NULL; ) {
+  Tokenizer items(token, ",", false);
+  for (StringPiece item; items.Next(&item); ) {
+    // Each mismatch is written as <offset>:<reference base>><read base>.
     BowtieMismatch mismatch;
-    char* pos = strchr(item, ':');
-    *pos = '\0';
-    mismatch.offset = atoi(item);
-    mismatch.reference_base = *(pos + 1);
-    mismatch.read_base = *(pos + 3);
-    mismatches_.push_back(mismatch);
+    num::FromCharsResult result = num::from_chars(item.begin(), item.end(),
+                                                  &mismatch.offset);
+    if (result.status != num::kParseOk || item.end() - result.ptr != 4 ||
+        result.ptr[0] != ':' || result.ptr[2] != '>') {
+      num::report_parse_error("bowtie mismatch", item, num::kParseInvalid,
+                              line_number);
+      return false;
+    }
+    mismatch.reference_base = result.ptr[1];
+    mismatch.read_base = result.ptr[3];
+    mismatches->push_back(mismatch);
   }
+  return true;
+}
+
+// Checks the field count and strand of a bowtie line split after the read
+// name, and parses its position.
+static bool ParseFixedFields(const FieldSplitter& fields, int line_number,
+                             int* position) {
+  if (fields.size() < kBowtieFieldsCount) {
+    num::report_field_count_error("bowtie", kBowtieFieldsCount + 1,
+                                  fields.size() + 1, line_number);
+    return false;
+  }
+  if (fields[0].size() != 1) {
+    num::report_parse_error("bowtie strand", fields[0], num::kParseInvalid,
+                            line_number);
+    return false;
+  }
+  return num::parse_field(fields[2], position, "bowtie offset",
+                          line_number);
+}
+
+bool BowtieEntry::ProcessMismatches(const StringPiece& token,
+                                    int line_number) {
+  return ParseMismatches(token, line_number, &mismatches_);
 }
 
-void BowtieQuery::ProcessLine(std::string& line) {
-  BowtieEntry entry;
-  WordIter w(line, "\t", false);
-  entry.set_strand((w.Next())[0]);
-  std::string chromosome(w.Next());
-  entry.set_chromosome(chromosome);
-  entry.set_position(atoi(w.Next()));
-  std::string sequence(w.Next());
-  entry.set_sequence(sequence);
-  std::string quality(w.Next());
-  entry.set_quality(quality);
-  w.Next();
-  entry.ProcessMismatches(w.Next());
-  entries_.push_back(entry);
+bool BowtieQuery::ProcessLine(const StringPiece& line, int line_number) {
+  FieldSplitter fields;
+  fields.Split(line, '\t');
+  SymbolCache symbols;
+  return ProcessFields(fields, line_number, &symbols);
+}
+
+bool BowtieQuery::ProcessFields(const FieldSplitter& fields,
+                                int line_number, SymbolCache* symbols) {
+  int position;
+  if (!ParseFixedFields(fields, line_number, &position)) {
+    return false;
+  }
+  // Build the entry in place so the sequence and quality are copied once,
+  // straight from the line.
+  entries_.emplace_back();
+  BowtieEntry& entry = entries_.back();
+  if (!entry.ProcessMismatches(fields[6], line_number)) {
+    entries_.pop_back();
+    return false;
+  }
+  entry.set_strand(fields[0][0]);
+  entry.set_chromosome_id(symbols->Intern(fields[1]));
+  entry.set_position(position);
+  entry.set_sequence(fields[3]);
+  entry.set_quality(fields[4]);
+  return true;
 }
 
 BowtieQuery* BowtieParser::ProcessNextQuery() {
@@ -137,24 +158,27 @@ BowtieQuery* BowtieParser::ProcessNextQuery() {
 
   bowtie_query_ = new BowtieQuery;
   int first = 1;
-  for (std::string line; stream_->GetLine(line); ) {
+  for (StringPiece line; stream_->GetLine(&line); ) {
     if (line.empty()) {
       continue;
     }
     size_t pos = line.find('\t');
-    query_name_.replace(0, pos + 1, line);
-    if (first == 1 || prev_query_name_ == query_name_) {
-      std::string query_line = line.substr(pos + 1, line.size() - pos);
-      bowtie_query_->ProcessLine(query_line);
-    } else {
-      stream_->Back(line);
-      return bowtie_query_;
+    if (pos == StringPiece::npos) {
+      continue;
     }
+    StringPiece query_name = line.substr(0, pos);
     if (first == 1) {
+      query_name.CopyToString(&query_name_);
       bowtie_query_->set_sequence_name(query_name_);
       first = 0;
+    } else if (query_name != query_name_) {
+      stream_->Back(line);
+      return bowtie_query_;
     }
-    prev_query_name_ = query_name_;
+    // Malformed lines are reported and skipped.
+    fields_.Split(line.substr(pos + 1), '\t');
+    bowtie_query_->ProcessFields(fields_, stream_->GetLineCount(),
+                                 &symbols_);
   }
   if (first == 1) {
     return NULL;
@@ -170,13 +194,57 @@ BowtieQuery* BowtieParser::NextQuery() {
 std::vector<BowtieQuery> BowtieParser::GetAllQueries() {
   std::vector<BowtieQuery> queries;
   BowtieQuery* query;
+  // The parser owns query and deletes it on the next call, so its contents
+  // can be moved out instead of copied.
   while ((query = ProcessNextQuery()) != NULL) {
-    queries.push_back(*query);
-    delete query;
+    queries.push_back(std::move(*query));
   }
   return queries;
 }
 
+void BowtieBatch::clear() {
+  read_name.clear();
+  strand.clear();
+  chromosome.clear();
+  position.clear();
+  sequence.clear();
+  quality.clear();
+  mismatches.clear();
+}
+
+size_t BowtieParser::NextBatch(BowtieBatch* batch, size_t max_entries) {
+  batch->clear();
+  if (stream_ == NULL) {
+    return 0;
+  }
+  for (StringPiece line; batch->size() < max_entries &&
+           stream_->GetLine(&line); ) {
+    size_t pos = line.find('\t');
+    if (pos == StringPiece::npos) {
+      continue;
+    }
+    int line_number = stream_->GetLineCount();
+    fields_.Split(line.substr(pos + 1), '\t');
+    int position;
+    mismatches_.clear();
+    if (!ParseFixedFields(fields_, line_number, &position) ||
+        !ParseMismatches(fields_[6], line_number, &mismatches_)) {
+      continue;
+    }
+    batch->read_name.Append(line.substr(0, pos));
+    batch->strand.push_back(fields_[0][0]);
+    batch->chromosome.Append(fields_[1]);
+    batch->position.push_back(position);
+    batch->sequence.Append(fields_[3]);
+    batch->quality.Append(fields_[4]);
+    for (size_t i = 0; i < mismatches_.size(); ++i) {
+      batch->mismatches.AddValue(mismatches_[i]);
+    }
+    batch->mismatches.EndRow();
+  }
+  return batch->size();
+}
+
 }; // namespace bios
 
 /* vim: set ai ts=2 sts=2 sw=2 et: */
@@ -75,6 +75,9 @@
 #include <vector>
 #include <string>
 
+#include "column.hh"
+#include "fields.hh"
+#include "symbol.hh"
 #include "worditer.hh"
 #include "linestream.hh"
 
@@ -90,28 +93,45 @@ struct BowtieMismatch {
 
 /// @struct BowtieEntry
 /// @brief Structure for representing a bowtie entry.
+///
+/// Entries and queries use the compiler-generated copy and move operations,
+/// so moving a query into a vector moves its strings instead of copying them.
 struct BowtieEntry {
   BowtieEntry();
-  BowtieEntry(const BowtieEntry& src_entry);
-  ~BowtieEntry();
 
-  std::string chromosome() const { return chromosome_; }
-  std::string sequence() const { return sequence_; }
-  std::string quality() const { return quality_; }
+  const std::string& chromosome() const {
+    return SymbolTable::Global()->Name(chromosome_id_);
+  }
+  uint32_t chromosome_id() const { return chromosome_id_; }
+  const std::string& sequence() const { return sequence_; }
+  const std::string& quality() const { return quality_; }
   int position() const { return position_; }
   char strand() const { return strand_; }
   const std::vector<BowtieMismatch>& mismatches() const { return mismatches_; }
 
-  void set_chromosome(std::string chromosome) { chromosome_ = chromosome; }
-  void set_sequence(std::string sequence) { sequence_ = sequence; }
-  void set_quality(std::string quality) { quality_ = quality; }
+  void set_chromosome(const StringPiece& chromosome) {
+    chromosome_id_ = SymbolTable::Global()->Intern(chromosome);
+  }
+  void set_chromosome_id(uint32_t chromosome_id) {
+    chromosome_id_ = chromosome_id;
+  }
+  void set_sequence(const StringPiece& sequence) {
+    sequence.CopyToString(&sequence_);
+  }
+  void set_quality(const StringPiece& quality) {
+    quality.CopyToString(&quality_);
+  }
   void set_position(int position) { position_ = position; }
   void set_strand(char strand) { strand_ = strand; }
 
-  void ProcessMismatches(char* token);
+  /// @brief Parses a comma-separated list of mismatches such as
+  ///        "9:C>G,26:T>G" and adds them to the entry.
+  ///
+  /// @return   false if a mismatch is malformed, after reporting it.
+  bool ProcessMismatches(const StringPiece& token, int line_number = 0);
 
  private:
-  std::string chromosome_;
+  uint32_t chromosome_id_;
   std::string sequence_;
   std::string quality_;
   int position_;
@@ -124,8 +144,6 @@ struct BowtieEntry {
 class BowtieQuery {
  public:
   BowtieQuery();
-  BowtieQuery(const BowtieQuery& src_query);
-  ~BowtieQuery();
 
   const std::vector<BowtieEntry>& entries() const { return entries_; }
   std::string sequence_name() const { return sequence_name_; }
@@ -133,13 +151,45 @@ class BowtieQuery {
     sequence_name_ = sequence_name;
   }
 
-  void ProcessLine(std::string& line);
+  /// @brief Parses a bowtie line without its read name into an entry.
+  ///
+  /// @param    line         The fields after the read name.
+  /// @param    line_number  The line number for error messages, or 0.
+  /// @return   false if a field is missing or malformed, after reporting it
+  ///           to stderr. No entry is added in that case.
+  bool ProcessLine(const StringPiece& line, int line_number = 0);
+
+  /// @brief Like ProcessLine(), for a line that has already been split.
+  ///        Callers parsing many lines should split them with one
+  ///        FieldSplitter and intern names through one SymbolCache, as
+  ///        BowtieParser does, since ProcessLine() allocates both per line.
+  bool ProcessFields(const FieldSplitter& fields, int line_number,
+                     SymbolCache* symbols);
 
  private:
   std::string sequence_name_;
   std::vector<BowtieEntry> entries_;
 };
 
+/// @struct BowtieBatch
+/// @brief A batch of bowtie lines stored column by column.
+///
+/// Row i of every column belongs to the i-th line.
+struct BowtieBatch {
+  /// @brief Removes all rows, keeping the allocated memory.
+  void clear();
+
+  size_t size() const { return position.size(); }
+
+  StringColumn read_name;
+  std::vector<char> strand;
+  StringColumn chromosome;
+  std::vector<int> position;
+  StringColumn sequence;
+  StringColumn quality;
+  ListColumn<BowtieMismatch> mismatches;
+};
+
 /// @class BowtieParser
 /// @brief Class for parsing bowtie output files.
 class BowtieParser {
@@ -156,7 +206,11 @@ class BowtieParser {
   /// @brief Initializes the BowtieParser from a file.
   ///
   /// This method initializes the 
-  void InitFromFile(const char* filename);
+  ///
+  /// @param    filename  The name of the file or '-' for stdin.
+  /// @param    mode      How to read the file.
+  void InitFromFile(const char* filename,
+                    FileLineStream::ReadMode mode = FileLineStream::kReadMmap);
 
   /// @brief Initializes the BowtieParser from a piped command.
   ///
@@ -166,10 +220,19 @@ class BowtieParser {
   /// @param    command   The command to be executed.
   void InitFromPipe(const char* command);
 
+  /// @brief Initializes the BowtieParser from a line stream.
+  ///
+  /// This method reads bowtie output from an existing line stream, such as a
+  /// MemoryLineStream. The parser takes ownership of the stream.
+  ///
+  /// @param    stream    The line stream to read from.
+  void InitFromStream(LineStream* stream);
+
   /// @brief Returns the next bowtie query from the file.
   ///
   /// This method parses and returns a pointer to a BowtieQuery object
-  /// representing the next bowtie query from the file.
+  /// representing the next bowtie query from the file. The query belongs to
+  /// the parser and is deleted by the next call; do not delete it.
   ///
   /// @return   The next bowtie query from the file.
   BowtieQuery* NextQuery();
@@ -183,6 +246,17 @@ class BowtieParser {
   /// @return   All bowtie queries from the file.
   std::vector<BowtieQuery> GetAllQueries();
 
+  /// @brief Parses the next lines into columns.
+  ///
+  /// This method parses up to max_entries lines into batch, replacing its
+  /// contents, without grouping them by read or allocating an object per
+  /// line. Malformed lines are reported and skipped.
+  ///
+  /// @param    batch        The batch to fill.
+  /// @param    max_entries  The maximum number of lines to parse.
+  /// @return   The number of rows in the batch, 0 at the end of file.
+  size_t NextBatch(BowtieBatch* batch, size_t max_entries);
+
  private:
   /// @brief Parses the next bowtie query from the file.
   ///
@@ -197,7 +271,9 @@ class BowtieParser {
   LineStream* stream_;
   BowtieQuery* bowtie_query_;
   std::string query_name_;
-  std::string prev_query_name_;
+  FieldSplitter fields_;
+  SymbolCache symbols_;
+  std::vector<BowtieMismatch> mismatches_;
 };
 
 }; // namespace bios
@@ -0,0 +1,139 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file column.hh
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// Column types for record batches, which store many parsed records field
+/// by field in contiguous arrays instead of one object per record.
+/// Fixed-width fields are plain std::vectors. Strings and lists use the
+/// same layout as Apache Arrow: one buffer holding all values back to back,
+/// and an offsets array with one more entry than there are rows, so row i
+/// is [offsets[i], offsets[i + 1]).
+
+#ifndef BIOS_COLUMN_H__
+#define BIOS_COLUMN_H__
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "stringpiece.hh"
+
+namespace bios {
+
+/// @class StringColumn
+/// @brief A column of strings stored in one character buffer.
+///
+/// Offsets are 32 bits wide, so a column holds at most 4 GB of text.
+class StringColumn {
+ public:
+  StringColumn()
+      : offsets_(1, 0) {
+  }
+
+  /// @brief Appends a row.
+  void Append(const StringPiece& value) {
+    if (!value.empty()) {
+      data_.append(value.data(), value.size());
+    }
+    offsets_.push_back(data_.size());
+  }
+
+  /// @brief Returns row i as a view into the column, valid until the column
+  ///        is next modified.
+  StringPiece operator[](size_t i) const {
+    return StringPiece(data_.data() + offsets_[i],
+                       offsets_[i + 1] - offsets_[i]);
+  }
+
+  size_t size() const { return offsets_.size() - 1; }
+  bool empty() const { return offsets_.size() == 1; }
+
+  /// @brief Returns the row offsets into data(); size() + 1 entries.
+  const std::vector<uint32_t>& offsets() const { return offsets_; }
+
+  /// @brief Returns the characters of all rows back to back.
+  const std::string& data() const { return data_; }
+
+  /// @brief Removes all rows, keeping the allocated memory.
+  void clear() {
+    data_.clear();
+    offsets_.resize(1);
+  }
+
+ private:
+  std::string data_;
+  std::vector<uint32_t> offsets_;
+};
+
+/// @class ListColumn
+/// @brief A column of variable-length lists stored in one value array.
+///
+/// A row is built by calling AddValue() for each of its values and then
+/// EndRow().
+template <typename T>
+class ListColumn {
+ public:
+  ListColumn()
+      : offsets_(1, 0) {
+  }
+
+  void AddValue(const T& value) {
+    values_.push_back(value);
+  }
+
+  void EndRow() {
+    offsets_.push_back(values_.size());
+  }
+
+  /// @brief Returns the number of values in row i.
+  size_t row_size(size_t i) const {
+    return offsets_[i + 1] - offsets_[i];
+  }
+
+  /// @brief Returns a pointer to the first value of row i.
+  const T* row(size_t i) const {
+    return values_.empty() ? NULL : &values_[0] + offsets_[i];
+  }
+
+  size_t size() const { return offsets_.size() - 1; }
+  bool empty() const { return offsets_.size() == 1; }
+
+  /// @brief Returns the row offsets into values(); size() + 1 entries.
+  const std::vector<uint32_t>& offsets() const { return offsets_; }
+
+  /// @brief Returns the values of all rows back to back.
+  const std::vector<T>& values() const { return values_; }
+
+  /// @brief Removes all rows, keeping the allocated memory.
+  void clear() {
+    values_.clear();
+    offsets_.resize(1);
+  }
+
+ private:
+  std::vector<T> values_;
+  std::vector<uint32_t> offsets_;
+};
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
+#endif /* BIOS_COLUMN_H__ */
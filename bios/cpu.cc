@@ -0,0 +1,65 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file cpu.cc
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// Runtime detection of the SIMD instruction sets supported by the CPU.
+
+#include "cpu.hh"
+
+namespace bios {
+
+namespace cpu {
+
+// __builtin_cpu_init() is called first because these functions may be used
+// while initializing statics, before libgcc has run its own initializer.
+
+bool has_sse2() {
+#ifdef BIOS_X86
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("sse2");
+#else
+  return false;
+#endif
+}
+
+bool has_ssse3() {
+#ifdef BIOS_X86
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("ssse3");
+#else
+  return false;
+#endif
+}
+
+bool has_avx2() {
+#ifdef BIOS_X86
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+#else
+  return false;
+#endif
+}
+
+}; // namespace cpu
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
@@ -0,0 +1,52 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file cpu.hh
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// Runtime detection of the SIMD instruction sets supported by the CPU. The
+/// vectorized kernels in the library are compiled for several instruction
+/// sets and use these functions to pick one when they are first called.
+
+#ifndef BIOS_CPU_H__
+#define BIOS_CPU_H__
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BIOS_X86 1
+#endif
+
+namespace bios {
+
+namespace cpu {
+
+/// @brief Returns whether the CPU supports SSE2.
+bool has_sse2();
+
+/// @brief Returns whether the CPU supports SSSE3.
+bool has_ssse3();
+
+/// @brief Returns whether the CPU supports AVX2.
+bool has_avx2();
+
+}; // namespace cpu
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
+#endif /* BIOS_CPU_H__ */
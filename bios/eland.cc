@@ -39,7 +39,7 @@ ElandQuery* ElandParser::NextQuery() {
     if (line.empty()) {
       continue;
     }
-    WordIter w = WordIter(line, "\t", false);
+    WordIter w(line, "\t", false);
     ElandQuery* query = new ElandQuery;
     // remove the '>' character at beginning of the line
     query->sequence_name = w.Next() + 1;
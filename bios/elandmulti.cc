@@ -96,7 +96,7 @@ ElandMultiQuery* ElandMultiParser::NextQuery() {
         token = pos1 + 1;
       }
       entry.position = atoi(token);
-      entry.chromosome = chromosome;
+      entry.chromosome_id = symbols_.Intern(chromosome);
       query->entries.push_back(entry);
     }
     return query;
@@ -29,13 +29,20 @@
 #include <string>
 #include <iostream>
 
+#include "symbol.hh"
 #include "worditer.hh"
 #include "linestream.hh"
 
 namespace bios {
 
 struct ElandMultiEntry {
-  std::string chromosome;
+  ElandMultiEntry() : chromosome_id(SymbolTable::kEmptySymbol) {}
+
+  const std::string& chromosome() const {
+    return SymbolTable::Global()->Name(chromosome_id);
+  }
+
+  uint32_t chromosome_id;
   int position;
   char strand;
   int num_errors;
@@ -74,6 +81,7 @@ class ElandMultiParser {
 
  private:
   LineStream* stream_;
+  SymbolCache symbols_;
 };
 
 }; // namespace bios
@@ -24,6 +24,8 @@
 /// GERALD/ELAND platform.
 
 #include "exportpe.hh"
+#include "numparse.hh"
+#include "writer.hh"
 
 namespace bios {
 
@@ -39,7 +41,7 @@ std::string SingleEnd::ToString() {
   string_buffer << read_number << "\t";
   string_buffer << sequence.c_str() << "\t";
   string_buffer << quality.c_str() << "\t";
-  string_buffer << chromosome.c_str() << "\t";
+  string_buffer << chromosome() << "\t";
   string_buffer << contig.c_str() << "\t";
   if (position != 0 || strand != '\0') {
     string_buffer << position;
@@ -62,7 +64,7 @@ std::string SingleEnd::ToString() {
   }
   string_buffer << "\t";
 
-  string_buffer << partner_chromosome.c_str() << "\t";
+  string_buffer << partner_chromosome() << "\t";
   string_buffer << partner_contig.c_str() << "\t";
   if (partner_offset != 0 || strand != '\0') {
     string_buffer << partner_offset;
@@ -79,6 +81,61 @@ std::string SingleEnd::ToString() {
   return string_buffer.str();
 }
 
+void SingleEnd::AppendTo(RecordWriter* writer) {
+  writer->Append(machine.c_str());
+  writer->AppendChar('\t');
+  writer->AppendInt(run_number);
+  writer->AppendChar('\t');
+  writer->AppendInt(lane);
+  writer->AppendChar('\t');
+  writer->AppendInt(tile);
+  writer->AppendChar('\t');
+  writer->AppendInt(x_coord);
+  writer->AppendChar('\t');
+  writer->AppendInt(y_coord);
+  writer->AppendChar('\t');
+  writer->Append(index.c_str());
+  writer->AppendChar('\t');
+  writer->AppendInt(read_number);
+  writer->AppendChar('\t');
+  writer->Append(sequence.c_str());
+  writer->AppendChar('\t');
+  writer->Append(quality.c_str());
+  writer->AppendChar('\t');
+  writer->Append(chromosome());
+  writer->AppendChar('\t');
+  writer->Append(contig.c_str());
+  writer->AppendChar('\t');
+  if (position != 0 || strand != '\0') {
+    writer->AppendInt(position);
+  }
+  writer->AppendChar('\t');
+  writer->AppendChar(strand == '\0' ? ' ' : strand);
+  writer->AppendChar('\t');
+  writer->Append(match_descriptor.c_str());
+  writer->AppendChar('\t');
+  if (single_score != 0 || strand != '\0') {
+    writer->AppendInt(single_score);
+  }
+  writer->AppendChar('\t');
+  if (paired_score != 0 || strand != '\0') {
+    writer->AppendInt(paired_score);
+  }
+  writer->AppendChar('\t');
+  writer->Append(partner_chromosome());
+  writer->AppendChar('\t');
+  writer->Append(partner_contig.c_str());
+  writer->AppendChar('\t');
+  if (partner_offset != 0 || strand != '\0') {
+    writer->AppendInt(partner_offset);
+  }
+  writer->AppendChar('\t');
+  writer->AppendChar(partner_strand == '\0' ? ' ' : partner_strand);
+  writer->AppendChar('\t');
+  writer->AppendChar(filter);
+  writer->AppendChar('\n');
+}
+
 ExportPE::ExportPE() {
   end1 = NULL;
   end2 = NULL;
@@ -104,51 +161,89 @@ ExportPEParser::~ExportPEParser() {
 }
 
 void ExportPEParser::InitFromFile(const char* filename1, 
-                                  const char* filename2) {
-  stream1_ = new FileLineStream(filename1);
-  stream2_ = new FileLineStream(filename2);
+                                  const char* filename2,
+                                  FileLineStream::ReadMode mode) {
+  InitFromStream(new FileLineStream(filename1, mode),
+                 new FileLineStream(filename2, mode));
 }
 
 void ExportPEParser::InitFromPipe(const char* cmd1, const char* cmd2) {
-  stream1_ = new PipeLineStream(cmd1);
-  stream2_ = new PipeLineStream(cmd2);
+  InitFromStream(new PipeLineStream(cmd1), new PipeLineStream(cmd2));
 }
 
-int ExportPEParser::ProcessSingleEndEntry(ExportPE* entry, int read_number) {
-  std::string line;
-  bool ret;
-  if (read_number == 1) {
-    ret = stream1_->GetLine(line);
-  } else {
-    ret = stream2_->GetLine(line);
+void ExportPEParser::InitFromStream(LineStream* stream1,
+                                    LineStream* stream2) {
+  stream1_ = stream1;
+  stream2_ = stream2;
+}
+
+// Number of fields in an export line.
+static const size_t kExportFieldsCount = 22;
+
+// Parses an integer field that is empty for unaligned reads, in which case
+// it is 0.
+static bool ParseOptionalInt(const StringPiece& field, int* value,
+                             const char* what, int line_number) {
+  if (field.empty()) {
+    *value = 0;
+    return true;
   }
-  if (ret == false || stream1_->IsEof() || stream2_->IsEof()) {
+  return num::parse_field(field, value, what, line_number);
+}
+
+// Returns the first character of a field that is empty for unaligned reads.
+static char FirstChar(const StringPiece& field) {
+  return field.empty() ? '\0' : field[0];
+}
+
+int ExportPEParser::ProcessSingleEndEntry(ExportPE* entry, int read_number) {
+  LineStream* stream = read_number == 1 ? stream1_ : stream2_;
+  StringPiece line;
+  if (!stream->GetLine(&line)) {
     return 0;  // no more entries
   }
-  WordIter w(line, "\t", false);
+  int line_number = stream->GetLineCount();
+  if (fields_.Split(line, '\t') < kExportFieldsCount) {
+    num::report_field_count_error("export", kExportFieldsCount,
+                                  fields_.size(), line_number);
+    return -1;
+  }
   SingleEnd* end = new SingleEnd;
-  end->machine = w.Next();
-  end->run_number = atoi(w.Next());
-  end->lane = atoi(w.Next());
-  end->tile = atoi(w.Next());
-  end->x_coord = atoi(w.Next());
-  end->y_coord = atoi(w.Next());
-  end->index = w.Next();
-  end->read_number =  atoi(w.Next());
-  end->sequence = w.Next();
-  end->quality = w.Next();
-  end->chromosome =  w.Next();
-  end->contig = w.Next();
-  end->position = atoi(w.Next());
-  end->strand =  w.Next()[0] ;
-  end->match_descriptor = w.Next();
-  end->single_score = atoi(w.Next());
-  end->paired_score = atoi(w.Next());
-  end->partner_chromosome = w.Next();
-  end->partner_contig = w.Next();
-  end->partner_offset = atoi(w.Next());
-  end->partner_strand = w.Next()[0];
-  end->filter = w.Next()[0];
+  if (!num::parse_field(fields_[1], &end->run_number, "export run number",
+                        line_number) ||
+      !num::parse_field(fields_[2], &end->lane, "export lane",
+                        line_number) ||
+      !num::parse_field(fields_[3], &end->tile, "export tile",
+                        line_number) ||
+      !num::parse_field(fields_[4], &end->x_coord, "export x coordinate",
+                        line_number) ||
+      !num::parse_field(fields_[5], &end->y_coord, "export y coordinate",
+                        line_number) ||
+      !num::parse_field(fields_[7], &end->read_number, "export read number",
+                        line_number) ||
+      !ParseOptionalInt(fields_[12], &end->position, "export position",
+                        line_number) ||
+      !ParseOptionalInt(fields_[15], &end->single_score,
+                        "export single read score", line_number) ||
+      !ParseOptionalInt(fields_[16], &end->paired_score,
+                        "export paired read score", line_number) ||
+      !ParseOptionalInt(fields_[19], &end->partner_offset,
+                        "export partner offset", line_number)) {
+    delete end;
+    return -1;
+  }
+  fields_[0].CopyToString(&end->machine);
+  fields_[6].CopyToString(&end->index);
+  fields_[8].CopyToString(&end->sequence);
+  fields_[9].CopyToString(&end->quality);
+  end->chromosome_id = symbols_.Intern(fields_[10]);
+  fields_[11].CopyToString(&end->contig);
+  end->strand = FirstChar(fields_[13]);
+  fields_[14].CopyToString(&end->match_descriptor);
+  end->partner_chromosome_id = partner_symbols_.Intern(fields_[17]);
+  fields_[18].CopyToString(&end->partner_contig);
+  end->partner_strand = FirstChar(fields_[20]);
+  end->filter = FirstChar(fields_[21]);
   if (read_number == 1) {
     entry->end1 = end;
   } else {
@@ -158,36 +253,39 @@ int ExportPEParser::ProcessSingleEndEntry(ExportPE* entry, int read_number) {
 }
 
 ExportPE* ExportPEParser::ProcessNextEntry() {
-  int more_entries = 0;
   ExportPE* entry = new ExportPE;
-  more_entries += ProcessSingleEndEntry(entry, 1);
-  more_entries += ProcessSingleEndEntry(entry, 2);
-  if (more_entries > 0) {
-    SingleEnd* end1 = entry->end1;
-    SingleEnd* end2 = entry->end2;
-    std::stringstream id1;
-    std::stringstream id2;
-    id1 << end1->machine << ":" << end1->run_number << ":" << end1->lane << ":"
-        << end1->tile << ":" << end1->x_coord << ":" << end1->y_coord << "#"
-        << end1->index.c_str();
-    id2 << end2->machine << ":" << end2->run_number << ":" << end2->lane << ":"
-        << end2->tile << ":" << end2->x_coord << ":" << end2->y_coord << "#"
-        << end2->index.c_str();
-    if (id1.str() != id2.str()) {
-      std::cerr << "The IDs of the two entries do not match" << std::endl
-                << end1->ToString().c_str() << std::endl
-                << end2->ToString().c_str() << std::endl;
-      return NULL;
-    }
-    return entry;
-  } else {
-    if (more_entries == 0) {
-      return NULL;
-    } else {
+  int result1 = ProcessSingleEndEntry(entry, 1);
+  int result2 = ProcessSingleEndEntry(entry, 2);
+  if (result1 < 0 || result2 < 0) {
+    // The malformed line has been reported.
+    delete entry;
+    return NULL;
+  }
+  if (result1 + result2 < 2) {
+    if (result1 + result2 == 1) {
       std::cerr << "The export files do not have the same length" << std::endl;
-      return NULL;
     }
+    delete entry;
+    return NULL;
+  }
+  SingleEnd* end1 = entry->end1;
+  SingleEnd* end2 = entry->end2;
+  std::stringstream id1;
+  std::stringstream id2;
+  id1 << end1->machine << ":" << end1->run_number << ":" << end1->lane << ":"
+      << end1->tile << ":" << end1->x_coord << ":" << end1->y_coord << "#"
+      << end1->index.c_str();
+  id2 << end2->machine << ":" << end2->run_number << ":" << end2->lane << ":"
+      << end2->tile << ":" << end2->x_coord << ":" << end2->y_coord << "#"
+      << end2->index.c_str();
+  if (id1.str() != id2.str()) {
+    std::cerr << "The IDs of the two entries do not match" << std::endl
+              << end1->ToString().c_str() << std::endl
+              << end2->ToString().c_str() << std::endl;
+    delete entry;
+    return NULL;
   }
+  return entry;
 }
 
 ExportPE* ExportPEParser::NextEntry() {
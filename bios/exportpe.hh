@@ -30,17 +30,37 @@
 #include <cstdlib>
 #include <iostream>
 
+#include "fields.hh"
+#include "symbol.hh"
 #include "worditer.hh"
 #include "linestream.hh"
 
 namespace bios {
 
+class RecordWriter;
+
 struct SingleEnd {
+  SingleEnd()
+      : chromosome_id(SymbolTable::kEmptySymbol),
+        partner_chromosome_id(SymbolTable::kEmptySymbol) {
+  }
+
+  const std::string& chromosome() const {
+    return SymbolTable::Global()->Name(chromosome_id);
+  }
+  const std::string& partner_chromosome() const {
+    return SymbolTable::Global()->Name(partner_chromosome_id);
+  }
+
   /// Write an export entry;
   /// @param [in] currEntry: a pointer to the single end entry
   /// @return string formatted as an export file
   std::string ToString();
 
+  /// Append an export entry formatted as by ToString(), followed by a newline.
+  /// @param [in] writer: the writer to append to
+  void AppendTo(RecordWriter* writer);
+
   std::string machine;            // 1 machine
   int run_number;                 // 2 run number
   int lane;                       // 3 lane
@@ -51,14 +71,14 @@ struct SingleEnd {
   int read_number;                // 8 read number
   std::string sequence;           // 9 read
   std::string quality;            // 10 quality
-  std::string chromosome;         // 11 match chromosome
+  uint32_t chromosome_id;         // 11 match chromosome
   std::string contig;             // 12 match contig
   int position;                   // 13 match position
   char strand;                    // 14 match strand
   std::string match_descriptor;   // 15 match descriptor
   int single_score;               // 16 single read alignment score
   int paired_score;               // 17 paired end alignment score
-  std::string partner_chromosome; // 18 partner chromosome
+  uint32_t partner_chromosome_id; // 18 partner chromosome
   std::string partner_contig;     // 19 partner contig
   int partner_offset;             // 20 partner offset
   char partner_strand;            // 21 partner strand
@@ -81,22 +101,37 @@ class ExportPEParser {
   /// @brief Initialize the exportPEParser module from a file.
   /// @param filename1 First-end file name
   /// @param filename1 Second-end file name
-  void InitFromFile(const char* filename1, const char* filename2);
+  /// @param mode How to read the files
+  void InitFromFile(const char* filename1, const char* filename2,
+                    FileLineStream::ReadMode mode = FileLineStream::kReadMmap);
 
   /// Initialize the exportPEParser module from a command/
   /// @param cmd1 command to be executed for the first end
   /// @param cmd2 command to be executed for the second end
   void InitFromPipe(const char* cmd1, const char* cmd2);
 
+  /// Initialize the exportPEParser module from two line streams, such as
+  /// MemoryLineStreams. The parser takes ownership of both streams.
+  /// @param stream1 line stream for the first end
+  /// @param stream2 line stream for the second end
+  void InitFromStream(LineStream* stream1, LineStream* stream2);
+
+  /// Return the next pair of ends, or NULL at the end of the input or if a
+  /// line is malformed or the ends do not match, after reporting it.
   ExportPE* NextEntry();
 
  private:
+  /// Parse the next line of one end into entry. Returns 1 on success, 0 at
+  /// the end of the input and -1 for a malformed line.
   int ProcessSingleEndEntry(ExportPE* entry, int read_number);
   ExportPE* ProcessNextEntry();
 
  private:
   LineStream* stream1_;
   LineStream* stream2_;
+  FieldSplitter fields_;
+  SymbolCache symbols_;
+  SymbolCache partner_symbols_;
 };
 
 }; // namespace bios
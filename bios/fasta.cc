@@ -3,6 +3,12 @@
  /// @author Lukas Habegger (lukas.habegger@yale.edu)
 
 #include "fasta.hh"
+#include "writer.hh"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
 
 namespace bios {
 
@@ -19,9 +25,9 @@ FastaParser::~FastaParser() {
 /// Initialize the FASTA module using a file name.
 /// @note Use "-" to denote stdin.
 /// @post FastaParser::nextSequence(), FastaParser::readAllSequences() can be called.
-void FastaParser::InitFromFile(const char* filename) {
-  stream_ = new FileLineStream(filename);
-  stream_->SetBuffer(1);
+void FastaParser::InitFromFile(const char* filename,
+                               FileLineStream::ReadMode mode) {
+  InitFromStream(new FileLineStream(filename, mode));
 }
 
 /**
@@ -29,64 +35,92 @@ void FastaParser::InitFromFile(const char* filename) {
  * @post FastaParser::nextSequence(), FastaParser::readAllSequences() can be called.
  */
 void FastaParser::InitFromPipe(const char* command) {
-  stream_ = new PipeLineStream(command);
+  InitFromStream(new PipeLineStream(command));
+}
+
+/**
+ * Initialize the FASTA module from an existing line stream, such as a
+ * MemoryLineStream. The parser takes ownership of the stream.
+ * @post FastaParser::nextSequence(), FastaParser::readAllSequences() can be called.
+ */
+void FastaParser::InitFromStream(LineStream* stream) {
+  stream_ = stream;
   stream_->SetBuffer(1);
 }
 
-Seq* FastaParser::ProcessNextSequence(bool truncate_name) {
-  if (stream_->IsEof()) {
-    return NULL;
+/// Parses the next sequence into seq.
+/// The sequence lines are appended straight into a buffer that seq then
+/// takes over, so each base is copied once.
+bool FastaParser::NextSequence(bool truncate_name, Seq* seq) {
+  if (stream_ == NULL) {
+    return false;
   }
-
-  Seq* seq = new Seq;
-  int count = 0;
-  std::stringstream string_buffer;
-  for (std::string line; stream_->GetLine(line); ) {
+  bool found = false;
+  char* buffer = NULL;
+  size_t size = 0;
+  size_t capacity = 0;
+  for (StringPiece line; stream_->GetLine(&line); ) {
     if (line.empty()) {
       continue;
     }
     if (line[0] == '>') {
-      ++count;
-      if (count == 1) {
-        seq->name = strdup(line.c_str() + 1);
-        if (truncate_name) {
-          size_t pos = string::skip_leading_spaces(seq->name);
-          seq->name = string::first_word_in_line(seq->name, pos);
-        }
-        continue;
-      } else if (count == 2) {
-        seq->sequence = strdup((char*) string_buffer.str().c_str());
-        seq->size = string_buffer.str().size();
+      if (found) {
         stream_->Back(line);
-        return seq;
+        break;
       }
+      seq->SetNameFromHeader(line.substr(1), truncate_name);
+      found = true;
+      continue;
+    }
+    if (!found) {
+      // Sequence lines before the first header form an unnamed sequence.
+      seq->name.clear();
+      found = true;
     }
-    string_buffer << line;
+    if (size + line.size() + 1 > capacity) {
+      capacity = std::max(2 * capacity, size + line.size() + 1);
+      buffer = static_cast<char*>(realloc(buffer, capacity));
+    }
+    memcpy(buffer + size, line.data(), line.size());
+    size += line.size();
   }
-  seq->sequence = strdup((char*) string_buffer.str().c_str());
-  seq->size = string_buffer.str().size();
-  return seq;
+  if (!found) {
+    return false;
+  }
+  if (buffer == NULL) {
+    buffer = static_cast<char*>(malloc(1));
+  }
+  buffer[size] = '\0';
+  seq->AdoptSequence(buffer, size);
+  delete seq->mask;
+  seq->mask = NULL;
+  return true;
 }
 
 /// Returns a pointer to the next FASTA sequence.
 /// @param[in] truncate_name If truncate_name > 0, leading spaces of the name
 ///            are skipped. Furthermore, the name is truncated after the first
 ///            white space. If truncate_name == 0, the name is stored as is.
-/// @note The memory belongs to this routine.
+/// @note The caller owns the returned sequence and must delete it.
 Seq* FastaParser::NextSequence(bool truncate_name) {
-  return ProcessNextSequence(truncate_name);
+  Seq* seq = new Seq;
+  if (!NextSequence(truncate_name, seq)) {
+    delete seq;
+    return NULL;
+  }
+  return seq;
 }
 
 /// Returns an Array of FASTA sequences.
 /// @param[in] truncate_name If truncate_name > 0, leading spaces of the name
 ///            are skipped. Furthermore, the name is truncated after the first
 ///            white space. If truncate_name == 0, the name is stored as is.
-/// @note The memory belongs to this routine.
+/// @note Sequences are moved into the vector; no buffer is copied.
 std::vector<Seq> FastaParser::ReadAllSequences(bool truncate_name) {
   std::vector<Seq> seqs;
-  Seq* seq = NULL;
-  while ((seq = ProcessNextSequence(truncate_name)) != NULL) {
-    seqs.push_back(*seq);
+  Seq seq;
+  while (NextSequence(truncate_name, &seq)) {
+    seqs.push_back(std::move(seq));
   }
   return seqs;
 }
@@ -99,6 +133,24 @@ void FastaParser::PrintSequence(Seq& seq) {
   printf(">%s\n%s\n", seq.name.c_str(), str.c_str());
 }
 
+/// Appends seq to writer in the format of PrintSequence(), without building
+/// the wrapped sequence as a string first.
+void FastaParser::AppendSequence(Seq& seq, RecordWriter* writer) {
+  writer->AppendChar('>');
+  writer->Append(seq.name);
+  writer->AppendChar('\n');
+  size_t size = strlen(seq.sequence);
+  for (size_t i = 0; i < size; i += kCharactersPerLine) {
+    size_t line_size = size - i < static_cast<size_t>(kCharactersPerLine) ?
+        size - i : kCharactersPerLine;
+    writer->Append(seq.sequence + i, line_size);
+    writer->AppendChar('\n');
+  }
+  if (size == 0) {
+    writer->AppendChar('\n');
+  }
+}
+
 /// Prints seqs to stdout.
 void FastaParser::PrintAllSequences(std::vector<Seq>& seqs) {
   for (std::vector<Seq>::iterator it = seqs.begin(); it != seqs.end(); ++it) {
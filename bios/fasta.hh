@@ -15,21 +15,27 @@
 
 namespace bios {
 
+class RecordWriter;
+
 class FastaParser {
  public:
   FastaParser();
   ~FastaParser();
 
-  void InitFromFile(const char* filename);
+  void InitFromFile(const char* filename,
+                    FileLineStream::ReadMode mode = FileLineStream::kReadMmap);
   void InitFromPipe(const char* command);
+  void InitFromStream(LineStream* stream);
 
   Seq* NextSequence(bool truncate_name);
   std::vector<Seq> ReadAllSequences(bool truncate_name);
+
+  /// Parses the next sequence into seq, replacing its contents. Returns
+  /// false at the end of the input.
+  bool NextSequence(bool truncate_name, Seq* seq);
   void PrintSequence(Seq& seq);
   void PrintAllSequences(std::vector<Seq>& seqs);
-
- private:
-  Seq* ProcessNextSequence(bool truncate_name);
+  void AppendSequence(Seq& seq, RecordWriter* writer);
 
  private:
   LineStream* stream_;
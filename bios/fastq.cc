@@ -4,15 +4,51 @@
  */
 
 #include "fastq.hh"
+#include "writer.hh"
+
+#include <cstdlib>
+#include <cstring>
+#include <utility>
 
 namespace bios {
 
-Fastq::Fastq() {
-  seq = new Seq;
+Fastq::Fastq()
+    : seq(new Seq),
+      quality(NULL) {
+}
+
+Fastq::Fastq(Fastq&& other) noexcept
+    : seq(other.seq),
+      quality(other.quality) {
+  other.seq = NULL;
+  other.quality = NULL;
+}
+
+Fastq& Fastq::operator=(Fastq&& other) noexcept {
+  if (this != &other) {
+    delete seq;
+    free(quality);
+    seq = other.seq;
+    quality = other.quality;
+    other.seq = NULL;
+    other.quality = NULL;
+  }
+  return *this;
 }
 
 Fastq::~Fastq() {
   delete seq;
+  free(quality);
+}
+
+void Fastq::AppendTo(RecordWriter* writer) {
+  writer->AppendChar('@');
+  writer->Append(seq->name);
+  writer->AppendChar('\n');
+  writer->Append(seq->sequence);
+  writer->Append("\n+\n", 3);
+  writer->Append(quality);
+  writer->AppendChar('\n');
 }
 
 FastqParser::FastqParser()
@@ -28,9 +64,9 @@ FastqParser::~FastqParser() {
  * @note Use "-" to denote stdin.
  * @post FastqParser::nextSequence(), FastqParser::readAllSequences() can be called.
  */
-void FastqParser::InitFromFile(const char* filename) {
-  stream_ = new FileLineStream(filename);
-  stream_->SetBuffer(1);
+void FastqParser::InitFromFile(const char* filename,
+                               FileLineStream::ReadMode mode) {
+  InitFromStream(new FileLineStream(filename, mode));
 }
 
 /**
@@ -38,66 +74,88 @@ void FastqParser::InitFromFile(const char* filename) {
  * @post FastqParser::nextSequence(), FastqParser::readAllSequences() can be called.
  */
 void FastqParser::InitFromPipe(const char* command) {
-  stream_ = new PipeLineStream(command);
+  InitFromStream(new PipeLineStream(command));
+}
+
+/**
+ * Initialize the FASTQ module from an existing line stream, such as a
+ * MemoryLineStream. The parser takes ownership of the stream.
+ * @post FastqParser::nextSequence(), FastqParser::readAllSequences() can be called.
+ */
+void FastqParser::InitFromStream(LineStream* stream) {
+  stream_ = stream;
   stream_->SetBuffer(1);
 }
 
-Fastq* FastqParser::ProcessNextSequence (bool truncate_name) {
-  if (stream_->IsEof()) {
-    return NULL;
-  }
+/// Copies line into a NUL-terminated buffer allocated with malloc().
+static char* CopyLine(const StringPiece& line) {
+  char* buffer = static_cast<char*>(malloc(line.size() + 1));
+  memcpy(buffer, line.data(), line.size());
+  buffer[line.size()] = '\0';
+  return buffer;
+}
 
-  Fastq* fq = NULL;
-  for (std::string line; stream_->GetLine(line); ) {
-    if (line.empty()) {
-      continue;
-    }
-    if (line[0] == '@') {      
-      fq = new Fastq;
-      Seq* seq = fq->seq;
-      seq->name = strdup(line.c_str() + 1);
-      if (truncate_name) {
-        size_t pos = string::skip_leading_spaces(seq->name);
-        seq->name = string::first_word_in_line(seq->name, pos);
-      }
-      stream_->GetLine(line); // reading sequence
-      seq->sequence = strdup(line.c_str());
-      seq->size = strlen(seq->sequence);
-      stream_->GetLine(line); // reading quality ID
-      if (line[0] != '+') {
-        std::cerr << "Expected quality ID: '+' or '+" << seq->name << "'"
-                  << std::endl;
-        return NULL;
-      }
-      stream_->GetLine(line); // reading quality
-      fq->quality = strdup(line.c_str());
-      break;
+bool FastqParser::NextSequence(bool truncate_name, Fastq* fq) {
+  if (stream_ == NULL) {
+    return false;
+  }
+  StringPiece line;
+  do {
+    if (!stream_->GetLine(&line)) {
+      return false;
     }
-  }   
-  return fq;
+  } while (line.empty() || line[0] != '@');
+
+  if (fq->seq == NULL) {
+    fq->seq = new Seq;
+  }
+  Seq* seq = fq->seq;
+  seq->SetNameFromHeader(line.substr(1), truncate_name);
+  if (!stream_->GetLine(&line)) {
+    std::cerr << "Missing sequence for '" << seq->name << "'" << std::endl;
+    return false;
+  }
+  seq->AdoptSequence(CopyLine(line), line.size());
+  if (!stream_->GetLine(&line) || line.empty() || line[0] != '+') {
+    std::cerr << "Expected quality ID: '+' or '+" << seq->name << "'"
+              << std::endl;
+    return false;
+  }
+  if (!stream_->GetLine(&line)) {
+    std::cerr << "Missing quality for '" << seq->name << "'" << std::endl;
+    return false;
+  }
+  free(fq->quality);
+  fq->quality = CopyLine(line);
+  return true;
 }
 
 /**
  * Returns a pointer to the next FASTQ sequence.
  * @param[in] truncate_name If truncate_name > 0, leading spaces of the name are skipped. Furthermore, the name is truncated after the first white space. If truncate_name == 0, the name is stored as is.
- * @note The memory belongs to this routine.
+ * @note The caller owns the returned record and must delete it.
  */
 Fastq* FastqParser::NextSequence(bool truncate_name) {
-  return ProcessNextSequence(truncate_name);
+  Fastq* fq = new Fastq;
+  if (!NextSequence(truncate_name, fq)) {
+    delete fq;
+    return NULL;
+  }
+  return fq;
 }
 
 /**
  * Returns an Array of FASTQ sequences.
  * @param[in] truncate_name If truncate_name > 0, leading spaces of the name are skipped. Furthermore, the name is truncated after the first white space. If truncate_name == 0, the name is stored as is.
- * @note The memory belongs to this routine.
+ * @note Records are moved into the vector; no buffer is copied.
  */
 std::vector<Fastq> FastqParser::ReadAllSequences(bool truncate_name) {
-  std::vector<Fastq> seqs;
-  Fastq* fq = NULL;
-  while ((fq = ProcessNextSequence(truncate_name)) != NULL) {
-    seqs.push_back(*fq);
+  std::vector<Fastq> fqs;
+  Fastq fq;
+  while (NextSequence(truncate_name, &fq)) {
+    fqs.push_back(std::move(fq));
   }
-  return seqs;
+  return fqs;
 }
 
 /**
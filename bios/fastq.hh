@@ -16,12 +16,27 @@
 
 namespace bios {
 
+class RecordWriter;
+
+/// A Fastq owns its Seq and quality string. Like Seq it can be moved but
+/// not copied.
 struct Fastq {
   Fastq();
+  Fastq(Fastq&& other) noexcept;
+  Fastq& operator=(Fastq&& other) noexcept;
   ~Fastq();
 
+  /// Appends the record in FASTQ format, followed by a newline.
+  void AppendTo(RecordWriter* writer);
+
   Seq* seq;
+
+  // Quality string, allocated with malloc().
   char* quality;
+
+ private:
+  Fastq(const Fastq&);
+  void operator=(const Fastq&);
 };
 
 class FastqParser {
@@ -29,17 +44,20 @@ class FastqParser {
   FastqParser();
   ~FastqParser();
 
-  void InitFromFile(const char* filename);
+  void InitFromFile(const char* filename,
+                    FileLineStream::ReadMode mode = FileLineStream::kReadMmap);
   void InitFromPipe(const char* command);
+  void InitFromStream(LineStream* stream);
 
   Fastq* NextSequence(bool truncate_name);
   std::vector<Fastq> ReadAllSequences(bool truncate_name);
+
+  /// Parses the next record into fq, replacing its contents. Returns false
+  /// at the end of the input or, after reporting it, at a malformed record.
+  bool NextSequence(bool truncate_name, Fastq* fq);
   char* PrintSequence(Fastq& fq);
   void PrintAllSequences(std::vector<Fastq>& fqs);
 
- private:
-  Fastq* ProcessNextSequence(bool truncate_name);
-
  private:
   enum {
     kCharactersPerLine = 60,
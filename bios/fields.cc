@@ -0,0 +1,95 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file fields.cc
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// Implementation of FieldSplitter.
+
+#include "fields.hh"
+
+#include <algorithm>
+
+#include "scan.hh"
+
+namespace bios {
+
+// Initial capacity of the offset array, enough for BED12, PSL and the
+// BLAST tabular format without growing.
+static const size_t kInitialFields = 32;
+
+FieldSplitter::FieldSplitter()
+    : data_(NULL) {
+  ends_.reserve(kInitialFields);
+}
+
+size_t FieldSplitter::Split(const StringPiece& line, char separator,
+                            size_t max_fields) {
+  data_ = line.data();
+  const char* begin = line.begin();
+  const char* end = line.end();
+  size_t count = 0;
+  if (max_fields == 0) {
+    ends_.clear();
+    return 0;
+  }
+
+  // Fill the spare capacity of ends_ with separator positions. If the
+  // search fills it completely there may be more separators, so grow and
+  // resume after the last one found. Each separator ends a field, so the
+  // search stops after max_fields of them. A copied or moved-from splitter
+  // has no capacity, so make room for kInitialFields at least.
+  ends_.resize(std::max(ends_.capacity(), kInitialFields));
+  for (;;) {
+    const char* start = begin;
+    if (count > 0) {
+      start = begin + ends_[count - 1] + 1;
+    }
+    size_t space = ends_.size() - count;
+    if (space > max_fields - count) {
+      space = max_fields - count;
+    }
+    size_t found = scan::find_all_bytes(start, end, separator,
+                                        &ends_[count], space);
+    uint32_t base = start - begin;
+    for (size_t i = count; i < count + found; ++i) {
+      ends_[i] += base;
+    }
+    count += found;
+    if (count == max_fields) {
+      ends_.resize(count);
+      return count;
+    }
+    if (found < space) {
+      break;
+    }
+    ends_.resize(std::max(ends_.size() * 2, kInitialFields));
+  }
+
+  if (count == ends_.size()) {
+    ends_.resize(count + 1);
+  }
+  ends_[count++] = line.size();
+  ends_.resize(count);
+  return count;
+}
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
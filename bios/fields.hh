@@ -0,0 +1,90 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file fields.hh
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// FieldSplitter splits a delimited line (tab- or comma-separated) into
+/// fields in one pass. The separator positions are found with the vector
+/// search in scan.hh and stored in an offset array, so a parser can look up
+/// field i directly instead of walking a Tokenizer field by field.
+
+#ifndef BIOS_FIELDS_H__
+#define BIOS_FIELDS_H__
+
+#include <stdint.h>
+#include <vector>
+
+#include "stringpiece.hh"
+
+namespace bios {
+
+/// @class FieldSplitter
+/// @brief Splits a line on a single separator character into field views.
+///
+/// Every separator ends a field, so consecutive separators yield empty
+/// fields and an empty line has one empty field. The fields are views into
+/// the line passed to Split(), which must stay valid while they are used.
+/// The offset array is reused, so a splitter kept across lines does not
+/// allocate once it has grown to the widest line.
+class FieldSplitter {
+ public:
+  FieldSplitter();
+
+  /// @brief Splits line on separator, replacing the previous fields.
+  ///
+  /// @param    line        The line to split, without its newline.
+  /// @param    separator   The field separator, such as '\t' or ','.
+  /// @param    max_fields  The number of leading fields wanted. The search
+  ///                       stops once they are found, so the rest of a wide
+  ///                       line is not scanned.
+  /// @return   The number of fields, at most max_fields.
+  size_t Split(const StringPiece& line, char separator,
+               size_t max_fields = kAllFields);
+
+  static const size_t kAllFields = static_cast<size_t>(-1);
+
+  /// @brief Returns the number of fields found by the last Split().
+  size_t size() const {
+    return ends_.size();
+  }
+
+  /// @brief Returns field i. i must be less than size().
+  StringPiece field(size_t i) const {
+    uint32_t begin = i == 0 ? 0 : ends_[i - 1] + 1;
+    return StringPiece(data_ + begin, ends_[i] - begin);
+  }
+
+  StringPiece operator[](size_t i) const {
+    return field(i);
+  }
+
+ private:
+  const char* data_;
+
+  // Offset of the end of each field from the start of the line: the
+  // position of the separator following it, or the line length for the
+  // last field.
+  std::vector<uint32_t> ends_;
+};
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
+#endif /* BIOS_FIELDS_H__ */
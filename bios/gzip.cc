@@ -0,0 +1,419 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file gzip.cc
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// In-process decompression of gzip input using zlib, and parallel
+/// decompression of BGZF input.
+
+#include "gzip.hh"
+
+#include <algorithm>
+#include <cerrno>
+#include <stdint.h>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+namespace bios {
+
+GzipReader::GzipReader()
+    : initialized_(false),
+      done_(false),
+      error_(false),
+      input_(NULL),
+      input_end_(NULL),
+      fd_(-1),
+      input_buffer_(NULL) {
+  memset(&stream_, 0, sizeof(stream_));
+}
+
+GzipReader::~GzipReader() {
+  if (initialized_) {
+    inflateEnd(&stream_);
+  }
+  free(input_buffer_);
+}
+
+bool GzipReader::IsGzip(const char* data, size_t size) {
+  return size >= 2 &&
+      static_cast<unsigned char>(data[0]) == 0x1f &&
+      static_cast<unsigned char>(data[1]) == 0x8b;
+}
+
+bool GzipReader::Init() {
+  // 16 + MAX_WBITS makes zlib expect a gzip header and trailer.
+  if (inflateInit2(&stream_, 16 + MAX_WBITS) != Z_OK) {
+    error_ = true;
+    done_ = true;
+    return false;
+  }
+  initialized_ = true;
+  return true;
+}
+
+bool GzipReader::Open(const char* data, size_t size) {
+  input_ = data;
+  input_end_ = data + size;
+  return Init();
+}
+
+bool GzipReader::Open(int fd) {
+  fd_ = fd;
+  input_buffer_ = static_cast<unsigned char*>(malloc(kInputBufferSize));
+  return Init();
+}
+
+// Hands the next piece of compressed input to zlib. Returns false if there
+// is no more input.
+bool GzipReader::FillInput() {
+  if (fd_ < 0) {
+    size_t remaining = input_end_ - input_;
+    if (remaining == 0) {
+      return false;
+    }
+    size_t chunk = remaining < kMaxInputChunk ? remaining : kMaxInputChunk;
+    stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input_));
+    stream_.avail_in = chunk;
+    input_ += chunk;
+    return true;
+  }
+  for (;;) {
+    ssize_t bytes_read = read(fd_, input_buffer_, kInputBufferSize);
+    if (bytes_read > 0) {
+      stream_.next_in = input_buffer_;
+      stream_.avail_in = bytes_read;
+      return true;
+    }
+    if (bytes_read == 0 || errno != EINTR) {
+      return false;
+    }
+  }
+}
+
+size_t GzipReader::Read(char* buffer, size_t size) {
+  if (done_) {
+    return 0;
+  }
+  size_t total = 0;
+  while (total < size && !done_) {
+    size_t chunk = size - total;
+    if (chunk > kMaxInputChunk) {
+      chunk = kMaxInputChunk;
+    }
+    if (stream_.avail_in == 0 && !FillInput()) {
+      // Input ended in the middle of a member.
+      error_ = (stream_.total_in > 0);
+      done_ = true;
+      break;
+    }
+    stream_.next_out = reinterpret_cast<Bytef*>(buffer + total);
+    stream_.avail_out = chunk;
+    int ret = inflate(&stream_, Z_NO_FLUSH);
+    total += chunk - stream_.avail_out;
+    if (ret == Z_STREAM_END) {
+      // BGZF and files compressed in parallel are made of several members;
+      // continue with the next one if there is one.
+      if (stream_.avail_in == 0 && !FillInput()) {
+        done_ = true;
+      } else if (stream_.next_in[0] != 0x1f) {
+        // Trailing padding after the last member.
+        done_ = true;
+      } else {
+        inflateReset(&stream_);
+      }
+    } else if (ret != Z_OK && ret != Z_BUF_ERROR) {
+      error_ = true;
+      done_ = true;
+    }
+  }
+  return total;
+}
+
+//-----------------------------------------------------------------------------
+// BgzfReader methods
+//-----------------------------------------------------------------------------
+
+// Fixed part of a gzip member header; the extra field follows it.
+static const size_t kGzipHeaderSize = 12;
+
+// Size of the CRC32 and ISIZE fields that end every gzip member.
+static const size_t kGzipFooterSize = 8;
+
+// BGZF blocks hold at most 64 KB of uncompressed data.
+static const uint32_t kBgzfMaxBlockOutput = 1 << 16;
+
+static inline uint32_t read_le16(const unsigned char* p) {
+  return p[0] | (p[1] << 8);
+}
+
+static inline uint32_t read_le32(const unsigned char* p) {
+  return p[0] | (p[1] << 8) | (p[2] << 16) |
+         (static_cast<uint32_t>(p[3]) << 24);
+}
+
+// Parses the header of the BGZF block at p. On success, returns the total
+// size of the block and stores the size of its header in header_size.
+// Returns 0 if p does not point to a complete BGZF block, or if the block
+// claims more uncompressed data than a BGZF block can hold.
+static size_t parse_bgzf_block(const unsigned char* p, size_t remaining,
+                               size_t* header_size) {
+  if (remaining < kGzipHeaderSize || p[0] != 0x1f || p[1] != 0x8b ||
+      p[2] != Z_DEFLATED || (p[3] & 0x04) == 0) {
+    return 0;
+  }
+  size_t extra_size = read_le16(p + 10);
+  if (remaining < kGzipHeaderSize + extra_size) {
+    return 0;
+  }
+  const unsigned char* extra = p + kGzipHeaderSize;
+  const unsigned char* extra_end = extra + extra_size;
+  while (extra + 4 <= extra_end) {
+    size_t field_size = read_le16(extra + 2);
+    if (extra[0] == 'B' && extra[1] == 'C' && field_size == 2 &&
+        extra + 6 <= extra_end) {
+      size_t block_size = read_le16(extra + 4) + 1;
+      *header_size = kGzipHeaderSize + extra_size;
+      if (block_size < *header_size + kGzipFooterSize ||
+          block_size > remaining ||
+          read_le32(p + block_size - 4) > kBgzfMaxBlockOutput) {
+        return 0;
+      }
+      return block_size;
+    }
+    extra += 4 + field_size;
+  }
+  return 0;
+}
+
+bool BgzfReader::IsBgzf(const char* data, size_t size) {
+  size_t header_size;
+  return parse_bgzf_block(reinterpret_cast<const unsigned char*>(data), size,
+                          &header_size) > 0;
+}
+
+/// @class BgzfWorker
+/// @brief Worker thread that inflates the jobs queued by a BgzfReader.
+class BgzfWorker : public Thread {
+ public:
+  BgzfWorker(BgzfReader* reader)
+      : reader_(reader) {
+    memset(&stream_, 0, sizeof(stream_));
+    // Negative window bits: raw deflate data without a gzip wrapper.
+    initialized_ = (inflateInit2(&stream_, -MAX_WBITS) == Z_OK);
+  }
+
+  ~BgzfWorker() {
+    Join();
+    if (initialized_) {
+      inflateEnd(&stream_);
+    }
+  }
+
+ protected:
+  void Run() {
+    for (;;) {
+      BgzfReader::Job* job = NULL;
+      {
+        MutexLock lock(&reader_->mutex_);
+        while (reader_->queue_.empty() && !reader_->shutdown_) {
+          reader_->work_ready_.Wait(&reader_->mutex_);
+        }
+        if (reader_->queue_.empty()) {
+          return;
+        }
+        job = reader_->queue_.front();
+        reader_->queue_.pop_front();
+      }
+      bool ok = initialized_ && BgzfReader::Inflate(job, &stream_);
+      {
+        MutexLock lock(&reader_->mutex_);
+        job->error = !ok;
+        job->done = true;
+        reader_->job_done_.SignalAll();
+      }
+    }
+  }
+
+ private:
+  BgzfReader* reader_;
+  z_stream stream_;
+  bool initialized_;
+};
+
+BgzfReader::BgzfReader(int num_threads)
+    : num_threads_(num_threads > 0 ? num_threads :
+                   std::min(Thread::NumProcessors(),
+                            static_cast<int>(kDefaultMaxThreads))),
+      submitted_(0),
+      consumed_(0),
+      input_(NULL),
+      input_end_(NULL),
+      input_error_(false),
+      error_(false),
+      shutdown_(false) {
+}
+
+BgzfReader::~BgzfReader() {
+  {
+    MutexLock lock(&mutex_);
+    shutdown_ = true;
+    queue_.clear();
+    work_ready_.SignalAll();
+  }
+  for (size_t i = 0; i < workers_.size(); ++i) {
+    delete workers_[i];
+  }
+  for (size_t i = 0; i < jobs_.size(); ++i) {
+    free(jobs_[i].output);
+  }
+}
+
+bool BgzfReader::Open(const char* data, size_t size) {
+  input_ = reinterpret_cast<const unsigned char*>(data);
+  input_end_ = input_ + size;
+  Job empty_job;
+  memset(&empty_job, 0, sizeof(empty_job));
+  jobs_.assign(num_threads_ * kJobsPerThread, empty_job);
+  for (int i = 0; i < num_threads_; ++i) {
+    Thread* worker = new BgzfWorker(this);
+    if (!worker->Start()) {
+      delete worker;
+      break;
+    }
+    workers_.push_back(worker);
+  }
+  return !workers_.empty();
+}
+
+// Inflates every block of a job into its output buffer and checks the
+// CRC32 of each. Runs on a worker thread without holding the lock.
+bool BgzfReader::Inflate(Job* job, z_stream* stream) {
+  const unsigned char* p = job->input;
+  const unsigned char* end = p + job->input_size;
+  char* out = job->output;
+  while (p < end) {
+    size_t header_size;
+    size_t block_size = parse_bgzf_block(p, end - p, &header_size);
+    const unsigned char* footer = p + block_size - kGzipFooterSize;
+    uint32_t expected_crc = read_le32(footer);
+    uint32_t uncompressed_size = read_le32(footer + 4);
+    if (uncompressed_size > 0) {
+      inflateReset(stream);
+      stream->next_in = const_cast<Bytef*>(p + header_size);
+      stream->avail_in = block_size - header_size - kGzipFooterSize;
+      stream->next_out = reinterpret_cast<Bytef*>(out);
+      stream->avail_out = uncompressed_size;
+      if (inflate(stream, Z_FINISH) != Z_STREAM_END ||
+          stream->avail_out != 0) {
+        return false;
+      }
+      uLong crc = crc32(0L, reinterpret_cast<const Bytef*>(out),
+                        uncompressed_size);
+      if (crc != expected_crc) {
+        return false;
+      }
+      out += uncompressed_size;
+    }
+    p += block_size;
+  }
+  return true;
+}
+
+// Fills the free job slots with runs of blocks from the input and queues them
+// for the workers. Only the block headers and footers are read here.
+void BgzfReader::SubmitJobs() {
+  while (submitted_ - consumed_ < jobs_.size() && input_ < input_end_ &&
+         !input_error_) {
+    Job* job = &jobs_[submitted_ % jobs_.size()];
+    const unsigned char* p = input_;
+    size_t output_size = 0;
+    while (p < input_end_ && output_size < kJobOutputSize) {
+      size_t header_size;
+      size_t block_size = parse_bgzf_block(p, input_end_ - p, &header_size);
+      if (block_size == 0) {
+        input_error_ = true;
+        break;
+      }
+      output_size += read_le32(p + block_size - 4);
+      p += block_size;
+    }
+    if (p == input_) {
+      break;
+    }
+    if (job->output_capacity < output_size) {
+      free(job->output);
+      job->output = static_cast<char*>(malloc(output_size));
+      job->output_capacity = output_size;
+    }
+    job->input = input_;
+    job->input_size = p - input_;
+    job->output_size = output_size;
+    job->consumed = 0;
+    job->done = false;
+    job->error = false;
+    input_ = p;
+    ++submitted_;
+
+    MutexLock lock(&mutex_);
+    queue_.push_back(job);
+    work_ready_.Signal();
+  }
+}
+
+size_t BgzfReader::Read(char* buffer, size_t size) {
+  size_t total = 0;
+  while (total < size && !error_) {
+    SubmitJobs();
+    if (consumed_ == submitted_) {
+      // Everything has been read, or the next block header is corrupt.
+      error_ = input_error_;
+      break;
+    }
+    Job* job = &jobs_[consumed_ % jobs_.size()];
+    {
+      MutexLock lock(&mutex_);
+      while (!job->done) {
+        job_done_.Wait(&mutex_);
+      }
+    }
+    if (job->error) {
+      error_ = true;
+      break;
+    }
+    size_t available = job->output_size - job->consumed;
+    size_t count = (size - total < available) ? size - total : available;
+    // A job of empty blocks, such as the end-of-file marker, may have no
+    // output buffer at all.
+    if (count > 0) {
+      memcpy(buffer + total, job->output + job->consumed, count);
+    }
+    job->consumed += count;
+    total += count;
+    if (job->consumed == job->output_size) {
+      ++consumed_;
+    }
+  }
+  return total;
+}
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
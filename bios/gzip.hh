@@ -0,0 +1,199 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file gzip.hh
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// In-process decompression of gzip input using zlib. Files made of several
+/// concatenated gzip members, which includes BGZF files, are decompressed as
+/// one stream. BGZF files can also be decompressed in parallel, since each of
+/// their blocks is an independent deflate stream of at most 64 KB.
+
+#ifndef BIOS_GZIP_H__
+#define BIOS_GZIP_H__
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+#include <zlib.h>
+
+#include "thread.hh"
+
+namespace bios {
+
+/// @class GzipReader
+/// @brief Decompresses gzip data from memory or from a file descriptor.
+class GzipReader {
+ public:
+  GzipReader();
+  ~GzipReader();
+
+  /// @brief Decompresses the gzip data in the given buffer.
+  ///
+  /// The buffer is not copied and must outlive the reader.
+  ///
+  /// @param     data       The compressed data.
+  /// @param     size       The size of the compressed data.
+  ///
+  /// @return    true on success, false if zlib could not be initialized.
+  bool Open(const char* data, size_t size);
+
+  /// @brief Decompresses the gzip data read from the file descriptor.
+  ///
+  /// The descriptor is not closed by the reader.
+  ///
+  /// @param     fd         The file descriptor to read from.
+  ///
+  /// @return    true on success, false if zlib could not be initialized.
+  bool Open(int fd);
+
+  /// @brief Reads decompressed data.
+  ///
+  /// @param     buffer     The buffer to decompress into.
+  /// @param     size       The size of the buffer.
+  ///
+  /// @return    The number of bytes decompressed, or 0 at the end of the
+  ///            input or on error.
+  size_t Read(char* buffer, size_t size);
+
+  /// @brief Returns whether corrupt input was encountered.
+  bool error() const { return error_; }
+
+  /// @brief Returns whether the buffer starts with the gzip magic bytes.
+  static bool IsGzip(const char* data, size_t size);
+
+ private:
+  bool Init();
+  bool FillInput();
+
+ private:
+  enum {
+    kInputBufferSize = 1 << 17,
+    // zlib counts input in 32-bit integers, so large mappings are handed to
+    // it in pieces of this size.
+    kMaxInputChunk = 1 << 30
+  };
+
+  z_stream stream_;
+  bool initialized_;
+  bool done_;
+  bool error_;
+
+  // Input from memory.
+  const char* input_;
+  const char* input_end_;
+
+  // Input from a file descriptor.
+  int fd_;
+  unsigned char* input_buffer_;
+};
+
+/// @class BgzfReader
+/// @brief Decompresses an in-memory BGZF file using a pool of worker threads.
+///
+/// Runs of consecutive blocks are inflated by the workers as independent
+/// jobs, and Read() returns their output in file order. While the caller
+/// consumes one job, the workers decompress the jobs that follow it.
+class BgzfReader {
+ public:
+  enum {
+    // Workers started when no count is given. Each one keeps two jobs of
+    // about 1 MB of output, so one per processor on a large machine would
+    // hold far more memory than a line stream needs to keep up.
+    kDefaultMaxThreads = 4
+  };
+
+  /// @brief Class constructor.
+  ///
+  /// @param     num_threads  The number of worker threads, or 0 to use one
+  ///                         per processor, up to kDefaultMaxThreads.
+  BgzfReader(int num_threads);
+  ~BgzfReader();
+
+  /// @brief Starts decompressing the BGZF data in the given buffer.
+  ///
+  /// The buffer is not copied and must outlive the reader.
+  ///
+  /// @param     data       The compressed data.
+  /// @param     size       The size of the compressed data.
+  ///
+  /// @return    true if the worker threads were started, false otherwise.
+  bool Open(const char* data, size_t size);
+
+  /// @brief Reads decompressed data.
+  ///
+  /// @param     buffer     The buffer to copy decompressed data into.
+  /// @param     size       The size of the buffer.
+  ///
+  /// @return    The number of bytes copied, or 0 at the end of the input or
+  ///            on error.
+  size_t Read(char* buffer, size_t size);
+
+  /// @brief Returns whether corrupt input was encountered.
+  bool error() const { return error_; }
+
+  /// @brief Returns whether the buffer starts with a BGZF block header.
+  static bool IsBgzf(const char* data, size_t size);
+
+ private:
+  friend class BgzfWorker;
+
+  struct Job {
+    const unsigned char* input;
+    size_t input_size;
+    char* output;
+    size_t output_capacity;
+    size_t output_size;
+    size_t consumed;
+    bool done;
+    bool error;
+  };
+
+  void SubmitJobs();
+  static bool Inflate(Job* job, z_stream* stream);
+
+ private:
+  enum {
+    // Consecutive blocks are grouped into jobs of about this much output so
+    // that locking and signalling costs are spread over many blocks.
+    kJobOutputSize = 1 << 20,
+    kJobsPerThread = 2
+  };
+
+  int num_threads_;
+  std::vector<Thread*> workers_;
+  std::vector<Job> jobs_;
+  size_t submitted_;
+  size_t consumed_;
+  const unsigned char* input_;
+  const unsigned char* input_end_;
+  bool input_error_;
+  bool error_;
+
+  Mutex mutex_;
+  CondVar work_ready_;
+  CondVar job_done_;
+  std::deque<Job*> queue_;
+  bool shutdown_;
+};
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
+#endif /* BIOS_GZIP_H__ */
@@ -23,17 +23,21 @@
 /// Module to efficiently find intervals that overlap with a query interval.
 
 #include "interval.hh"
+#include "writer.hh"
 
 namespace bios {
 
-Interval::Interval() {
+Interval::Interval()
+    : chromosome_id(SymbolTable::kEmptySymbol) {
 }
 
-Interval::Interval(std::string& line, int source)
+Interval::Interval(std::string& line, int source, SymbolCache* symbols)
     : source(source) {
   WordIter w(line, "\t", false);
   name = w.Next();
-  chromosome = w.Next();
+  const char* chromosome = w.Next();
+  chromosome_id = symbols != NULL ? symbols->Intern(chromosome)
+                                  : SymbolTable::Global()->Intern(chromosome);
   strand = w.Next()[0];
   start = atoi(w.Next());
   end = atoi(w.Next());
@@ -64,7 +68,7 @@ Interval::~Interval() {
 std::string Interval::ToString() {
   std::stringstream string_buffer;
   string_buffer << name << "\t";
-  string_buffer << chromosome << "\t";
+  string_buffer << chromosome() << "\t";
   string_buffer << strand << "\t";
   string_buffer << start << "\t";
   string_buffer << end << "\t";
@@ -80,6 +84,30 @@ std::string Interval::ToString() {
   return string_buffer.str();
 }
 
+void Interval::AppendTo(RecordWriter* writer) {
+  writer->Append(name);
+  writer->AppendChar('\t');
+  writer->Append(chromosome());
+  writer->AppendChar('\t');
+  writer->AppendChar(strand);
+  writer->AppendChar('\t');
+  writer->AppendInt(start);
+  writer->AppendChar('\t');
+  writer->AppendInt(end);
+  writer->AppendChar('\t');
+  writer->AppendInt(sub_interval_count);
+  writer->AppendChar('\t');
+  for (uint32_t i = 0; i < sub_intervals.size(); ++i) {
+    writer->AppendInt(sub_intervals[i].start);
+    writer->AppendChar((i < sub_intervals.size() - 1) ? ',' : '\t');
+  }
+  for (uint32_t i = 0; i < sub_intervals.size(); ++i) {
+    writer->AppendInt(sub_intervals[i].end);
+    writer->AppendChar((i < sub_intervals.size() - 1) ? ',' : '\t');
+  }
+  writer->AppendChar('\n');
+}
+
 uint32_t Interval::GetSize() {
   uint32_t size = 0;
   for (std::vector<SubInterval>::iterator it = sub_intervals.begin();
@@ -130,11 +158,12 @@ void IntervalFind::ProcessCommaSeparatedList(std::vector<int>& results,
 void IntervalFind::ParseFileContent(std::vector<Interval>& intervals,
                                     const char* filename, int source) {
   FileLineStream ls(filename);
+  SymbolCache symbols;
   for (std::string line; ls.GetLine(line); ) {
     if (line.empty()) {
       continue;
     }
-    Interval interval(line, source);
+    Interval interval(line, source, &symbols);
     intervals.push_back(interval);
   }
 }
@@ -160,14 +189,14 @@ void IntervalFind::AssignSuperIntervals() {
   while (i < intervals_.size()) {
     Interval& interval = intervals_[i];
     SuperInterval super_interval;
-    super_interval.chromosome = interval.chromosome;
+    super_interval.chromosome_id = interval.chromosome_id;
     super_interval.start = interval.start;
     super_interval.end = interval.end;
     super_interval.sublist.push_back(&interval);
     uint32_t j = i + 1;
     while (j < intervals_.size()) {
       Interval& next_interval = intervals_[j];
-      if (interval.chromosome == next_interval.chromosome &&
+      if (interval.chromosome_id == next_interval.chromosome_id &&
           interval.start <= next_interval.start &&
           interval.end >= next_interval.end) {
         super_interval.sublist.push_back(&next_interval);
@@ -204,8 +233,13 @@ std::vector<Interval*> IntervalFind::GetOverlappingIntervals(
      AssignSuperIntervals();
   }
   std::vector<Interval*> matching_intervals;
+  uint32_t chromosome_id;
+  if (!SymbolTable::Global()->Find(chromosome, &chromosome_id)) {
+    // No interval has ever been on this chromosome.
+    return matching_intervals;
+  }
   SuperInterval test_super_interval;
-  test_super_interval.chromosome = chromosome;
+  test_super_interval.chromosome_id = chromosome_id;
   test_super_interval.start = start;
   test_super_interval.end = end;
   std::vector<SuperInterval>::iterator it = std::find(
@@ -215,7 +249,7 @@ std::vector<Interval*> IntervalFind::GetOverlappingIntervals(
   int32_t i = index;
   while (i >= 0) {
     SuperInterval& super_interval = super_intervals_[i];
-    if (super_interval.chromosome != chromosome ||
+    if (super_interval.chromosome_id != chromosome_id ||
         super_interval.end < start) {
       break;
     }
@@ -225,7 +259,7 @@ std::vector<Interval*> IntervalFind::GetOverlappingIntervals(
   i = index + 1;
   while (i < super_intervals_.size()) {
     SuperInterval& super_interval = super_intervals_[i];
-    if (super_interval.chromosome != chromosome ||
+    if (super_interval.chromosome_id != chromosome_id ||
         super_interval.start > end) {
       break;
     }
@@ -71,9 +71,12 @@
 #include "linestream.hh"
 #include "worditer.hh"
 #include "number.hh"
+#include "symbol.hh"
 
 namespace bios {
 
+class RecordWriter;
+
 /// @struct SubInterval
 /// @brief Structure representing a subinterval.
 struct SubInterval {
@@ -93,8 +96,10 @@ struct Interval {
   /// @param[in] line Line in Interval format\n
   /// @param[in] source An integer that specifies the source. This is useful when
   ///            multiple files are used.
+  /// @param[in] symbols Cache to intern the chromosome through, or NULL to
+  ///            intern it directly in the global table.
   /// See IntervalFind::addIntervalsToSearchSpace() for details.
-  Interval(std::string& line, int source);
+  Interval(std::string& line, int source, SymbolCache* symbols = NULL);
   ~Interval();
 
   /// @brief Write an Interval to a string.
@@ -103,14 +108,25 @@ struct Interval {
   /// @return A char* representing the Interval in tab-delimited format
   std::string ToString();
 
+  /// @brief Write an Interval in the same format as ToString(), followed by
+  ///        a newline.
+  ///
+  /// @param[in] writer The writer to append to.
+  void AppendTo(RecordWriter* writer);
+
   /// Get size of an Interval. This is done by summing up the size of the
   /// subIntervals
   /// @param[in] currInterval Pointer to an Interval
   /// @return An integer representing the size
   uint32_t GetSize();
 
+  const std::string& chromosome() const {
+    return SymbolTable::Global()->Name(chromosome_id);
+  }
+
   static bool Compare(const Interval& a, const Interval& b) {
-    int diff = strcmp(a.chromosome.c_str(), b.chromosome.c_str());
+    int diff = SymbolTable::Global()->Compare(a.chromosome_id,
+                                              b.chromosome_id);
     if (diff != 0) {
       return diff < 0;
     }
@@ -122,7 +138,7 @@ struct Interval {
 
   int source;
   std::string name;
-  std::string chromosome;
+  uint32_t chromosome_id;
   char strand;
   int start;
   int end;
@@ -133,11 +149,12 @@ struct Interval {
 /// @struct SuperInterval
 /// @brief Structure representing a superinterval.
 struct SuperInterval {
-  SuperInterval() {}
+  SuperInterval() : chromosome_id(SymbolTable::kEmptySymbol) {}
   ~SuperInterval() {}
 
   static bool Compare(const SuperInterval& a, const SuperInterval& b) {
-    int diff = strcmp(a.chromosome.c_str(), b.chromosome.c_str());
+    int diff = SymbolTable::Global()->Compare(a.chromosome_id,
+                                              b.chromosome_id);
     if (diff != 0) {
       return diff < 0;
     }
@@ -148,12 +165,12 @@ struct SuperInterval {
   }
 
   bool operator==(const SuperInterval& other) {
-    return (strcmp(chromosome.c_str(), other.chromosome.c_str()) == 0 &&
+    return (chromosome_id == other.chromosome_id &&
         start == other.start &&
         end == other.end);
   }
 
-  std::string chromosome;
+  uint32_t chromosome_id;
   int start;
   int end;
   std::vector<Interval*> sublist;
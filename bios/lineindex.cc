@@ -0,0 +1,231 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file lineindex.cc
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// Line-offset index for random access into uncompressed text files.
+
+#include "lineindex.hh"
+#include "gzip.hh"
+#include "scan.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace bios {
+
+static const char kIndexMagic[8] = { 'B', 'I', 'O', 'S', 'L', 'I', 'X', '1' };
+
+struct IndexHeader {
+  char magic[8];
+  uint64_t file_size;
+  int64_t file_mtime;
+  uint64_t num_lines;
+};
+
+// Returns the size and modification time of a regular file.
+static bool StatFile(const char* filename, uint64_t* size, int64_t* mtime) {
+  struct stat st;
+  if (stat(filename, &st) != 0 || !S_ISREG(st.st_mode)) {
+    return false;
+  }
+  *size = st.st_size;
+  *mtime = st.st_mtime;
+  return true;
+}
+
+LineIndex::LineIndex()
+    : file_size_(0),
+      file_mtime_(0),
+      num_lines_(0),
+      offsets_(NULL),
+      map_(NULL),
+      map_size_(0) {
+}
+
+LineIndex::~LineIndex() {
+  Clear();
+}
+
+void LineIndex::Clear() {
+  if (map_ != NULL) {
+    munmap(map_, map_size_);
+    map_ = NULL;
+    map_size_ = 0;
+  }
+  built_offsets_.clear();
+  offsets_ = NULL;
+  num_lines_ = 0;
+  file_size_ = 0;
+  file_mtime_ = 0;
+}
+
+std::string LineIndex::SidecarName(const char* filename) {
+  return std::string(filename) + ".lidx";
+}
+
+bool LineIndex::Open(const char* filename) {
+  if (filename == NULL) {
+    return false;
+  }
+  std::string index_filename = SidecarName(filename);
+  if (Load(filename, index_filename.c_str())) {
+    return true;
+  }
+  if (!Build(filename)) {
+    return false;
+  }
+  Save(index_filename.c_str());
+  return true;
+}
+
+bool LineIndex::Build(const char* filename) {
+  Clear();
+  if (filename == NULL) {
+    return false;
+  }
+  int fd = open(filename, O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+    close(fd);
+    return false;
+  }
+  size_t size = st.st_size;
+  const char* data = NULL;
+  void* map = NULL;
+  if (size > 0) {
+    map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED) {
+      close(fd);
+      return false;
+    }
+    madvise(map, size, MADV_SEQUENTIAL);
+    data = static_cast<const char*>(map);
+  }
+  close(fd);
+  if (GzipReader::IsGzip(data, size)) {
+    munmap(map, size);
+    return false;
+  }
+
+  const char* end = data + size;
+  for (const char* line = data; line < end; ) {
+    built_offsets_.push_back(line - data);
+    const char* newline = scan::find_newline(line, end);
+    line = newline == end ? end : newline + 1;
+  }
+  if (map != NULL) {
+    munmap(map, size);
+  }
+  file_size_ = size;
+  file_mtime_ = st.st_mtime;
+  num_lines_ = built_offsets_.size();
+  offsets_ = built_offsets_.empty() ? NULL : &built_offsets_[0];
+  return true;
+}
+
+bool LineIndex::Load(const char* filename, const char* index_filename) {
+  Clear();
+  uint64_t file_size;
+  int64_t file_mtime;
+  if (filename == NULL || index_filename == NULL ||
+      !StatFile(filename, &file_size, &file_mtime)) {
+    return false;
+  }
+  int fd = open(index_filename, O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 ||
+      static_cast<size_t>(st.st_size) < sizeof(IndexHeader)) {
+    close(fd);
+    return false;
+  }
+  size_t size = st.st_size;
+  void* map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) {
+    return false;
+  }
+  const IndexHeader* header = static_cast<const IndexHeader*>(map);
+  if (memcmp(header->magic, kIndexMagic, sizeof(kIndexMagic)) != 0 ||
+      header->file_size != file_size ||
+      header->file_mtime != file_mtime ||
+      header->num_lines != (size - sizeof(IndexHeader)) / sizeof(uint64_t)) {
+    munmap(map, size);
+    return false;
+  }
+  map_ = map;
+  map_size_ = size;
+  file_size_ = file_size;
+  file_mtime_ = file_mtime;
+  num_lines_ = header->num_lines;
+  offsets_ = reinterpret_cast<const uint64_t*>(header + 1);
+  return true;
+}
+
+bool LineIndex::Save(const char* index_filename) const {
+  if (index_filename == NULL) {
+    return false;
+  }
+  // Write to a temporary file and rename it, so that readers never see a
+  // partially written index.
+  std::string temp_filename = std::string(index_filename) + ".tmp";
+  FILE* fp = fopen(temp_filename.c_str(), "wb");
+  if (fp == NULL) {
+    return false;
+  }
+  IndexHeader header;
+  memcpy(header.magic, kIndexMagic, sizeof(kIndexMagic));
+  header.file_size = file_size_;
+  header.file_mtime = file_mtime_;
+  header.num_lines = num_lines_;
+  bool ok = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+      fwrite(offsets_, sizeof(uint64_t), num_lines_, fp) == num_lines_;
+  ok = fclose(fp) == 0 && ok;
+  if (!ok || rename(temp_filename.c_str(), index_filename) != 0) {
+    unlink(temp_filename.c_str());
+    return false;
+  }
+  return true;
+}
+
+uint64_t LineIndex::LineAtOffset(uint64_t offset) const {
+  if (offset >= file_size_) {
+    return num_lines_;
+  }
+  // The last line starting at or before offset.
+  const uint64_t* line = std::upper_bound(offsets_, offsets_ + num_lines_,
+                                          offset);
+  return line - offsets_ - 1;
+}
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
@@ -0,0 +1,106 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file lineindex.hh
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// Line-offset index for random access into uncompressed text files. The
+/// index records the byte offset of every line and is saved in a sidecar
+/// file next to the text file, so it only has to be built once.
+
+#ifndef BIOS_LINEINDEX_H__
+#define BIOS_LINEINDEX_H__
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace bios {
+
+/// @class LineIndex
+/// @brief Byte offsets of the lines of a text file.
+///
+/// The sidecar file holds a small header identifying the indexed file by size
+/// and modification time, followed by one 64-bit offset per line in host
+/// byte order. Loaded indexes are memory-mapped, so opening the index of a
+/// large file is O(1) as well.
+class LineIndex {
+ public:
+  LineIndex();
+  ~LineIndex();
+
+  /// @brief Loads the sidecar index of a file, building and saving it first
+  ///        if it is missing or out of date.
+  ///
+  /// Failing to write the sidecar, e.g. in a read-only directory, is not an
+  /// error; the index built in memory is used.
+  ///
+  /// @param     filename  The name of the text file.
+  /// @return    true on success, false if the file cannot be indexed.
+  bool Open(const char* filename);
+
+  /// @brief Builds the index by scanning a file.
+  ///
+  /// @return    false if the file cannot be read or is gzip-compressed.
+  bool Build(const char* filename);
+
+  /// @brief Loads an index from index_filename. Fails if the index does not
+  ///        match the current size and modification time of filename.
+  bool Load(const char* filename, const char* index_filename);
+
+  /// @brief Writes the index to index_filename.
+  bool Save(const char* index_filename) const;
+
+  /// @brief Returns the name of the sidecar index of a file.
+  static std::string SidecarName(const char* filename);
+
+  /// @brief Returns the number of lines in the indexed file.
+  uint64_t num_lines() const { return num_lines_; }
+
+  /// @brief Returns the size in bytes of the indexed file.
+  uint64_t file_size() const { return file_size_; }
+
+  /// @brief Returns the byte offset of the start of line number line,
+  ///        counting from 0.
+  uint64_t LineOffset(uint64_t line) const { return offsets_[line]; }
+
+  /// @brief Returns the number of the line containing byte offset, or
+  ///        num_lines() if offset is past the last line.
+  uint64_t LineAtOffset(uint64_t offset) const;
+
+ private:
+  void Clear();
+
+  uint64_t file_size_;
+  int64_t file_mtime_;
+  uint64_t num_lines_;
+  const uint64_t* offsets_;
+  std::vector<uint64_t> built_offsets_;
+  void* map_;
+  size_t map_size_;
+
+  LineIndex(const LineIndex&);
+  void operator=(const LineIndex&);
+};
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
+#endif /* BIOS_LINEINDEX_H__ */
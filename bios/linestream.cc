@@ -25,9 +25,170 @@
 /// linestream module.
 
 #include "linestream.hh"
+#include "gzip.hh"
+#include "lineindex.hh"
+#include "thread.hh"
+#include "uring.hh"
+
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <vector>
+
+extern char** environ;
 
 namespace bios {
 
+//-----------------------------------------------------------------------------
+// Prefetcher methods
+//-----------------------------------------------------------------------------
+
+/// @class Prefetcher
+/// @brief Producer thread that fills a ring of buffers with LineStream input.
+///
+/// Each buffer is filled starting kPrefetchHeadroom bytes in. Buffers cycle
+/// between the free queue, which the thread reads into, and the filled queue,
+/// which the line stream takes from. The line stream gives a buffer back
+/// once it has split all lines out of it.
+class Prefetcher : public Thread {
+ public:
+  Prefetcher(LineStream* stream, int num_buffers)
+      : stream_(stream),
+        stop_(false),
+        producer_done_(false) {
+    memset(&stats_, 0, sizeof(stats_));
+    for (int i = 0; i < num_buffers; ++i) {
+      Buffer buffer;
+      buffer.capacity = LineStream::kPrefetchHeadroom + LineStream::kBlockSize;
+      buffer.data = static_cast<char*>(malloc(buffer.capacity));
+      buffer.size = 0;
+      free_.push_back(buffer);
+    }
+  }
+
+  ~Prefetcher() {
+    Stop();
+    for (size_t i = 0; i < free_.size(); ++i) {
+      free(free_[i].data);
+    }
+    for (size_t i = 0; i < filled_.size(); ++i) {
+      free(filled_[i].data);
+    }
+  }
+
+  void Stop() {
+    {
+      MutexLock lock(&mutex_);
+      stop_ = true;
+      free_ready_.Signal();
+    }
+    Join();
+  }
+
+  /// Takes the next filled buffer, waiting for the thread if none is ready.
+  /// A buffer with size 0 marks the end of the input.
+  void Take(char** data, size_t* capacity, size_t* size) {
+    MutexLock lock(&mutex_);
+    if (filled_.empty() && !producer_done_) {
+      ++stats_.stalls;
+      struct timespec start;
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      while (filled_.empty() && !producer_done_) {
+        filled_ready_.Wait(&mutex_);
+      }
+      struct timespec end;
+      clock_gettime(CLOCK_MONOTONIC, &end);
+      stats_.stall_usecs += (end.tv_sec - start.tv_sec) * 1000000 +
+          (end.tv_nsec - start.tv_nsec) / 1000;
+    }
+    if (filled_.empty()) {
+      *data = NULL;
+      *capacity = 0;
+      *size = 0;
+      return;
+    }
+    Buffer buffer = filled_.front();
+    filled_.pop_front();
+    *data = buffer.data;
+    *capacity = buffer.capacity;
+    *size = buffer.size;
+    if (buffer.size > 0) {
+      ++stats_.blocks;
+    }
+  }
+
+  /// Gives a buffer back to the thread to read into.
+  void Release(char* data, size_t capacity) {
+    if (data == NULL) {
+      return;
+    }
+    Buffer buffer;
+    buffer.data = data;
+    buffer.capacity = capacity;
+    buffer.size = 0;
+    MutexLock lock(&mutex_);
+    free_.push_back(buffer);
+    free_ready_.Signal();
+  }
+
+  LineStream::PrefetchStats stats() {
+    MutexLock lock(&mutex_);
+    return stats_;
+  }
+
+ protected:
+  void Run() {
+    for (;;) {
+      Buffer buffer;
+      {
+        MutexLock lock(&mutex_);
+        while (free_.empty() && !stop_) {
+          free_ready_.Wait(&mutex_);
+        }
+        if (stop_) {
+          return;
+        }
+        buffer = free_.front();
+        free_.pop_front();
+      }
+      buffer.size = stream_->ReadBlock(
+          buffer.data + LineStream::kPrefetchHeadroom,
+          buffer.capacity - LineStream::kPrefetchHeadroom);
+      MutexLock lock(&mutex_);
+      filled_.push_back(buffer);
+      if (buffer.size == 0) {
+        producer_done_ = true;
+      }
+      filled_ready_.Signal();
+      if (producer_done_) {
+        return;
+      }
+    }
+  }
+
+ private:
+  struct Buffer {
+    char* data;
+    size_t capacity;
+    size_t size;
+  };
+
+  LineStream* stream_;
+  Mutex mutex_;
+  CondVar free_ready_;
+  CondVar filled_ready_;
+  std::deque<Buffer> free_;
+  std::deque<Buffer> filled_;
+  bool stop_;
+  bool producer_done_;
+  LineStream::PrefetchStats stats_;
+};
+
 //-----------------------------------------------------------------------------
 // LineStream methods
 //-----------------------------------------------------------------------------
@@ -35,25 +196,226 @@ namespace bios {
 LineStream::LineStream()
     : count_(0),
       status_(0),
-      buffer_size_(0) {
+      buffer_size_(0),
+      block_(NULL),
+      block_capacity_(0),
+      cursor_(NULL),
+      scan_(NULL),
+      limit_(NULL),
+      input_done_(false),
+      prefetcher_(NULL) {
   buffer_ = std::deque<std::string>();
 }
 
 LineStream::~LineStream() {
+  StopPrefetch();
+  delete prefetcher_;
+  free(block_);
+}
+
+bool LineStream::EnablePrefetch(int num_buffers) {
+  if (prefetcher_ != NULL || input_done_ || block_ != NULL) {
+    return false;
+  }
+  prefetcher_ = new Prefetcher(this, num_buffers < 2 ? 2 : num_buffers);
+  if (!prefetcher_->Start()) {
+    delete prefetcher_;
+    prefetcher_ = NULL;
+    return false;
+  }
+  return true;
+}
+
+void LineStream::StopPrefetch() {
+  if (prefetcher_ != NULL) {
+    prefetcher_->Stop();
+  }
+}
+
+LineStream::PrefetchStats LineStream::GetPrefetchStats() const {
+  if (prefetcher_ == NULL) {
+    PrefetchStats stats;
+    memset(&stats, 0, sizeof(stats));
+    return stats;
+  }
+  return prefetcher_->stats();
+}
+
+size_t LineStream::ReadBlock(char* buffer, size_t size) {
+  return 0;
+}
+
+void LineStream::SetBlock(const char* data, size_t size) {
+  cursor_ = scan_ = data;
+  limit_ = data + size;
+  input_done_ = true;
+}
+
+// Moves the unconsumed tail of the block to the front of the block buffer,
+// growing the buffer if a single line fills all of it, and reads more input
+// behind it.
+void LineStream::Refill() {
+  if (prefetcher_ != NULL) {
+    RefillFromPrefetcher();
+    return;
+  }
+  size_t pending = limit_ - cursor_;
+  size_t scanned = scan_ - cursor_;
+  if (block_ == NULL) {
+    block_capacity_ = kBlockSize;
+    block_ = static_cast<char*>(malloc(block_capacity_));
+  } else if (pending == block_capacity_) {
+    char* grown = static_cast<char*>(malloc(block_capacity_ * 2));
+    memcpy(grown, cursor_, pending);
+    free(block_);
+    block_ = grown;
+    block_capacity_ *= 2;
+  } else if (pending > 0 && cursor_ != block_) {
+    memmove(block_, cursor_, pending);
+  }
+  cursor_ = block_;
+  scan_ = block_ + scanned;
+  limit_ = block_ + pending;
+
+  size_t bytes_read = ReadBlock(block_ + pending, block_capacity_ - pending);
+  if (bytes_read == 0) {
+    input_done_ = true;
+  }
+  limit_ += bytes_read;
+}
+
+// Continues with the next buffer filled by the read-ahead thread. The
+// unfinished line at the end of the current block is copied into the
+// headroom in front of the new data, and the current block is given back to
+// the thread. Lines that do not fit in the headroom are appended to in the
+// current block instead.
+void LineStream::RefillFromPrefetcher() {
+  size_t pending = limit_ - cursor_;
+  size_t scanned = scan_ - cursor_;
+  char* data;
+  size_t capacity;
+  size_t size;
+  prefetcher_->Take(&data, &capacity, &size);
+  if (size == 0) {
+    prefetcher_->Release(data, capacity);
+    input_done_ = true;
+    return;
+  }
+
+  char* start;
+  if (pending <= kPrefetchHeadroom) {
+    start = data + kPrefetchHeadroom - pending;
+    if (pending > 0) {
+      memcpy(start, cursor_, pending);
+    }
+    prefetcher_->Release(block_, block_capacity_);
+    block_ = data;
+    block_capacity_ = capacity;
+  } else {
+    if (pending + size > block_capacity_) {
+      size_t grown_capacity = block_capacity_ * 2;
+      while (grown_capacity < pending + size) {
+        grown_capacity *= 2;
+      }
+      char* grown = static_cast<char*>(malloc(grown_capacity));
+      memcpy(grown, cursor_, pending);
+      free(block_);
+      block_ = grown;
+      block_capacity_ = grown_capacity;
+    } else {
+      memmove(block_, cursor_, pending);
+    }
+    memcpy(block_ + pending, data + kPrefetchHeadroom, size);
+    prefetcher_->Release(data, capacity);
+    start = block_;
+  }
+  cursor_ = start;
+  scan_ = start + scanned;
+  limit_ = start + pending + size;
+}
+
+// Splits the next line out of the current block without reading more input.
+// Returns false if the block holds no complete line; at the end of the input
+// the remaining bytes form the last line.
+bool LineStream::SplitLine(StringPiece* line) {
+  const char* newline = scan::find_newline(scan_, limit_);
+  const char* line_end = NULL;
+  if (newline != limit_) {
+    line_end = newline;
+    scan_ = newline + 1;
+  } else {
+    // Remember that the tail has been scanned so it is not scanned again.
+    scan_ = limit_;
+    if (!input_done_ || cursor_ >= limit_) {
+      return false;
+    }
+    // Last line without a trailing newline.
+    line_end = limit_;
+  }
+  size_t length = line_end - cursor_;
+  if (length > 0 && line_end[-1] == '\r') {
+    --length;
+  }
+  line->set(cursor_, length);
+  cursor_ = scan_;
+  ++count_;
+  return true;
+}
+
+bool LineStream::GetNextLine(StringPiece* line) {
+  while (!SplitLine(line)) {
+    if (input_done_) {
+      return false;
+    }
+    Refill();
+  }
+  return true;
 }
 
-bool LineStream::GetNextLine(std::string& line) {
-  return false;
+size_t LineStream::GetLines(std::vector<StringPiece>* lines,
+                            size_t max_lines) {
+  lines->clear();
+  // Pushed back lines come first. They are moved to back_lines_, which keeps
+  // them alive until the next call, as back_line_ does for GetLine().
+  back_lines_.clear();
+  while (lines->size() < max_lines && !buffer_.empty()) {
+    back_lines_.push_back(std::string());
+    back_lines_.back().swap(buffer_.front());
+    buffer_.pop_front();
+    lines->push_back(StringPiece(back_lines_.back()));
+  }
+  StringPiece line;
+  while (lines->size() < max_lines) {
+    if (SplitLine(&line)) {
+      lines->push_back(line);
+    } else if (input_done_ || !lines->empty()) {
+      // Refilling would move the block under the views already returned.
+      break;
+    } else {
+      Refill();
+    }
+  }
+  return lines->size();
 }
 
 bool LineStream::IsEof() const {
-  return false;
+  return buffer_.empty() && AtEndOfInput();
 }
 
 bool LineStream::GetLine(std::string& line) {
+  StringPiece piece;
+  if (!GetLine(&piece)) {
+    return false;
+  }
+  piece.CopyToString(&line);
+  return true;
+}
+
+bool LineStream::GetLine(StringPiece* line) {
   if (buffer_size_ > 0 && buffer_.size() > 0) {
-    line = buffer_.front();
+    back_line_.swap(buffer_.front());
     buffer_.pop_front();
+    line->set(back_line_.data(), back_line_.size());
     return true;
   }
   return GetNextLine(line);
@@ -67,6 +429,13 @@ void LineStream::Back(std::string& str) {
   buffer_.push_front(str);
 }
 
+void LineStream::Back(const StringPiece& line) {
+  if (buffer_.size() >= buffer_size_) {
+    return;
+  }
+  buffer_.push_front(line.ToString());
+}
+
 void LineStream::SetBuffer(int line_count) {
   buffer_size_ = line_count;
 }
@@ -79,48 +448,224 @@ int LineStream::GetLineCount() {
 // FileLineStream methods
 //-----------------------------------------------------------------------------
 
-struct noop {
-  void operator()(...) const { }
-};
-
-FileLineStream::FileLineStream(const char* filename)
+FileLineStream::FileLineStream(const char* filename, ReadMode mode,
+                               int bgzf_threads)
     : LineStream(),
-      stream_(NULL),
-      file_(NULL) {
+      fd_(-1),
+      owns_fd_(false),
+      mapped_(false),
+      map_(NULL),
+      map_size_(0),
+      gzip_(NULL),
+      bgzf_(NULL),
+      uring_(NULL) {
   if (filename == NULL) {
+    SetBlock(NULL, 0);
     return;
   }
   if (strcmp(filename, "-") == 0) {
-    stream_ = &std::cin;
-  } else {
-    file_ = new std::ifstream(filename);
-    stream_ = file_;
+    fd_ = STDIN_FILENO;
+    return;
+  }
+  fd_ = open(filename, O_RDONLY);
+  if (fd_ < 0) {
+    SetBlock(NULL, 0);
+    return;
+  }
+  owns_fd_ = true;
+  if (mode == kReadPlain) {
+    return;
+  }
+  if (mode == kReadUring) {
+    // Compressed files are left to the mapping path, which decompresses them.
+    char magic[2];
+    if (pread(fd_, magic, sizeof(magic), 0) != sizeof(magic) ||
+        !GzipReader::IsGzip(magic, sizeof(magic))) {
+      uring_ = new UringReader;
+      if (uring_->Open(fd_)) {
+        return;
+      }
+      delete uring_;
+      uring_ = NULL;
+    }
+  }
+  if (Map(fd_)) {
+    // The mapping stays valid after the descriptor is closed.
+    close(fd_);
+    fd_ = -1;
+    owns_fd_ = false;
+    if (BgzfReader::IsBgzf(map_, map_size_)) {
+      bgzf_ = new BgzfReader(bgzf_threads);
+      if (!bgzf_->Open(map_, map_size_)) {
+        delete bgzf_;
+        bgzf_ = NULL;
+      }
+    }
+    if (bgzf_ == NULL && GzipReader::IsGzip(map_, map_size_)) {
+      gzip_ = new GzipReader;
+      gzip_->Open(map_, map_size_);
+    } else if (bgzf_ == NULL) {
+      SetBlock(map_, map_size_);
+    }
   }
 }
 
 FileLineStream::~FileLineStream() {
-  if (file_->is_open()) {
-    file_->close();
-    delete file_;
+  StopPrefetch();
+  delete gzip_;
+  delete bgzf_;
+  delete uring_;
+  if (map_ != NULL) {
+    munmap(map_, map_size_);
+    map_ = NULL;
+  }
+  if (owns_fd_) {
+    close(fd_);
+  }
+}
+
+FileLineStream::ReadMode FileLineStream::read_mode() const {
+  if (uring_ != NULL) {
+    return kReadUring;
   }
+  return mapped_ ? kReadMmap : kReadPlain;
 }
 
-bool FileLineStream::GetNextLine(std::string& line) {
-  if (stream_->eof()) {
+bool FileLineStream::SeekToOffset(uint64_t offset) {
+  if (!mapped_ || IsCompressed() || offset > map_size_) {
     return false;
   }
-  std::getline(*stream_, line);
-  if (line.size() > 1 && line[line.size() - 2] == '\r') {
-    line[line.size() - 2] = '\0';
-  } else if (line.size() > 0 && line[line.size() - 1] == '\n') {
-    line[line.size() - 1] = '\0';
+  buffer_.clear();
+  SetBlock(map_ + offset, map_size_ - offset);
+  return true;
+}
+
+bool FileLineStream::SeekToLine(const LineIndex& index, uint64_t line) {
+  if (index.file_size() != map_size_ || line > index.num_lines()) {
+    return false;
   }
-  ++count_;
+  uint64_t offset = line == index.num_lines() ?
+      map_size_ : index.LineOffset(line);
+  if (!SeekToOffset(offset)) {
+    return false;
+  }
+  count_ = line;
+  return true;
+}
+
+// Maps a regular file into memory. Returns false if the file cannot be
+// mapped, in which case the file is read block by block instead.
+bool FileLineStream::Map(int fd) {
+  struct stat st;
+  if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+    return false;
+  }
+  map_size_ = st.st_size;
+  if (map_size_ > 0) {
+    void* addr = mmap(NULL, map_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+      map_size_ = 0;
+      return false;
+    }
+    map_ = static_cast<char*>(addr);
+    madvise(map_, map_size_, MADV_SEQUENTIAL);
+  }
+  mapped_ = true;
   return true;
 }
 
-bool FileLineStream::IsEof() const {
-  return stream_->eof();
+size_t FileLineStream::ReadBlock(char* buffer, size_t size) {
+  if (bgzf_ != NULL) {
+    size_t bytes_read = bgzf_->Read(buffer, size);
+    if (bytes_read == 0 && bgzf_->error()) {
+      std::cerr << "Corrupt BGZF input" << std::endl;
+    }
+    return bytes_read;
+  }
+  if (gzip_ != NULL) {
+    size_t bytes_read = gzip_->Read(buffer, size);
+    if (bytes_read == 0 && gzip_->error()) {
+      std::cerr << "Corrupt gzip input" << std::endl;
+    }
+    return bytes_read;
+  }
+  if (uring_ != NULL) {
+    size_t bytes_read = uring_->Read(buffer, size);
+    if (bytes_read == 0 && uring_->error()) {
+      std::cerr << "Error reading file" << std::endl;
+    }
+    return bytes_read;
+  }
+  for (;;) {
+    ssize_t bytes_read = read(fd_, buffer, size);
+    if (bytes_read >= 0) {
+      return bytes_read;
+    }
+    if (errno != EINTR) {
+      return 0;
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+// GzipLineStream methods
+//-----------------------------------------------------------------------------
+
+GzipLineStream::GzipLineStream(const char* filename)
+    : LineStream(),
+      fd_(-1),
+      gzip_(NULL) {
+  if (filename == NULL) {
+    SetBlock(NULL, 0);
+    return;
+  }
+  if (strcmp(filename, "-") == 0) {
+    fd_ = STDIN_FILENO;
+  } else {
+    fd_ = open(filename, O_RDONLY);
+    if (fd_ < 0) {
+      SetBlock(NULL, 0);
+      return;
+    }
+  }
+  gzip_ = new GzipReader;
+  gzip_->Open(fd_);
+}
+
+GzipLineStream::~GzipLineStream() {
+  StopPrefetch();
+  delete gzip_;
+  if (fd_ > STDIN_FILENO) {
+    close(fd_);
+  }
+}
+
+size_t GzipLineStream::ReadBlock(char* buffer, size_t size) {
+  if (gzip_ == NULL) {
+    return 0;
+  }
+  size_t bytes_read = gzip_->Read(buffer, size);
+  if (bytes_read == 0 && gzip_->error()) {
+    std::cerr << "Corrupt gzip input" << std::endl;
+  }
+  return bytes_read;
+}
+
+//-----------------------------------------------------------------------------
+// MemoryLineStream methods
+//-----------------------------------------------------------------------------
+
+MemoryLineStream::MemoryLineStream(const char* data, size_t size)
+    : LineStream() {
+  SetBlock(data, data == NULL ? 0 : size);
+}
+
+MemoryLineStream::MemoryLineStream(const StringPiece& buffer)
+    : LineStream() {
+  SetBlock(buffer.data(), buffer.size());
+}
+
+MemoryLineStream::~MemoryLineStream() {
 }
 
 //-----------------------------------------------------------------------------
@@ -130,12 +675,25 @@ bool FileLineStream::IsEof() const {
 // http://stackoverflow.com/questions/1683051/file-and-istream-connect-the-two
 //-----------------------------------------------------------------------------
 
-pipe_streambuf::pipe_streambuf()
-    : fp_(NULL) {
+// Asks the kernel for a pipe as large as our read buffer so that the child
+// can run ahead of the reader without blocking on every 64 KB.
+static void GrowPipe(int fd, size_t size) {
+#ifdef F_SETPIPE_SZ
+  fcntl(fd, F_SETPIPE_SZ, static_cast<int>(size));
+#endif
+}
+
+pipe_streambuf::pipe_streambuf(size_t buffer_size)
+    : fp_(NULL),
+      fd_(-1),
+      pid_(-1),
+      buffer_(NULL),
+      buffer_size_(buffer_size > 0 ? buffer_size : kDefaultBufferSize) {
 }
 
 pipe_streambuf::~pipe_streambuf() {
   close();
+  delete[] buffer_;
 }
 
 pipe_streambuf* pipe_streambuf::open(const char* command, const char* mode) {
@@ -143,10 +701,39 @@ pipe_streambuf* pipe_streambuf::open(const char* command, const char* mode) {
   if (fp_ == NULL) {
     return NULL;
   }
-  buffer_ = new char_type[kBufferSize];
-  if (buffer_ == NULL) {
+  fd_ = fileno(fp_);
+  GrowPipe(fd_, buffer_size_);
+  buffer_ = new char_type[buffer_size_];
+  setg(buffer_, buffer_, buffer_);
+  return this;
+}
+
+pipe_streambuf* pipe_streambuf::spawn(const char* const* argv) {
+  if (argv == NULL || argv[0] == NULL) {
+    return NULL;
+  }
+  int fds[2];
+  if (pipe(fds) != 0) {
     return NULL;
   }
+  fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+  fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+
+  posix_spawn_file_actions_t actions;
+  posix_spawn_file_actions_init(&actions);
+  posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+  int ret = posix_spawnp(&pid_, argv[0], &actions, NULL,
+                         const_cast<char* const*>(argv), environ);
+  posix_spawn_file_actions_destroy(&actions);
+  ::close(fds[1]);
+  if (ret != 0) {
+    ::close(fds[0]);
+    pid_ = -1;
+    return NULL;
+  }
+  fd_ = fds[0];
+  GrowPipe(fd_, buffer_size_);
+  buffer_ = new char_type[buffer_size_];
   setg(buffer_, buffer_, buffer_);
   return this;
 }
@@ -155,6 +742,22 @@ void pipe_streambuf::close() {
   if (fp_ != NULL) {
     pclose(fp_);
     fp_ = NULL;
+  } else if (fd_ >= 0) {
+    ::close(fd_);
+    int status;
+    while (waitpid(pid_, &status, 0) < 0 && errno == EINTR) {
+    }
+    pid_ = -1;
+  }
+  fd_ = -1;
+}
+
+ssize_t pipe_streambuf::ReadFd(char* buffer, size_t size) {
+  for (;;) {
+    ssize_t len = read(fd_, buffer, size);
+    if (len >= 0 || errno != EINTR) {
+      return len;
+    }
   }
 }
 
@@ -167,10 +770,31 @@ std::streamsize pipe_streambuf::xsgetn(char_type* s, std::streamsize n) {
   }
   memcpy(s, gptr(), got * sizeof(char_type));
   gbump(got);
-  if (traits_type::eof() == underflow()) {
-    return got;
+  while (got < n) {
+    if (static_cast<size_t>(n - got) < buffer_size_) {
+      // Small remainder: refill the buffer and copy out of it.
+      if (traits_type::eof() == underflow()) {
+        break;
+      }
+      std::streamsize chunk = showmanyc();
+      if (chunk > n - got) {
+        chunk = n - got;
+      }
+      memcpy(s + got, gptr(), chunk * sizeof(char_type));
+      gbump(chunk);
+      got += chunk;
+    } else {
+      if (fd_ < 0) {
+        break;
+      }
+      ssize_t len = ReadFd(s + got, n - got);
+      if (len <= 0) {
+        break;
+      }
+      got += len;
+    }
   }
-  return got + xsgetn(s + got, n - got);
+  return got;
 }
 
 pipe_streambuf::int_type pipe_streambuf::underflow() {
@@ -180,11 +804,12 @@ pipe_streambuf::int_type pipe_streambuf::underflow() {
   if (gptr() < egptr()) {
     return traits_type::to_int_type(*gptr());
   }
-  size_t len = fread(eback(), sizeof(char_type), kBufferSize, fp_);
-  setg(eback(), eback(), eback() + sizeof(char_type) * len);
-  if (len == 0) {
+  ssize_t len = fd_ < 0 ? 0 : ReadFd(eback(), buffer_size_);
+  if (len <= 0) {
+    setg(eback(), eback(), eback());
     return traits_type::eof();
   }
+  setg(eback(), eback(), eback() + len);
   return traits_type::to_int_type(*gptr());
 }
 
@@ -202,43 +827,59 @@ std::streamsize pipe_streambuf::showmanyc() {
 // PipeLineStream methods
 //-----------------------------------------------------------------------------
 
-PipeLineStream::PipeLineStream(const char* command) : LineStream() {
+PipeLineStream::PipeLineStream(const char* command, bool use_shell)
+    : LineStream(),
+      pipe_(NULL) {
   if (command == NULL) {
     return;
   }
   pipe_ = new pipe_streambuf;
-  pipe_->open(command, "r");
-  stream_ = new std::istream(pipe_);
+  if (use_shell) {
+    pipe_->open(command, "r");
+    return;
+  }
+  std::vector<std::string> words;
+  const char* separators = " \t\n";
+  std::string line(command);
+  for (size_t start = line.find_first_not_of(separators);
+       start != std::string::npos;
+       start = line.find_first_not_of(separators, start)) {
+    size_t end = line.find_first_of(separators, start);
+    words.push_back(line.substr(start, end - start));
+    start = end;
+  }
+  std::vector<const char*> argv;
+  for (size_t i = 0; i < words.size(); ++i) {
+    argv.push_back(words[i].c_str());
+  }
+  argv.push_back(NULL);
+  pipe_->spawn(&argv[0]);
+}
+
+PipeLineStream::PipeLineStream(const char* const* argv)
+    : LineStream(),
+      pipe_(NULL) {
+  if (argv == NULL) {
+    return;
+  }
+  pipe_ = new pipe_streambuf;
+  pipe_->spawn(argv);
 }
 
 PipeLineStream::~PipeLineStream() {
+  StopPrefetch();
   if (pipe_ != NULL) {
     pipe_->close();
     delete pipe_;
     pipe_ = NULL;
   }
-  if (stream_ != NULL) {
-    delete stream_;
-    stream_ = NULL;
-  }
 }
 
-bool PipeLineStream::GetNextLine(std::string& line) {
-  if (stream_->eof()) {
-    return false;
-  }
-  std::getline(*stream_, line);
-  if (line.size() > 1 && line[line.size() - 2] == '\r') {
-    line[line.size() - 2] = '\0';
-  } else if (line.size() > 0 && line[line.size() - 1] == '\n') {
-    line[line.size() - 1] = '\0';
+size_t PipeLineStream::ReadBlock(char* buffer, size_t size) {
+  if (pipe_ == NULL) {
+    return 0;
   }
-  ++count_;
-  return true;
-}
-
-bool PipeLineStream::IsEof() const {
-  return stream_->eof();
+  return pipe_->sgetn(buffer, size);
 }
 
 }; // namespace bios
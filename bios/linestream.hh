@@ -30,13 +30,29 @@
 #include <fstream>
 #include <deque>
 #include <memory>
+#include <vector>
 #include <cstring>
+#include <stdint.h>
 #include <unistd.h>
 
+#include "scan.hh"
+#include "stringpiece.hh"
+
 namespace bios {
 
+class BgzfReader;
+class GzipReader;
+class LineIndex;
+class Prefetcher;
+class UringReader;
+
 /// @class LineStream
 /// @brief Base class for reading lines from an input source.
+///
+/// Line splitting is done here on large blocks of input. Subclasses either
+/// supply raw bytes by implementing ReadBlock(), or hand over the whole input
+/// at once with SetBlock(). Line ends are found with the vectorized
+/// scan::find_newline().
 class LineStream {
  public:
   LineStream();
@@ -53,6 +69,26 @@ class LineStream {
   ///       it stays stable until the next call ls_nextLine(this1).
   bool GetLine(std::string& line);
 
+  /// Get the next line from a line stream object without copying it.
+  /// @param[out] line A view of the next line without the trailing newline.
+  /// @return true if there was another line, false otherwise.
+  /// @note The viewed memory belongs to the line stream and stays valid only
+  ///       until the next call to GetLine() or Back().
+  bool GetLine(StringPiece* line);
+
+  /// Get up to max_lines lines at once as views, without a virtual call or a
+  /// copy per line.
+  /// @param[out] lines Cleared and filled with views of the next lines
+  ///             without their trailing newlines.
+  /// @param[in] max_lines The maximum number of lines to return.
+  /// @return The number of lines returned, or 0 at the end of the input.
+  /// @note Pushed back lines are returned first, all of them if max_lines
+  ///       allows. Fewer than max_lines lines may be returned before the end
+  ///       of the input, because a batch ends where the current block of
+  ///       input ends. The views stay valid only until the next call to
+  ///       GetLine(), GetLines() or Back().
+  size_t GetLines(std::vector<StringPiece>* lines, size_t max_lines);
+
   /// Returns the number of the current line.
   /// @param[in] this1 A line stream 
   int GetLineCount();
@@ -73,6 +109,10 @@ class LineStream {
   /// @post Next call to ls_nextLine() will return the same line again
   void Back(std::string& str);
 
+  /// Push back a line that was returned as a view. The line is copied into
+  /// the push back buffer, so the view may be invalidated afterwards.
+  void Back(const StringPiece& line);
+
   /// @brief Returns whether the stream has reached the end of file.
   ///
   /// @return true if end of file is reached, false otherwise.
@@ -86,46 +126,239 @@ class LineStream {
     return IsEof();
   }
 
+  /// @struct PrefetchStats
+  /// @brief Counters describing how well read-ahead keeps up with parsing.
+  struct PrefetchStats {
+    uint64_t blocks;      // Blocks of input handed to the line splitter.
+    uint64_t stalls;      // Times no block was ready and the reader waited.
+    uint64_t stall_usecs; // Total time spent waiting, in microseconds.
+  };
+
+  /// @brief Reads the input on a background thread.
+  ///
+  /// A producer thread reads ahead into a bounded ring of large buffers while
+  /// lines are split from the previous one, so that I/O or decompression
+  /// overlaps with parsing. Must be called before the first line is read.
+  ///
+  /// @param     num_buffers  The number of buffers in the ring (at least 2).
+  ///
+  /// @return    true if prefetching was enabled, false if the stream does not
+  ///            read its input in blocks (e.g. a memory-mapped file) or has
+  ///            already started reading.
+  bool EnablePrefetch(int num_buffers);
+
+  /// @brief Returns the read-ahead counters. All counters are zero if
+  ///        prefetching is not enabled.
+  PrefetchStats GetPrefetchStats() const;
+
  protected: 
   /// Returns the next line of a file and closes the file if no further line was 
   /// found. The line can be of any length. A trailing \n or \r\n is removed.
-  /// @param[in] this1 line stream object
-  /// @return The line, NULL if no further line was found
+  /// @param[out] line A view of the line.
+  /// @return true if a line was read, false if no further line was found
   /// @note Memory managed by this routine
-  virtual bool GetNextLine(std::string& line);
+  virtual bool GetNextLine(StringPiece* line);
+
+  /// Reads up to size bytes of raw input into buffer. Subclasses that read
+  /// from a source incrementally implement this method.
+  /// @param[out] buffer The buffer to fill.
+  /// @param[in] size The number of bytes available in buffer.
+  /// @return The number of bytes read, or 0 at the end of the input.
+  virtual size_t ReadBlock(char* buffer, size_t size);
+
+  /// Uses an external buffer holding the entire input, such as a memory
+  /// mapping, instead of reading blocks. Lines are returned as views into
+  /// this buffer, which must outlive the line stream.
+  void SetBlock(const char* data, size_t size);
+
+  /// Returns whether all input has been consumed, ignoring pushed back lines.
+  bool AtEndOfInput() const {
+    return input_done_ && cursor_ >= limit_;
+  }
+
+  /// Stops the read-ahead thread, if any. Subclasses that implement
+  /// ReadBlock() must call this first thing in their destructor, since the
+  /// thread may otherwise still be inside ReadBlock() as they are destroyed.
+  void StopPrefetch();
+
+ private:
+  friend class Prefetcher;
+
+  bool SplitLine(StringPiece* line);
+  void Refill();
+  void RefillFromPrefetcher();
 
  protected:
+  enum {
+    kBlockSize = 1 << 20,
+    // Space left in front of each read-ahead buffer, so that the unfinished
+    // line at the end of one block can be copied in front of the next block
+    // instead of copying the whole block.
+    kPrefetchHeadroom = 1 << 16
+  };
+
   int count_;
   int status_;
   std::deque<std::string> buffer_;
   unsigned int buffer_size_;
+
+ private:
+  // Holds the line most recently popped off the push back buffer so that
+  // GetLine() can return a view of it.
+  std::string back_line_;
+
+  // Holds the pushed back lines returned by the last GetLines() call. A deque
+  // does not move its elements as it grows, so the views stay valid.
+  std::deque<std::string> back_lines_;
+
+  // Block buffer. Input between cursor_ and limit_ has not been returned as a
+  // line yet, and there is no newline between cursor_ and scan_.
+  char* block_;
+  size_t block_capacity_;
+  const char* cursor_;
+  const char* scan_;
+  const char* limit_;
+  bool input_done_;
+
+  Prefetcher* prefetcher_;
 };
 
 /// @class FileLineStream
 /// @brief Line stream class for reading lines from a file or standard input.
+///
+/// Regular files are memory-mapped and lines are returned as views into the
+/// mapping, so reading a line does not copy it. Standard input ("-") and
+/// files that cannot be mapped, such as named pipes, fall back to buffered
+/// reads. Alternatively, regular files can be read with read() or io_uring.
+/// Mapped files that start with the gzip magic bytes are decompressed
+/// in-process; BGZF files are decompressed in parallel on a pool of worker
+/// threads.
 class FileLineStream : public LineStream {
  public:
-  FileLineStream(const char* filename);
+  /// @enum ReadMode
+  /// @brief How a regular file is read.
+  enum ReadMode {
+    kReadMmap,   // Map the file into memory.
+    kReadPlain,  // Read the file block by block with read().
+    kReadUring   // Keep several reads in flight with io_uring.
+  };
+
+  /// @brief Opens a file.
+  ///
+  /// Modes that are not available for the file fall back to the next one:
+  /// io_uring falls back to mapping, for example on kernels without io_uring
+  /// or for gzip-compressed files, and mapping falls back to read().
+  ///
+  /// @param     filename   The name of the file or '-' for stdin.
+  /// @param     mode       How to read the file.
+  /// @param     bgzf_threads  The number of threads that decompress a BGZF
+  ///                          file, or 0 for the BgzfReader default.
+  FileLineStream(const char* filename, ReadMode mode = kReadMmap,
+                 int bgzf_threads = 0);
   ~FileLineStream();
+
+  /// @brief Returns how the file is actually being read.
+  ReadMode read_mode() const;
   
-  bool IsEof() const;
+  /// @brief Returns whether the file is read through a memory mapping.
+  bool IsMapped() const { return mapped_; }
+
+  /// @brief Returns whether the file is gzip-compressed.
+  bool IsCompressed() const { return gzip_ != NULL || bgzf_ != NULL; }
+
+  /// @brief Continues reading at a byte offset in the file.
+  ///
+  /// Only supported for uncompressed, memory-mapped files, where it takes
+  /// constant time. The offset should be the start of a line, e.g. as
+  /// returned by LineIndex::LineOffset(). Pushed back lines are discarded.
+  ///
+  /// @return    false if the stream cannot seek or offset is past the end.
+  bool SeekToOffset(uint64_t offset);
+
+  /// @brief Continues reading at line number line (counting from 0), using
+  ///        a LineIndex built for this file. GetLineCount() then returns line.
+  bool SeekToLine(const LineIndex& index, uint64_t line);
+
+ protected:
+  size_t ReadBlock(char* buffer, size_t size);
+
+ private:
+  bool Map(int fd);
+
+ private:
+  int fd_;
+  bool owns_fd_;
+  bool mapped_;
+  char* map_;
+  size_t map_size_;
+  GzipReader* gzip_;
+  BgzfReader* bgzf_;
+  UringReader* uring_;
+};
+
+/// @class GzipLineStream
+/// @brief Line stream class for reading lines from gzip-compressed input.
+///
+/// The input is decompressed in-process with zlib. BGZF files and other
+/// files made of several gzip members are read as a single stream.
+class GzipLineStream : public LineStream {
+ public:
+  /// @brief Opens a gzip-compressed file.
+  ///
+  /// @param     filename   The name of the file or '-' for stdin.
+  GzipLineStream(const char* filename);
+  ~GzipLineStream();
 
  protected:
-  bool GetNextLine(std::string& line);
+  size_t ReadBlock(char* buffer, size_t size);
 
  private:
-  std::istream* stream_;
-  std::ifstream* file_;
+  int fd_;
+  GzipReader* gzip_;
 };
 
-// Adapted from code provided by ihuk for the thread:
-// http://stackoverflow.com/questions/1683051/file-and-istream-connect-the-two
+/// @class MemoryLineStream
+/// @brief Line stream class for reading lines from a buffer in memory.
+///
+/// Lines are returned as views into the caller's buffer, which is never
+/// copied or modified. The buffer must stay valid and unchanged for the
+/// lifetime of the stream.
+class MemoryLineStream : public LineStream {
+ public:
+  /// @brief Reads lines from size bytes starting at data.
+  MemoryLineStream(const char* data, size_t size);
+
+  /// @brief Reads lines from the memory viewed by buffer.
+  MemoryLineStream(const StringPiece& buffer);
+  ~MemoryLineStream();
+};
+
+/// @class pipe_streambuf
+/// @brief Stream buffer over the read end of a pipe to a child process.
+///
+/// Data is read straight from the pipe file descriptor into a large buffer.
+/// Requests at least as large as the buffer are read directly into the
+/// caller's memory without going through it.
+///
+/// Adapted from code provided by ihuk for the thread:
+/// http://stackoverflow.com/questions/1683051/file-and-istream-connect-the-two
 class pipe_streambuf : public std::streambuf {
  public:
-  pipe_streambuf();
+  enum {
+    kDefaultBufferSize = 1 << 20
+  };
+
+  explicit pipe_streambuf(size_t buffer_size = kDefaultBufferSize);
   ~pipe_streambuf();
 
+  /// @brief Runs command with /bin/sh and reads its standard output.
   pipe_streambuf* open(const char* command, const char* mode);
+
+  /// @brief Runs argv[0] without a shell and reads its standard output.
+  ///
+  /// The program is searched for in PATH. argv must be NULL-terminated.
+  pipe_streambuf* spawn(const char* const* argv);
+
   void close();
 
  protected:
@@ -134,29 +367,39 @@ class pipe_streambuf : public std::streambuf {
   std::streamsize showmanyc();
  
  private:
-  enum {
-    kBufferSize = 1024
-  };
+  ssize_t ReadFd(char* buffer, size_t size);
 
   FILE* fp_;
+  int fd_;
+  pid_t pid_;
   char_type* buffer_;
+  size_t buffer_size_;
 };
 
 /// @class PipeLineStream
 /// @brief Line stream class for reading lines from the output of a command.
 class PipeLineStream : public LineStream {
  public:
-  PipeLineStream(const char* pipe);
-  ~PipeLineStream();
+  /// @brief Runs a command and reads lines from its output.
+  ///
+  /// @param     command    The command to run.
+  /// @param     use_shell  If true, the command is run with /bin/sh. If false,
+  ///                       the command is split on whitespace and the program
+  ///                       is started directly, which avoids the shell but
+  ///                       does not support quoting, redirection or pipelines.
+  PipeLineStream(const char* command, bool use_shell = true);
 
-  bool IsEof() const;
+  /// @brief Runs argv[0] without a shell and reads lines from its output.
+  ///
+  /// @param     argv       NULL-terminated program name and arguments.
+  PipeLineStream(const char* const* argv);
+  ~PipeLineStream();
 
  protected: 
-  bool GetNextLine(std::string& line);
+  size_t ReadBlock(char* buffer, size_t size);
 
  private:
   pipe_streambuf* pipe_;
-  std::istream* stream_;
 };
 
 }; // namespace bios
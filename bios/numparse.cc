@@ -0,0 +1,301 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file numparse.cc
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// Implementation of the checked numeric field parsers.
+
+#include "numparse.hh"
+
+#include <cerrno>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <locale.h>
+#include <string>
+#ifdef __APPLE__
+#include <xlocale.h>
+#endif
+
+namespace bios {
+
+namespace num {
+
+const char* parse_status_string(ParseStatus status) {
+  switch (status) {
+    case kParseOk:
+      return "ok";
+    case kParseEmpty:
+      return "empty field";
+    case kParseInvalid:
+      return "malformed";
+    case kParseOutOfRange:
+      return "number out of range";
+  }
+  return "unknown error";
+}
+
+void report_parse_error(const char* what, const StringPiece& field,
+                        ParseStatus status, int line_number) {
+  std::cerr << "Invalid " << what;
+  if (line_number > 0) {
+    std::cerr << " on line " << line_number;
+  }
+  std::cerr << ": '" << field << "' (" << parse_status_string(status) << ")"
+            << std::endl;
+}
+
+void report_field_count_error(const char* what, size_t expected, size_t found,
+                              int line_number) {
+  std::cerr << "Too few " << what << " fields";
+  if (line_number > 0) {
+    std::cerr << " on line " << line_number;
+  }
+  std::cerr << ": expected " << expected << ", found " << found << std::endl;
+}
+
+static inline bool is_digit(char c) {
+  return static_cast<unsigned char>(c - '0') < 10;
+}
+
+// Parses the digits at the start of [first, last) as an unsigned number no
+// greater than limit. Digits past an overflow are still consumed.
+static FromCharsResult parse_magnitude(const char* first, const char* last,
+                                       uint64_t limit, uint64_t* magnitude) {
+  FromCharsResult result = { first, kParseInvalid };
+  const char* p = first;
+  uint64_t value = 0;
+  bool overflow = false;
+  for (; p < last && is_digit(*p); ++p) {
+    unsigned digit = *p - '0';
+    if (value > (limit - digit) / 10) {
+      overflow = true;
+    } else {
+      value = value * 10 + digit;
+    }
+  }
+  if (p == first) {
+    return result;
+  }
+  result.ptr = p;
+  result.status = overflow ? kParseOutOfRange : kParseOk;
+  *magnitude = value;
+  return result;
+}
+
+// Parses an optionally negative integer in [min, max], where min is
+// -(max + 1) for two's complement types.
+static FromCharsResult parse_signed(const char* first, const char* last,
+                                    uint64_t max, int64_t* value) {
+  bool negative = first < last && *first == '-';
+  uint64_t magnitude;
+  FromCharsResult result = parse_magnitude(first + negative, last,
+                                           max + negative, &magnitude);
+  if (result.status == kParseInvalid) {
+    result.ptr = first;
+  } else if (result.status == kParseOk) {
+    // Negate in unsigned arithmetic so that the minimum value does not
+    // overflow.
+    *value = negative ? static_cast<int64_t>(0 - magnitude)
+                      : static_cast<int64_t>(magnitude);
+  }
+  return result;
+}
+
+FromCharsResult from_chars(const char* first, const char* last, int* value) {
+  int64_t parsed;
+  FromCharsResult result = parse_signed(first, last,
+                                        std::numeric_limits<int>::max(),
+                                        &parsed);
+  if (result.status == kParseOk) {
+    *value = static_cast<int>(parsed);
+  }
+  return result;
+}
+
+FromCharsResult from_chars(const char* first, const char* last,
+                           unsigned int* value) {
+  uint64_t parsed;
+  FromCharsResult result = parse_magnitude(
+      first, last, std::numeric_limits<unsigned int>::max(), &parsed);
+  if (result.status == kParseOk) {
+    *value = static_cast<unsigned int>(parsed);
+  }
+  return result;
+}
+
+FromCharsResult from_chars(const char* first, const char* last,
+                           int64_t* value) {
+  return parse_signed(first, last, std::numeric_limits<int64_t>::max(),
+                      value);
+}
+
+FromCharsResult from_chars(const char* first, const char* last,
+                           uint64_t* value) {
+  return parse_magnitude(first, last, std::numeric_limits<uint64_t>::max(),
+                         value);
+}
+
+// Returns whether [p, last) starts with word, ignoring case. word must be
+// lower case.
+static bool starts_with_word(const char* p, const char* last,
+                             const char* word) {
+  for (; *word != '\0'; ++p, ++word) {
+    if (p == last || (*p | 0x20) != *word) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Powers of ten that are exactly representable as doubles.
+static const double kExactPowersOfTen[] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12,
+  1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+static const int kMaxExactPowerOfTen = 22;
+
+// Digits that fit in a uint64_t without overflow.
+static const int kMaxMantissaDigits = 19;
+
+// Mantissas up to 2^53 are exactly representable as doubles.
+static const uint64_t kMaxExactMantissa = static_cast<uint64_t>(1) << 53;
+
+// Converts text already checked to be a decimal number with strtod(),
+// independently of the current locale.
+static double convert_slow(const char* first, const char* last) {
+  static locale_t c_locale = newlocale(LC_ALL_MASK, "C", (locale_t) 0);
+  std::string text(first, last);
+  return strtod_l(text.c_str(), NULL, c_locale);
+}
+
+FromCharsResult from_chars(const char* first, const char* last,
+                           double* value) {
+  FromCharsResult result = { first, kParseInvalid };
+  const char* p = first;
+  bool negative = p < last && *p == '-';
+  p += negative;
+
+  if (p < last && !is_digit(*p) && *p != '.') {
+    double special;
+    if (starts_with_word(p, last, "infinity")) {
+      p += 8;
+      special = std::numeric_limits<double>::infinity();
+    } else if (starts_with_word(p, last, "inf")) {
+      p += 3;
+      special = std::numeric_limits<double>::infinity();
+    } else if (starts_with_word(p, last, "nan")) {
+      p += 3;
+      special = std::numeric_limits<double>::quiet_NaN();
+    } else {
+      return result;
+    }
+    *value = negative ? -special : special;
+    result.ptr = p;
+    result.status = kParseOk;
+    return result;
+  }
+
+  // Collect up to kMaxMantissaDigits significant digits into mantissa,
+  // tracking the decimal exponent separately.
+  uint64_t mantissa = 0;
+  int digits = 0;
+  int exponent = 0;
+  bool truncated = false;
+  bool any_digits = false;
+  for (; p < last && is_digit(*p); ++p) {
+    any_digits = true;
+    if (digits < kMaxMantissaDigits) {
+      mantissa = mantissa * 10 + (*p - '0');
+      digits += mantissa != 0;
+    } else {
+      ++exponent;
+      truncated = truncated || *p != '0';
+    }
+  }
+  if (p < last && *p == '.') {
+    ++p;
+    for (; p < last && is_digit(*p); ++p) {
+      any_digits = true;
+      if (digits < kMaxMantissaDigits) {
+        mantissa = mantissa * 10 + (*p - '0');
+        digits += mantissa != 0;
+        --exponent;
+      } else {
+        truncated = truncated || *p != '0';
+      }
+    }
+  }
+  if (!any_digits) {
+    return result;
+  }
+
+  // The exponent is only part of the number if it has digits.
+  if (p < last && (*p == 'e' || *p == 'E')) {
+    const char* q = p + 1;
+    bool negative_exponent = false;
+    if (q < last && (*q == '-' || *q == '+')) {
+      negative_exponent = *q == '-';
+      ++q;
+    }
+    if (q < last && is_digit(*q)) {
+      int explicit_exponent = 0;
+      for (; q < last && is_digit(*q); ++q) {
+        if (explicit_exponent < 100000) {
+          explicit_exponent = explicit_exponent * 10 + (*q - '0');
+        }
+      }
+      exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+      p = q;
+    }
+  }
+  result.ptr = p;
+
+  double parsed;
+  if (mantissa == 0 && !truncated) {
+    parsed = 0.0;
+  } else if (!truncated && mantissa <= kMaxExactMantissa &&
+             exponent >= -kMaxExactPowerOfTen &&
+             exponent <= kMaxExactPowerOfTen) {
+    // Both the mantissa and the power of ten are exact, so a single
+    // multiplication or division rounds correctly.
+    double m = static_cast<double>(mantissa);
+    parsed = exponent >= 0 ? m * kExactPowersOfTen[exponent]
+                           : m / kExactPowersOfTen[-exponent];
+  } else {
+    errno = 0;
+    parsed = convert_slow(first + negative, p);
+    if (errno == ERANGE && parsed > 1.0) {
+      result.status = kParseOutOfRange;
+      return result;
+    }
+    // Underflow to a denormal or zero is accepted, since such values are
+    // as close to zero as a double gets.
+  }
+  *value = negative ? -parsed : parsed;
+  result.status = kParseOk;
+  return result;
+}
+
+}; // namespace num
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
@@ -0,0 +1,139 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file numparse.hh
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// Checked conversion of numeric text fields, in the style of C++17
+/// std::from_chars. Unlike atoi() and atof(), these functions parse a view
+/// that need not be NUL-terminated, do not depend on the locale, and report
+/// empty fields, trailing garbage and values that do not fit in the target
+/// type instead of returning 0.
+///
+/// The accepted syntax is that of std::from_chars: an optional '-' (for
+/// signed and floating point types only), then decimal digits. Floating
+/// point values may have a fraction and an exponent, or be "inf",
+/// "infinity" or "nan" in any case. Leading whitespace and '+' are not
+/// accepted.
+
+#ifndef BIOS_NUMPARSE_H__
+#define BIOS_NUMPARSE_H__
+
+#include <stdint.h>
+
+#include "stringpiece.hh"
+
+namespace bios {
+
+namespace num {
+
+/// @brief Outcome of parsing a number.
+enum ParseStatus {
+  kParseOk = 0,
+  kParseEmpty,       // The field is empty.
+  kParseInvalid,     // The field is not a number, or has trailing characters.
+  kParseOutOfRange   // The number does not fit in the target type.
+};
+
+/// @brief Returns a short description of status for error messages.
+const char* parse_status_string(ParseStatus status);
+
+/// @struct FromCharsResult
+/// @brief Result of from_chars().
+struct FromCharsResult {
+  const char* ptr;    // One past the last character that was part of the
+                      // number, or first if there was no number.
+  ParseStatus status;
+};
+
+/// @brief Parses the number at the start of [first, last).
+///
+/// Parsing stops at the first character that cannot extend the number. The
+/// value is only written on success. A number that is out of range is still
+/// consumed, so ptr points past it.
+FromCharsResult from_chars(const char* first, const char* last, int* value);
+FromCharsResult from_chars(const char* first, const char* last,
+                           unsigned int* value);
+FromCharsResult from_chars(const char* first, const char* last,
+                           int64_t* value);
+FromCharsResult from_chars(const char* first, const char* last,
+                           uint64_t* value);
+FromCharsResult from_chars(const char* first, const char* last,
+                           double* value);
+
+/// @brief Parses a field that must consist of exactly one number.
+///
+/// @param    field  The text of the field.
+/// @param    value  Receives the number. Left unchanged on failure.
+/// @return   kParseOk on success, otherwise the reason for the failure.
+template <typename T>
+ParseStatus parse_field(const StringPiece& field, T* value) {
+  if (field.empty()) {
+    return kParseEmpty;
+  }
+  T parsed;
+  FromCharsResult result = from_chars(field.begin(), field.end(), &parsed);
+  if (result.status != kParseOk) {
+    return result.status;
+  }
+  if (result.ptr != field.end()) {
+    return kParseInvalid;
+  }
+  *value = parsed;
+  return kParseOk;
+}
+
+/// @brief Prints a message about a field that failed to parse to stderr.
+///
+/// @param    what         The name of the field, such as "BED start".
+/// @param    field        The text of the field.
+/// @param    status       The reason the field was rejected.
+/// @param    line_number  The line the field is on, or 0 if unknown.
+void report_parse_error(const char* what, const StringPiece& field,
+                        ParseStatus status, int line_number);
+
+/// @brief Prints a message about a line with too few fields to stderr.
+///
+/// @param    what         The kind of line, such as "BLAST".
+/// @param    expected     The number of fields required.
+/// @param    found        The number of fields on the line.
+/// @param    line_number  The line number, or 0 if unknown.
+void report_field_count_error(const char* what, size_t expected, size_t found,
+                              int line_number);
+
+/// @brief Parses a numeric field, reporting a failure to stderr.
+///
+/// @return   true if the field was parsed, false if it was reported.
+template <typename T>
+bool parse_field(const StringPiece& field, T* value, const char* what,
+                 int line_number) {
+  ParseStatus status = parse_field(field, value);
+  if (status != kParseOk) {
+    report_parse_error(what, field, status, line_number);
+    return false;
+  }
+  return true;
+}
+
+}; // namespace num
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
+#endif /* BIOS_NUMPARSE_H__ */
@@ -0,0 +1,215 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file packedseq.cc
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// Implementation of the 2-bit packed nucleotide sequence.
+
+#include "packedseq.hh"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+namespace bios {
+
+// Marks characters that are packed as N.
+static const uint8_t kNotBase = 0xff;
+
+// Upper-case bases in 2-bit order.
+static const char kValToBase[] = "TCAG";
+
+namespace {
+
+/// Lookup tables for packing and unpacking, built once.
+struct PackTables {
+  PackTables() {
+    memset(base_to_val, kNotBase, sizeof(base_to_val));
+    const char bases[] = "TCAGU";
+    const uint8_t vals[] = {T_BASE_VAL, C_BASE_VAL, A_BASE_VAL, G_BASE_VAL,
+                            U_BASE_VAL};
+    for (int i = 0; i < 5; ++i) {
+      base_to_val[static_cast<uint8_t>(bases[i])] = vals[i];
+      base_to_val[static_cast<uint8_t>(bases[i] | 0x20)] = vals[i];
+    }
+    for (int byte = 0; byte < 256; ++byte) {
+      for (int j = 0; j < 4; ++j) {
+        byte_to_bases[byte][j] = kValToBase[(byte >> (6 - 2 * j)) & 3];
+      }
+    }
+  }
+
+  uint8_t base_to_val[256];
+  // The four upper-case bases packed in each byte value.
+  char byte_to_bases[256][4];
+};
+
+}  // namespace
+
+static const PackTables& Tables() {
+  static const PackTables tables;
+  return tables;
+}
+
+// Returns the first block that ends after pos.
+static std::vector<PackedSeq::Block>::const_iterator FirstBlockEndingAfter(
+    const std::vector<PackedSeq::Block>& blocks, uint32_t pos) {
+  size_t lo = 0;
+  size_t hi = blocks.size();
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (blocks[mid].start + blocks[mid].size <= pos) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return blocks.begin() + lo;
+}
+
+// Extends the last run in blocks if it ends at pos, or starts a new one.
+static void AddToRun(std::vector<PackedSeq::Block>* blocks, uint32_t pos) {
+  if (!blocks->empty() && blocks->back().start + blocks->back().size == pos) {
+    ++blocks->back().size;
+  } else {
+    PackedSeq::Block block = {pos, 1};
+    blocks->push_back(block);
+  }
+}
+
+PackedSeq::PackedSeq()
+    : size_(0) {
+}
+
+void PackedSeq::Pack(const char* dna, uint32_t size) {
+  const uint8_t* base_to_val = Tables().base_to_val;
+  size_ = size;
+  packed_.assign((size + 3) / 4, 0);
+  n_blocks_.clear();
+  mask_blocks_.clear();
+  for (uint32_t i = 0; i < size; ++i) {
+    uint8_t c = static_cast<uint8_t>(dna[i]);
+    uint8_t val = base_to_val[c];
+    if (val == kNotBase) {
+      AddToRun(&n_blocks_, i);
+      val = T_BASE_VAL;
+    }
+    if (c >= 'a' && c <= 'z') {
+      AddToRun(&mask_blocks_, i);
+    }
+    packed_[i >> 2] |= val << (6 - 2 * (i & 3));
+  }
+}
+
+void PackedSeq::FromSeq(const Seq& seq) {
+  name_ = seq.name;
+  Pack(seq.sequence, seq.sequence == NULL ? 0 : seq.size);
+}
+
+void PackedSeq::ToSeq(Seq* seq) const {
+  char* buffer = static_cast<char*>(malloc(size_ + 1));
+  Extract(0, size_, buffer);
+  buffer[size_] = '\0';
+  seq->name = name_;
+  seq->AdoptSequence(buffer, size_);
+}
+
+bool PackedSeq::Extract(uint32_t start, uint32_t end, char* out) const {
+  if (start > end || end > size_) {
+    std::cerr << "Range [" << start << ", " << end << ") is outside "
+              << (name_.empty() ? "the sequence" : name_) << " of size "
+              << size_ << std::endl;
+    return false;
+  }
+  Unpack(packed_.empty() ? NULL : &packed_[0], start, end, out);
+
+  for (std::vector<Block>::const_iterator it =
+           FirstBlockEndingAfter(n_blocks_, start);
+       it != n_blocks_.end() && it->start < end; ++it) {
+    uint32_t from = std::max(it->start, start);
+    uint32_t to = std::min(it->start + it->size, end);
+    memset(out + (from - start), 'N', to - from);
+  }
+  for (std::vector<Block>::const_iterator it =
+           FirstBlockEndingAfter(mask_blocks_, start);
+       it != mask_blocks_.end() && it->start < end; ++it) {
+    uint32_t from = std::max(it->start, start);
+    uint32_t to = std::min(it->start + it->size, end);
+    for (uint32_t j = from; j < to; ++j) {
+      out[j - start] |= 0x20;
+    }
+  }
+  return true;
+}
+
+void PackedSeq::Unpack(const uint8_t* packed, uint32_t start, uint32_t end,
+                       char* out) {
+  const PackTables& tables = Tables();
+  uint32_t i = start;
+  // Bases up to the next byte boundary, then four at a time.
+  for (; i < end && (i & 3) != 0; ++i) {
+    *out++ = kValToBase[(packed[i >> 2] >> (6 - 2 * (i & 3))) & 3];
+  }
+  for (; i + 4 <= end; i += 4) {
+    memcpy(out, tables.byte_to_bases[packed[i >> 2]], 4);
+    out += 4;
+  }
+  for (; i < end; ++i) {
+    *out++ = kValToBase[(packed[i >> 2] >> (6 - 2 * (i & 3))) & 3];
+  }
+}
+
+std::string PackedSeq::Substring(uint32_t start, uint32_t end) const {
+  if (start > end || end > size_) {
+    return std::string();
+  }
+  std::string result(end - start, '\0');
+  if (!result.empty()) {
+    Extract(start, end, &result[0]);
+  }
+  return result;
+}
+
+bool PackedSeq::IsN(uint32_t i) const {
+  std::vector<Block>::const_iterator it = FirstBlockEndingAfter(n_blocks_, i);
+  return it != n_blocks_.end() && it->start <= i;
+}
+
+void PackedSeq::Assign(uint32_t size, std::vector<uint8_t>* packed,
+                       std::vector<Block>* n_blocks,
+                       std::vector<Block>* mask_blocks) {
+  size_ = size;
+  packed_.swap(*packed);
+  n_blocks_.swap(*n_blocks);
+  mask_blocks_.swap(*mask_blocks);
+  packed->clear();
+  n_blocks->clear();
+  mask_blocks->clear();
+}
+
+size_t PackedSeq::MemoryUsage() const {
+  return sizeof(*this) + name_.capacity() + packed_.capacity() +
+      (n_blocks_.capacity() + mask_blocks_.capacity()) * sizeof(Block);
+}
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
@@ -0,0 +1,122 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file packedseq.hh
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// A nucleotide sequence stored at 2 bits per base, about a quarter of the
+/// memory of a Seq. Bases use the encoding of alphabet::kNtVal (T = 0,
+/// C = 1, A = 2, G = 3) and are packed four to a byte with the first base
+/// in the two most significant bits, the layout of the UCSC .2bit format.
+///
+/// Two bits cannot hold N or the case of a base, so both are kept on the
+/// side as sorted lists of runs: N-blocks, whose packed bases are stored as
+/// T, and mask blocks of lower-case (repeat masked) bases. Characters other
+/// than ACGTU are stored as N and U is stored as T, as in .2bit files.
+
+#ifndef BIOS_PACKEDSEQ_H__
+#define BIOS_PACKEDSEQ_H__
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "seq.hh"
+
+namespace bios {
+
+/// @class PackedSeq
+/// @brief A 2-bit packed nucleotide sequence with N and mask runs.
+class PackedSeq {
+ public:
+  /// @struct Block
+  /// @brief A run of bases [start, start + size).
+  struct Block {
+    uint32_t start;
+    uint32_t size;
+  };
+
+  PackedSeq();
+
+  /// @brief Packs size ASCII bases, replacing the current contents.
+  void Pack(const char* dna, uint32_t size);
+
+  /// @brief Packs the bases and copies the name of seq.
+  void FromSeq(const Seq& seq);
+
+  /// @brief Unpacks the whole sequence and name into seq, replacing its
+  ///        contents.
+  void ToSeq(Seq* seq) const;
+
+  /// @brief Writes bases [start, end) as ASCII to out, which must have room
+  ///        for end - start characters. No NUL is appended. Bases in N-blocks
+  ///        are written as 'N', masked bases in lower case and all others in
+  ///        upper case.
+  ///
+  /// @return   false if the range is outside the sequence, after reporting
+  ///           it.
+  bool Extract(uint32_t start, uint32_t end, char* out) const;
+
+  /// @brief Returns bases [start, end) as a string, or an empty string if
+  ///        the range is outside the sequence.
+  std::string Substring(uint32_t start, uint32_t end) const;
+
+  /// @brief Returns the 2-bit value of base i. Bases in N-blocks read as
+  ///        T_BASE_VAL; use IsN() to tell them apart.
+  int BaseValue(uint32_t i) const {
+    return (packed_[i >> 2] >> (6 - 2 * (i & 3))) & 3;
+  }
+
+  /// @brief Returns whether base i lies in an N-block.
+  bool IsN(uint32_t i) const;
+
+  /// @brief Replaces the contents with already packed data, as read from a
+  ///        .2bit file. packed must hold (size + 3) / 4 bytes and the blocks
+  ///        must be sorted and non-overlapping. The vectors are taken over
+  ///        without copying and left empty.
+  void Assign(uint32_t size, std::vector<uint8_t>* packed,
+              std::vector<Block>* n_blocks, std::vector<Block>* mask_blocks);
+
+  /// @brief Writes bases [start, end) of 2-bit data in the layout above to
+  ///        out as upper-case ASCII, ignoring N-blocks and mask blocks.
+  static void Unpack(const uint8_t* packed, uint32_t start, uint32_t end,
+                     char* out);
+
+  /// @brief Returns the approximate number of bytes held by the sequence.
+  size_t MemoryUsage() const;
+
+  const std::string& name() const { return name_; }
+  void set_name(const std::string& name) { name_ = name; }
+  uint32_t size() const { return size_; }
+  const std::vector<uint8_t>& packed() const { return packed_; }
+  const std::vector<Block>& n_blocks() const { return n_blocks_; }
+  const std::vector<Block>& mask_blocks() const { return mask_blocks_; }
+
+ private:
+  std::string name_;
+  uint32_t size_;
+  std::vector<uint8_t> packed_;
+  std::vector<Block> n_blocks_;
+  std::vector<Block> mask_blocks_;
+};
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
+#endif /* BIOS_PACKEDSEQ_H__ */
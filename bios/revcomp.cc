@@ -0,0 +1,312 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file revcomp.cc
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// Vectorized complement and reverse complement of nucleotide sequences.
+///
+/// The vector kernels complement 16 or 32 bytes at a time with pshufb: the
+/// complement table is split into 16-entry rows by high nibble, the low
+/// nibble of each byte indexes every row, and bytes whose high nibble does
+/// not match a row are zeroed in that row's lookup. Every character in the
+/// complement table lies in 0x20-0x7f, so six rows cover it. Reversal is a
+/// byte shuffle within the register, and the reverse complement swaps
+/// blocks from the two ends of the sequence so that the whole operation is
+/// one pass over memory.
+
+#include "revcomp.hh"
+
+#include <cstring>
+#include <stdint.h>
+
+#ifdef BIOS_X86
+#include <immintrin.h>
+#endif
+
+namespace bios {
+
+namespace revcomp {
+
+namespace {
+
+struct ComplementTables {
+  ComplementTables() {
+    memset(byte, 0, sizeof(byte));
+    const char orig[] = " -=acgtun.ACGTUNRYMKSWVHDBXryswmkvhdbx()";
+    const char tran[] = " -=tgcaan.TGCAANYRKMSWBDHVNyrswkmbdhvn)(";
+    for (size_t i = 0; i < sizeof(orig) - 1; ++i) {
+      byte[static_cast<uint8_t>(orig[i])] = tran[i];
+    }
+    for (int hi = 0; hi < 8; ++hi) {
+      memcpy(nibble[hi], byte + 16 * hi, 16);
+    }
+  }
+
+  char byte[256];
+  // byte split into rows by high nibble, for the vector kernels.
+  char nibble[8][16];
+};
+
+}  // namespace
+
+// The first high nibble with non-zero entries, and the number of rows used.
+static const int kFirstRow = 2;
+static const int kNumRows = 6;
+
+static const ComplementTables& Tables() {
+  static const ComplementTables tables;
+  return tables;
+}
+
+char complement_base(char c) {
+  return Tables().byte[static_cast<uint8_t>(c)];
+}
+
+void complement_scalar(char* dna, size_t length) {
+  const char* table = Tables().byte;
+  for (size_t i = 0; i < length; ++i) {
+    dna[i] = table[static_cast<uint8_t>(dna[i])];
+  }
+}
+
+void reverse_complement_scalar(char* dna, size_t length) {
+  const char* table = Tables().byte;
+  char* lo = dna;
+  char* hi = dna + length;
+  while (hi - lo >= 2) {
+    --hi;
+    char c = table[static_cast<uint8_t>(*lo)];
+    *lo = table[static_cast<uint8_t>(*hi)];
+    *hi = c;
+    ++lo;
+  }
+  if (lo < hi) {
+    *lo = table[static_cast<uint8_t>(*lo)];
+  }
+}
+
+#ifdef BIOS_X86
+
+// The six table rows, one per high nibble from 0x20 to 0x70.
+struct Rows16 {
+  __m128i row[kNumRows];
+};
+
+__attribute__((target("ssse3")))
+static inline void load_rows_16(Rows16* rows) {
+  const ComplementTables& tables = Tables();
+  for (int i = 0; i < kNumRows; ++i) {
+    rows->row[i] = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(tables.nibble[kFirstRow + i]));
+  }
+}
+
+// Looks up the bytes of v whose high nibble matches the row that x is
+// relative to. x is v minus the row's first byte, so those bytes are 0-15
+// in x; adding 0x70 with saturation sets the top bit of every other byte,
+// which makes pshufb return 0 for it.
+__attribute__((target("ssse3")))
+static inline __m128i lookup_row_16(__m128i row, __m128i x) {
+  return _mm_shuffle_epi8(row, _mm_adds_epu8(x, _mm_set1_epi8(0x70)));
+}
+
+__attribute__((target("ssse3")))
+static inline __m128i complement_16(__m128i v, const Rows16& rows) {
+  const __m128i step = _mm_set1_epi8(0x10);
+  __m128i x = _mm_sub_epi8(v, _mm_set1_epi8(kFirstRow << 4));
+  __m128i result = lookup_row_16(rows.row[0], x);
+  x = _mm_sub_epi8(x, step);
+  result = _mm_or_si128(result, lookup_row_16(rows.row[1], x));
+  x = _mm_sub_epi8(x, step);
+  result = _mm_or_si128(result, lookup_row_16(rows.row[2], x));
+  x = _mm_sub_epi8(x, step);
+  result = _mm_or_si128(result, lookup_row_16(rows.row[3], x));
+  x = _mm_sub_epi8(x, step);
+  result = _mm_or_si128(result, lookup_row_16(rows.row[4], x));
+  x = _mm_sub_epi8(x, step);
+  return _mm_or_si128(result, lookup_row_16(rows.row[5], x));
+}
+
+__attribute__((target("ssse3")))
+void complement_ssse3(char* dna, size_t length) {
+  Rows16 rows;
+  load_rows_16(&rows);
+  char* p = dna;
+  char* end = dna + length;
+  for (; end - p >= 16; p += 16) {
+    __m128i* block = reinterpret_cast<__m128i*>(p);
+    _mm_storeu_si128(block, complement_16(_mm_loadu_si128(block), rows));
+  }
+  complement_scalar(p, end - p);
+}
+
+__attribute__((target("ssse3")))
+void reverse_complement_ssse3(char* dna, size_t length) {
+  Rows16 rows;
+  load_rows_16(&rows);
+  const __m128i reverse = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8,
+                                        7, 6, 5, 4, 3, 2, 1, 0);
+  char* lo = dna;
+  char* hi = dna + length;
+  // Swap a block from each end until they meet. Once 16 to 31 bytes are
+  // left, the last two blocks overlap, but both are loaded before either
+  // is stored, and the overlapping bytes get the same value from both.
+  while (hi - lo >= 16) {
+    __m128i* front = reinterpret_cast<__m128i*>(lo);
+    __m128i* back = reinterpret_cast<__m128i*>(hi - 16);
+    __m128i a = _mm_shuffle_epi8(_mm_loadu_si128(front), reverse);
+    __m128i b = _mm_shuffle_epi8(_mm_loadu_si128(back), reverse);
+    _mm_storeu_si128(front, complement_16(b, rows));
+    _mm_storeu_si128(back, complement_16(a, rows));
+    if (hi - lo < 32) {
+      return;
+    }
+    lo += 16;
+    hi -= 16;
+  }
+  reverse_complement_scalar(lo, hi - lo);
+}
+
+struct Rows32 {
+  __m256i row[kNumRows];
+};
+
+__attribute__((target("avx2")))
+static inline void load_rows_32(Rows32* rows) {
+  const ComplementTables& tables = Tables();
+  for (int i = 0; i < kNumRows; ++i) {
+    rows->row[i] = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(tables.nibble[kFirstRow + i])));
+  }
+}
+
+__attribute__((target("avx2")))
+static inline __m256i lookup_row_32(__m256i row, __m256i x) {
+  return _mm256_shuffle_epi8(row, _mm256_adds_epu8(x, _mm256_set1_epi8(0x70)));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i complement_32(__m256i v, const Rows32& rows) {
+  const __m256i step = _mm256_set1_epi8(0x10);
+  __m256i x = _mm256_sub_epi8(v, _mm256_set1_epi8(kFirstRow << 4));
+  __m256i result = lookup_row_32(rows.row[0], x);
+  x = _mm256_sub_epi8(x, step);
+  result = _mm256_or_si256(result, lookup_row_32(rows.row[1], x));
+  x = _mm256_sub_epi8(x, step);
+  result = _mm256_or_si256(result, lookup_row_32(rows.row[2], x));
+  x = _mm256_sub_epi8(x, step);
+  result = _mm256_or_si256(result, lookup_row_32(rows.row[3], x));
+  x = _mm256_sub_epi8(x, step);
+  result = _mm256_or_si256(result, lookup_row_32(rows.row[4], x));
+  x = _mm256_sub_epi8(x, step);
+  return _mm256_or_si256(result, lookup_row_32(rows.row[5], x));
+}
+
+// Reverses the 32 bytes of v. The byte shuffle only works within each
+// 128-bit lane, so the lanes are swapped afterwards.
+__attribute__((target("avx2")))
+static inline __m256i reverse_32(__m256i v) {
+  const __m256i reverse = _mm256_setr_epi8(
+      15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+      15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+  return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, reverse), 0x4e);
+}
+
+__attribute__((target("avx2")))
+void complement_avx2(char* dna, size_t length) {
+  Rows32 rows;
+  load_rows_32(&rows);
+  char* p = dna;
+  char* end = dna + length;
+  for (; end - p >= 32; p += 32) {
+    __m256i* block = reinterpret_cast<__m256i*>(p);
+    _mm256_storeu_si256(block,
+                        complement_32(_mm256_loadu_si256(block), rows));
+  }
+  complement_ssse3(p, end - p);
+}
+
+__attribute__((target("avx2")))
+void reverse_complement_avx2(char* dna, size_t length) {
+  Rows32 rows;
+  load_rows_32(&rows);
+  char* lo = dna;
+  char* hi = dna + length;
+  // As in the SSSE3 version, the last two blocks may overlap.
+  while (hi - lo >= 32) {
+    __m256i* front = reinterpret_cast<__m256i*>(lo);
+    __m256i* back = reinterpret_cast<__m256i*>(hi - 32);
+    __m256i a = reverse_32(_mm256_loadu_si256(front));
+    __m256i b = reverse_32(_mm256_loadu_si256(back));
+    _mm256_storeu_si256(front, complement_32(b, rows));
+    _mm256_storeu_si256(back, complement_32(a, rows));
+    if (hi - lo < 64) {
+      return;
+    }
+    lo += 32;
+    hi -= 32;
+  }
+  reverse_complement_ssse3(lo, hi - lo);
+}
+
+#endif // BIOS_X86
+
+typedef void (*ComplementFunction)(char*, size_t);
+
+static ComplementFunction select_complement() {
+#ifdef BIOS_X86
+  if (cpu::has_avx2()) {
+    return complement_avx2;
+  }
+  if (cpu::has_ssse3()) {
+    return complement_ssse3;
+  }
+#endif
+  return complement_scalar;
+}
+
+static ComplementFunction select_reverse_complement() {
+#ifdef BIOS_X86
+  if (cpu::has_avx2()) {
+    return reverse_complement_avx2;
+  }
+  if (cpu::has_ssse3()) {
+    return reverse_complement_ssse3;
+  }
+#endif
+  return reverse_complement_scalar;
+}
+
+// The implementations are selected on the first call, as in scan.cc.
+void complement(char* dna, size_t length) {
+  static const ComplementFunction impl = select_complement();
+  impl(dna, length);
+}
+
+void reverse_complement(char* dna, size_t length) {
+  static const ComplementFunction impl = select_reverse_complement();
+  impl(dna, length);
+}
+
+}; // namespace revcomp
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
@@ -0,0 +1,72 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file revcomp.hh
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// Vectorized complement and reverse complement of nucleotide sequences.
+/// Both routines handle the full IUPAC alphabet in either case, plus the gap
+/// and punctuation characters used in alignments; any other byte becomes 0.
+/// Each routine has a scalar, an SSSE3 and an AVX2 implementation; the
+/// fastest one supported by the CPU is selected at runtime on the first call.
+
+#ifndef BIOS_REVCOMP_H__
+#define BIOS_REVCOMP_H__
+
+#include <cstddef>
+
+#include "cpu.hh"
+
+namespace bios {
+
+namespace revcomp {
+
+/// @brief Returns the complement of a single base.
+char complement_base(char c);
+
+/// @brief Complements a sequence in place.
+///
+/// @param    dna        The sequence.
+/// @param    length     The number of bases.
+void complement(char* dna, size_t length);
+
+/// @brief Reverse-complements a sequence in place in a single pass.
+///
+/// @param    dna        The sequence.
+/// @param    length     The number of bases.
+void reverse_complement(char* dna, size_t length);
+
+// Individual implementations, exposed so that each one can be tested;
+// callers should use the functions above. The SSSE3 and AVX2 versions must
+// only be called if the CPU supports them.
+void complement_scalar(char* dna, size_t length);
+void reverse_complement_scalar(char* dna, size_t length);
+#ifdef BIOS_X86
+void complement_ssse3(char* dna, size_t length);
+void reverse_complement_ssse3(char* dna, size_t length);
+void complement_avx2(char* dna, size_t length);
+void reverse_complement_avx2(char* dna, size_t length);
+#endif
+
+}; // namespace revcomp
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
+#endif /* BIOS_REVCOMP_H__ */
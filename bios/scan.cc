@@ -0,0 +1,208 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file scan.cc
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// Vectorized routines for scanning large character buffers.
+
+#include "scan.hh"
+
+#ifdef BIOS_X86
+#include <immintrin.h>
+#endif
+
+namespace bios {
+
+namespace scan {
+
+const char* find_byte_scalar(const char* begin, const char* end, char c) {
+  for (const char* p = begin; p < end; ++p) {
+    if (*p == c) {
+      return p;
+    }
+  }
+  return end;
+}
+
+size_t find_all_bytes_scalar(const char* begin, const char* end, char c,
+                             uint32_t* positions, size_t max_positions) {
+  size_t count = 0;
+  for (const char* p = begin; p < end && count < max_positions; ++p) {
+    if (*p == c) {
+      positions[count++] = p - begin;
+    }
+  }
+  return count;
+}
+
+#ifdef BIOS_X86
+
+__attribute__((target("sse2")))
+const char* find_byte_sse2(const char* begin, const char* end, char c) {
+  const __m128i needle = _mm_set1_epi8(c);
+  const char* p = begin;
+  for (; end - p >= 16; p += 16) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+    if (mask != 0) {
+      return p + __builtin_ctz(mask);
+    }
+  }
+  return find_byte_scalar(p, end, c);
+}
+
+__attribute__((target("avx2")))
+const char* find_byte_avx2(const char* begin, const char* end, char c) {
+  const __m256i needle = _mm256_set1_epi8(c);
+  const char* p = begin;
+  // Check 64 bytes per iteration and only work out the exact position once
+  // either half has a hit.
+  for (; end - p >= 64; p += 64) {
+    __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+    __m256i lo_eq = _mm256_cmpeq_epi8(lo, needle);
+    __m256i hi_eq = _mm256_cmpeq_epi8(hi, needle);
+    if (!_mm256_testz_si256(_mm256_or_si256(lo_eq, hi_eq),
+                            _mm256_or_si256(lo_eq, hi_eq))) {
+      unsigned mask = _mm256_movemask_epi8(lo_eq);
+      if (mask != 0) {
+        return p + __builtin_ctz(mask);
+      }
+      return p + 32 + __builtin_ctz(_mm256_movemask_epi8(hi_eq));
+    }
+  }
+  for (; end - p >= 32; p += 32) {
+    __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    unsigned mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle));
+    if (mask != 0) {
+      return p + __builtin_ctz(mask);
+    }
+  }
+  return find_byte_scalar(p, end, c);
+}
+
+// Appends the positions of the set bits of a compare mask for the block at
+// offset. Returns false once positions is full.
+static inline bool add_mask_positions(unsigned mask, uint32_t offset,
+                                      uint32_t* positions, size_t* count,
+                                      size_t max_positions) {
+  while (mask != 0) {
+    if (*count == max_positions) {
+      return false;
+    }
+    positions[(*count)++] = offset + __builtin_ctz(mask);
+    mask &= mask - 1;
+  }
+  return true;
+}
+
+__attribute__((target("sse2")))
+size_t find_all_bytes_sse2(const char* begin, const char* end, char c,
+                           uint32_t* positions, size_t max_positions) {
+  const __m128i needle = _mm_set1_epi8(c);
+  const char* p = begin;
+  size_t count = 0;
+  for (; end - p >= 16; p += 16) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+    if (!add_mask_positions(mask, p - begin, positions, &count,
+                            max_positions)) {
+      return count;
+    }
+  }
+  size_t tail = find_all_bytes_scalar(p, end, c, positions + count,
+                                      max_positions - count);
+  for (size_t i = count; i < count + tail; ++i) {
+    positions[i] += p - begin;
+  }
+  return count + tail;
+}
+
+__attribute__((target("avx2")))
+size_t find_all_bytes_avx2(const char* begin, const char* end, char c,
+                           uint32_t* positions, size_t max_positions) {
+  const __m256i needle = _mm256_set1_epi8(c);
+  const char* p = begin;
+  size_t count = 0;
+  for (; end - p >= 32; p += 32) {
+    __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    unsigned mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle));
+    if (!add_mask_positions(mask, p - begin, positions, &count,
+                            max_positions)) {
+      return count;
+    }
+  }
+  size_t tail = find_all_bytes_scalar(p, end, c, positions + count,
+                                      max_positions - count);
+  for (size_t i = count; i < count + tail; ++i) {
+    positions[i] += p - begin;
+  }
+  return count + tail;
+}
+
+#endif // BIOS_X86
+
+typedef const char* (*FindByteFunction)(const char*, const char*, char);
+
+static FindByteFunction select_find_byte() {
+#ifdef BIOS_X86
+  if (cpu::has_avx2()) {
+    return find_byte_avx2;
+  }
+  if (cpu::has_sse2()) {
+    return find_byte_sse2;
+  }
+#endif
+  return find_byte_scalar;
+}
+
+// The implementation is selected on the first call. Initializing a
+// function-local static is thread-safe, and later calls only read it.
+const char* find_byte(const char* begin, const char* end, char c) {
+  static const FindByteFunction impl = select_find_byte();
+  return impl(begin, end, c);
+}
+
+typedef size_t (*FindAllBytesFunction)(const char*, const char*, char,
+                                       uint32_t*, size_t);
+
+static FindAllBytesFunction select_find_all_bytes() {
+#ifdef BIOS_X86
+  if (cpu::has_avx2()) {
+    return find_all_bytes_avx2;
+  }
+  if (cpu::has_sse2()) {
+    return find_all_bytes_sse2;
+  }
+#endif
+  return find_all_bytes_scalar;
+}
+
+size_t find_all_bytes(const char* begin, const char* end, char c,
+                      uint32_t* positions, size_t max_positions) {
+  static const FindAllBytesFunction impl = select_find_all_bytes();
+  return impl(begin, end, c, positions, max_positions);
+}
+
+}; // namespace scan
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
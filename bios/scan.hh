@@ -0,0 +1,93 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file scan.hh
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// Vectorized routines for scanning large character buffers. Each routine
+/// has a scalar, an SSE2 and an AVX2 implementation; the fastest one
+/// supported by the CPU is selected at runtime on the first call.
+
+#ifndef BIOS_SCAN_H__
+#define BIOS_SCAN_H__
+
+#include <cstddef>
+#include <stdint.h>
+
+#include "cpu.hh"
+
+namespace bios {
+
+namespace scan {
+
+/// @brief Returns a pointer to the first occurrence of c in [begin, end).
+///
+/// @param    begin      The start of the buffer.
+/// @param    end        One past the end of the buffer.
+/// @param    c          The character to search for.
+///
+/// @return   A pointer to the first occurrence of c, or end if c does not
+///           occur in the buffer.
+const char* find_byte(const char* begin, const char* end, char c);
+
+/// @brief Returns a pointer to the first newline in [begin, end), or end if
+///        there is none.
+static inline const char* find_newline(const char* begin, const char* end) {
+  return find_byte(begin, end, '\n');
+}
+
+/// @brief Records the positions of all occurrences of c in [begin, end).
+///
+/// @param    begin          The start of the buffer.
+/// @param    end            One past the end of the buffer.
+/// @param    c              The character to search for.
+/// @param    positions      Receives the offsets from begin of the matches,
+///                          in increasing order.
+/// @param    max_positions  The capacity of positions.
+///
+/// @return   The number of positions written. If it equals max_positions,
+///           there may be more matches after the last one.
+size_t find_all_bytes(const char* begin, const char* end, char c,
+                      uint32_t* positions, size_t max_positions);
+
+// Individual implementations of find_byte(). These are exposed so that each
+// one can be tested; callers should use find_byte(). The SSE2 and AVX2
+// versions must only be called if the CPU supports them.
+const char* find_byte_scalar(const char* begin, const char* end, char c);
+#ifdef BIOS_X86
+const char* find_byte_sse2(const char* begin, const char* end, char c);
+const char* find_byte_avx2(const char* begin, const char* end, char c);
+#endif
+
+// Individual implementations of find_all_bytes(), exposed for testing.
+size_t find_all_bytes_scalar(const char* begin, const char* end, char c,
+                             uint32_t* positions, size_t max_positions);
+#ifdef BIOS_X86
+size_t find_all_bytes_sse2(const char* begin, const char* end, char c,
+                           uint32_t* positions, size_t max_positions);
+size_t find_all_bytes_avx2(const char* begin, const char* end, char c,
+                           uint32_t* positions, size_t max_positions);
+#endif
+
+}; // namespace scan
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
+#endif /* BIOS_SCAN_H__ */
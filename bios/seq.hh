@@ -25,25 +25,44 @@
 #include "misc.hh"
 #include "number.hh"
 #include "bitfield.hh"
+#include "stringpiece.hh"
 
 namespace bios {
 
+/// A Seq owns its sequence buffer and mask and frees them when destroyed.
+/// It can be moved, which hands the buffers over, but not copied, so two
+/// Seqs never free the same buffer.
 struct Seq {
   Seq();
+  Seq(Seq&& other) noexcept;
+  Seq& operator=(Seq&& other) noexcept;
   ~Seq();
   BitField* MaskFromUpperCase(Seq* seq);
 
+  /// Takes ownership of a buffer allocated with malloc() that holds size
+  /// bases followed by a NUL, freeing the current sequence.
+  void AdoptSequence(char* buffer, uint32_t buffer_size);
+
+  /// Sets the name from a FASTA or FASTQ header line without its leading
+  /// '>' or '@'. If truncate_name is true, leading white space is skipped
+  /// and the name ends at the next white space.
+  void SetNameFromHeader(StringPiece header, bool truncate_name);
+
   // Name of sequence.
   std::string name;
 
-  // Sequence base by base.
+  // Sequence base by base, allocated with malloc().
   char *sequence;
 
   // Size of sequence.
   uint32_t size;
 
-  // Repeat mask (optional)
+  // Repeat mask (optional), allocated with new.
   BitField* mask;
+
+ private:
+  Seq(const Seq&);
+  void operator=(const Seq&);
 };
 
 // Preferred use if DNA
@@ -66,6 +85,9 @@ typedef char DNA;
 typedef char AA;
 typedef char Codon;
 
+/// Sequencer wraps the routines of the alphabet, revcomp and translate
+/// modules for existing callers. It holds no state; new code can call those
+/// modules directly and skip GetInstance().
 class Sequencer {
  public:
   static Sequencer& GetInstance() {
@@ -78,9 +100,6 @@ class Sequencer {
   aaSeq* TranslateSeq(dnaSeq* in_seq, unsigned offset, int stop);
   void ToRna(DNA* dna);
 
- private:
-  void DnaOrAaFilter(char* in, char* out, char filter[256]);
-
  public:
   void DnaFilter(char* in, DNA* out);
   void DnaMixedCaseFilter(char* in, DNA* out);
@@ -99,89 +118,9 @@ class Sequencer {
   bool SeqIsLower(Seq* seq);
 
  private:
-  Sequencer();
+  Sequencer() {}
   Sequencer(const Sequencer&);
   void operator=(const Sequencer&);
-
- private:
-  void InitNucleotideValues();
-
- private:
-  struct CodonRow {
-    const DNA* codon;   // Lower case.
-    AA protein_code;    // Upper case. The "Standard" code.
-    AA mito_code;       // Upper case. Vertibrate mitochondrial translations.
-  };
-
-  static Sequencer::CodonRow codon_table_[];
-
-  // A table that gives values:
-  //    0 for t
-  //    1 for c
-  //    2 for a
-  //    3 for g
-  // (which is order aa's are in biochemistry codon tables) and gives -1 for
-  // all others.
-  int nt_val_[256];
-
-  // Nucleotide values only for lower case.
-
-  int nt_val_lower_[256];
-
-  // Nucleotide values only for up9per case.
-  int nt_val_upper_[256];
-
-  // Like nt_val_ but with T_BASE_VAL in place of -1 for 'n', 'x', '-', etc.
-  int nt_val_5_[256];
-
-  // Like nt_val_, but with T_BASE_VAL in place of -1 for nonexistent ones.
-  int nt_val_no_n_[256];
-
-  // Inverse array - takes X_BASE_VAL int to a DNA char value.
-  DNA val_to_nt_[(N_BASE_VAL | MASKED_BASE_BIT) + 1];
-
-  // Arrays to convert between lower case indicating repeat masking, and a
-  // 1/2 byte representation where the 4th bit indicates if the character
-  // is masked. Uses N_BASE_VAL for `n', `x', etc.
-  int nt_val_masked_[256];
-
-  DNA val_to_nt_masked_[256];
-
- private:
-  void InitNucleotideChars();
-  void InitNucleotideMixedCaseChars();
-  void InitNucleotideCompareTable();
-
- private:
-  // A little array to help decide if a character is a nucleotide, and if so,
-  // convert it to lower case. Contains zeroes for characters that are not used
-  // in DNA sequence.
-  char nt_chars_[256];
-
-  // A similar array that doesn't convert to lower case.
-  char nt_mixed_case_chars_[256];
-
-  // Another array to help do complement of DNA.
-  DNA nt_comp_table_[256];
-
- private:
-  void InitAminoAcidValues();
-
- private:
-  struct AminoAcidRow {
-    int ix;
-    char letter;
-    char abbreviation[4];
-    const char *name;
-  };
-
-  static Sequencer::AminoAcidRow amino_acid_table_[];
-
-  // Tables to convert from 0-20 to ASCII single letter representation of
-  // amino acids.
-  int aa_val_[256];
-  AA val_to_aa_[20];
-  AA aa_chars_[256]; // 0 except for value aa characters. Converts to upper first.
 };
 
 }; // namespace bios
@@ -0,0 +1,147 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file shard.cc
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// Splitting of an input file into line- or record-aligned shards.
+
+#include "shard.hh"
+#include "gzip.hh"
+#include "scan.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace bios {
+
+// Returns the offset of the start of the line following the one that contains
+// offset, or size if that line is the last one.
+static size_t NextLineStart(const char* data, size_t size, size_t offset) {
+  const char* newline = scan::find_newline(data + offset, data + size);
+  return newline == data + size ? size : newline - data + 1;
+}
+
+FileSharder::FileSharder()
+    : map_(NULL),
+      map_size_(0) {
+}
+
+FileSharder::~FileSharder() {
+  Close();
+}
+
+void FileSharder::Close() {
+  if (map_ != NULL) {
+    munmap(map_, map_size_);
+    map_ = NULL;
+  }
+  map_size_ = 0;
+  shards_.clear();
+}
+
+bool FileSharder::Open(const char* filename, int num_shards,
+                       RecordFormat format) {
+  Close();
+  if (filename == NULL || num_shards < 1) {
+    return false;
+  }
+  int fd = open(filename, O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+    close(fd);
+    return false;
+  }
+  size_t size = st.st_size;
+  if (size > 0) {
+    void* map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED) {
+      close(fd);
+      return false;
+    }
+    map_ = static_cast<char*>(map);
+    map_size_ = size;
+  }
+  close(fd);
+  if (GzipReader::IsGzip(map_, map_size_)) {
+    Close();
+    return false;
+  }
+
+  size_t start = 0;
+  for (int i = 1; i <= num_shards; ++i) {
+    size_t end = map_size_;
+    if (i < num_shards) {
+      size_t target = map_size_ / num_shards * i;
+      end = NextBoundary(map_, map_size_, target > start ? target : start,
+                         format);
+    }
+    shards_.push_back(StringPiece(map_ + start, end - start));
+    start = end;
+  }
+  return true;
+}
+
+LineStream* FileSharder::OpenShard(int i) const {
+  return new MemoryLineStream(shards_[i]);
+}
+
+size_t FileSharder::NextBoundary(const char* data, size_t size, size_t offset,
+                                 RecordFormat format) {
+  if (offset == 0) {
+    return 0;
+  }
+  if (offset >= size) {
+    return size;
+  }
+  // The first line start at or after offset.
+  size_t line = NextLineStart(data, size, offset - 1);
+  for (; line < size; line = NextLineStart(data, size, line)) {
+    switch (format) {
+      case kLines:
+        return line;
+      case kFasta:
+        if (data[line] == '>') {
+          return line;
+        }
+        break;
+      case kFastq:
+        // A quality line may also start with '@', but then the line two
+        // below it is a sequence line, never a '+' separator.
+        if (data[line] == '@') {
+          size_t sequence = NextLineStart(data, size, line);
+          size_t separator = NextLineStart(data, size, sequence);
+          if (separator < size && data[separator] == '+') {
+            return line;
+          }
+        }
+        break;
+    }
+  }
+  return size;
+}
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
@@ -0,0 +1,102 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file shard.hh
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// Splitting of an input file into byte ranges that can be parsed
+/// independently, one per thread. Range boundaries fall on line starts, or
+/// on record starts for FASTA and FASTQ, so no line or record is cut in two.
+
+#ifndef BIOS_SHARD_H__
+#define BIOS_SHARD_H__
+
+#include <cstddef>
+#include <vector>
+
+#include "linestream.hh"
+#include "stringpiece.hh"
+
+namespace bios {
+
+/// @class FileSharder
+/// @brief Cuts a memory-mapped file into line- or record-aligned shards.
+///
+/// The file is mapped once and every shard is a view into the mapping, so
+/// the FileSharder must outlive the line streams opened on its shards.
+/// Compressed files cannot be sharded because their byte offsets do not
+/// correspond to offsets in the text.
+class FileSharder {
+ public:
+  enum RecordFormat {
+    kLines,   // Any line start is a boundary.
+    kFasta,   // Only lines starting with '>' are boundaries.
+    kFastq    // Only the '@' header line of a four-line record is a boundary.
+  };
+
+  FileSharder();
+  ~FileSharder();
+
+  /// @brief Maps a file and cuts it into num_shards shards.
+  ///
+  /// The shards are of roughly equal size. If the file has fewer records
+  /// than num_shards, some shards are empty.
+  ///
+  /// @param     filename    The name of the file.
+  /// @param     num_shards  The number of shards to cut the file into.
+  /// @param     format      Which line starts may begin a shard.
+  /// @return    true on success, false if the file could not be mapped or is
+  ///            compressed.
+  bool Open(const char* filename, int num_shards,
+            RecordFormat format = kLines);
+
+  /// @brief Returns the number of shards.
+  int num_shards() const { return shards_.size(); }
+
+  /// @brief Returns the text of shard i.
+  StringPiece shard(int i) const { return shards_[i]; }
+
+  /// @brief Returns the byte offset of shard i in the file.
+  size_t shard_offset(int i) const { return shards_[i].data() - map_; }
+
+  /// @brief Opens a line stream over shard i. The caller owns the stream.
+  LineStream* OpenShard(int i) const;
+
+  /// @brief Returns the offset of the first boundary at or after offset.
+  ///
+  /// This is exposed for testing and for callers that cut ranges of their
+  /// own. Returns size if there is no boundary after offset.
+  static size_t NextBoundary(const char* data, size_t size, size_t offset,
+                             RecordFormat format);
+
+ private:
+  void Close();
+
+  char* map_;
+  size_t map_size_;
+  std::vector<StringPiece> shards_;
+
+  FileSharder(const FileSharder&);
+  void operator=(const FileSharder&);
+};
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
+#endif /* BIOS_SHARD_H__ */
@@ -0,0 +1,166 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file stringpiece.hh
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// A StringPiece is a non-owning (pointer, length) view into a character
+/// buffer owned by someone else, such as a memory-mapped file or the block
+/// buffer of a LineStream. It allows lines and fields to be handed out
+/// without copying them into a std::string.
+///
+/// The data pointed to by a StringPiece is not NUL-terminated in general, so
+/// it must not be passed to functions that expect a C string.
+
+#ifndef BIOS_STRINGPIECE_H__
+#define BIOS_STRINGPIECE_H__
+
+#include <cstring>
+#include <string>
+#include <iostream>
+
+namespace bios {
+
+/// @class StringPiece
+/// @brief Non-owning view of a contiguous sequence of characters.
+class StringPiece {
+ public:
+  StringPiece()
+      : data_(NULL), size_(0) {
+  }
+
+  StringPiece(const char* data, size_t size)
+      : data_(data), size_(size) {
+  }
+
+  StringPiece(const char* str)
+      : data_(str), size_(str == NULL ? 0 : strlen(str)) {
+  }
+
+  StringPiece(const std::string& str)
+      : data_(str.data()), size_(str.size()) {
+  }
+
+  const char* data() const { return data_; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  const char* begin() const { return data_; }
+  const char* end() const { return data_ + size_; }
+
+  char operator[](size_t i) const { return data_[i]; }
+
+  void set(const char* data, size_t size) {
+    data_ = data;
+    size_ = size;
+  }
+
+  void clear() {
+    data_ = NULL;
+    size_ = 0;
+  }
+
+  /// @brief Drops the first n characters from the view.
+  void remove_prefix(size_t n) {
+    data_ += n;
+    size_ -= n;
+  }
+
+  /// @brief Drops the last n characters from the view.
+  void remove_suffix(size_t n) {
+    size_ -= n;
+  }
+
+  /// @brief Returns whether the view begins with the given prefix.
+  bool starts_with(const StringPiece& prefix) const {
+    return size_ >= prefix.size_ &&
+        memcmp(data_, prefix.data_, prefix.size_) == 0;
+  }
+
+  /// @brief Returns the index of the first occurrence of c at or after pos,
+  ///        or npos if c does not occur.
+  size_t find(char c, size_t pos = 0) const {
+    if (pos >= size_) {
+      return npos;
+    }
+    const void* hit = memchr(data_ + pos, c, size_ - pos);
+    return hit == NULL ? npos : static_cast<const char*>(hit) - data_;
+  }
+
+  /// @brief Returns a view of at most n characters starting at pos.
+  StringPiece substr(size_t pos, size_t n = npos) const {
+    if (pos > size_) {
+      pos = size_;
+    }
+    if (n > size_ - pos) {
+      n = size_ - pos;
+    }
+    return StringPiece(data_ + pos, n);
+  }
+
+  /// @brief Returns a copy of the viewed characters as a std::string.
+  std::string ToString() const {
+    return empty() ? std::string() : std::string(data_, size_);
+  }
+
+  /// @brief Copies the viewed characters into target, replacing its contents.
+  void CopyToString(std::string* target) const {
+    target->assign(data_, size_);
+  }
+
+  int compare(const StringPiece& other) const {
+    size_t n = size_ < other.size_ ? size_ : other.size_;
+    int r = n == 0 ? 0 : memcmp(data_, other.data_, n);
+    if (r != 0) {
+      return r;
+    }
+    if (size_ < other.size_) {
+      return -1;
+    }
+    return size_ > other.size_ ? 1 : 0;
+  }
+
+  static const size_t npos = static_cast<size_t>(-1);
+
+ private:
+  const char* data_;
+  size_t size_;
+};
+
+inline bool operator==(const StringPiece& a, const StringPiece& b) {
+  return a.size() == b.size() &&
+      (a.size() == 0 || memcmp(a.data(), b.data(), a.size()) == 0);
+}
+
+inline bool operator!=(const StringPiece& a, const StringPiece& b) {
+  return !(a == b);
+}
+
+inline bool operator<(const StringPiece& a, const StringPiece& b) {
+  return a.compare(b) < 0;
+}
+
+inline std::ostream& operator<<(std::ostream& o, const StringPiece& piece) {
+  o.write(piece.data(), piece.size());
+  return o;
+}
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
+#endif /* BIOS_STRINGPIECE_H__ */
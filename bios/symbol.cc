@@ -0,0 +1,143 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file symbol.cc
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// Implementation of the reference name symbol table.
+
+#include "symbol.hh"
+
+#include <iostream>
+
+namespace bios {
+
+const uint32_t SymbolTable::kEmptySymbol;
+const uint32_t SymbolTable::kNoSymbol;
+const int SymbolTable::kChunkBits;
+const uint32_t SymbolTable::kChunkSize;
+const uint32_t SymbolTable::kMaxChunks;
+
+static const uint32_t kInitialSlots = 64;
+
+/// FNV-1a. Reference names are short, so anything fancier does not pay off.
+static uint32_t HashName(const StringPiece& name) {
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < name.size(); ++i) {
+    hash ^= static_cast<unsigned char>(name[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+SymbolTable::SymbolTable()
+    : slots_(kInitialSlots, kNoSymbol),
+      size_(0) {
+  for (uint32_t i = 0; i < kMaxChunks; ++i) {
+    chunks_[i] = NULL;
+  }
+  Intern(StringPiece());
+}
+
+SymbolTable::~SymbolTable() {
+  for (uint32_t i = 0; i < kMaxChunks; ++i) {
+    delete[] chunks_[i];
+  }
+}
+
+SymbolTable* SymbolTable::Global() {
+  // Never destroyed, so records held in static storage can still look up
+  // their names during shutdown.
+  static SymbolTable* table = new SymbolTable();
+  return table;
+}
+
+uint32_t SymbolTable::FindSlot(const StringPiece& name, uint32_t hash) const {
+  uint32_t mask = slots_.size() - 1;
+  uint32_t slot = hash & mask;
+  while (slots_[slot] != kNoSymbol) {
+    uint32_t id = slots_[slot];
+    if (hashes_[id] == hash && Name(id) == name) {
+      break;
+    }
+    slot = (slot + 1) & mask;
+  }
+  return slot;
+}
+
+void SymbolTable::Grow() {
+  std::vector<uint32_t> slots(slots_.size() * 2, kNoSymbol);
+  uint32_t mask = slots.size() - 1;
+  for (uint32_t id = 0; id < size_; ++id) {
+    uint32_t slot = hashes_[id] & mask;
+    while (slots[slot] != kNoSymbol) {
+      slot = (slot + 1) & mask;
+    }
+    slots[slot] = id;
+  }
+  slots_.swap(slots);
+}
+
+uint32_t SymbolTable::Intern(const StringPiece& name) {
+  MutexLock lock(&mutex_);
+  uint32_t hash = HashName(name);
+  uint32_t slot = FindSlot(name, hash);
+  if (slots_[slot] != kNoSymbol) {
+    return slots_[slot];
+  }
+
+  uint32_t id = size_;
+  uint32_t chunk = id >> kChunkBits;
+  if (chunk >= kMaxChunks) {
+    std::cerr << "Symbol table is full; cannot add " << name << std::endl;
+    return kNoSymbol;
+  }
+  if (chunks_[chunk] == NULL) {
+    chunks_[chunk] = new std::string[kChunkSize];
+  }
+  name.CopyToString(&chunks_[chunk][id & (kChunkSize - 1)]);
+  hashes_.push_back(hash);
+  slots_[slot] = id;
+  ++size_;
+
+  // Keep the load factor at or below one half so probe sequences stay short.
+  if (size_ * 2 > slots_.size()) {
+    Grow();
+  }
+  return id;
+}
+
+bool SymbolTable::Find(const StringPiece& name, uint32_t* id) const {
+  MutexLock lock(&mutex_);
+  uint32_t slot = FindSlot(name, HashName(name));
+  if (slots_[slot] == kNoSymbol) {
+    return false;
+  }
+  *id = slots_[slot];
+  return true;
+}
+
+size_t SymbolTable::size() const {
+  MutexLock lock(&mutex_);
+  return size_;
+}
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
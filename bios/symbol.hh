@@ -0,0 +1,152 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file symbol.hh
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// A process-wide symbol table that maps reference sequence names
+/// (chromosomes, contigs, BLAT targets) to dense integer IDs. Records store
+/// the 32-bit ID rather than their own copy of the name, so a file with
+/// millions of lines on a handful of chromosomes keeps one copy of each name,
+/// and testing whether two records are on the same reference is an integer
+/// compare.
+///
+/// IDs are handed out in order of first appearance, so they are NOT ordered
+/// like the names. Comparators that sort by reference name must fall back to
+/// comparing the names when the IDs differ; see SymbolTable::Compare().
+
+#ifndef BIOS_SYMBOL_H__
+#define BIOS_SYMBOL_H__
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include "stringpiece.hh"
+#include "thread.hh"
+
+namespace bios {
+
+/// @class SymbolTable
+/// @brief Interns reference names and maps them to dense integer IDs.
+///
+/// Intern() and Find() are serialized by a mutex. Name() does not lock: the
+/// storage for a name never moves once it has been interned, so any thread
+/// that has been handed an ID may look up its name.
+class SymbolTable {
+ public:
+  /// ID of the empty name. Default-constructed records use this ID.
+  static const uint32_t kEmptySymbol = 0;
+
+  /// Stored by records whose name has not been interned, and returned by
+  /// Intern() when the table is full.
+  static const uint32_t kNoSymbol = 0xffffffffu;
+
+  SymbolTable();
+  ~SymbolTable();
+
+  /// @brief Returns the table shared by all parsers in the process.
+  static SymbolTable* Global();
+
+  /// @brief Returns the ID of name, adding it to the table if it has not been
+  ///        seen before.
+  ///
+  /// @return   The ID of name, or kNoSymbol if the table is full.
+  uint32_t Intern(const StringPiece& name);
+
+  /// @brief Looks up name without adding it.
+  ///
+  /// @return   true if name has been interned, in which case its ID is stored
+  ///           in id, false otherwise.
+  bool Find(const StringPiece& name, uint32_t* id) const;
+
+  /// @brief Returns the name with the given ID, which must have been
+  ///        returned by Intern(). kNoSymbol is named by the empty name, so
+  ///        records whose name did not fit in a full table stay printable.
+  const std::string& Name(uint32_t id) const {
+    if (id == kNoSymbol) {
+      id = kEmptySymbol;
+    }
+    return chunks_[id >> kChunkBits][id & (kChunkSize - 1)];
+  }
+
+  /// @brief Compares the names with the given IDs lexicographically, like
+  ///        strcmp(). Equal IDs are answered without touching the names;
+  ///        kNoSymbol compares like the empty name.
+  int Compare(uint32_t a, uint32_t b) const {
+    return a == b ? 0 : Name(a).compare(Name(b));
+  }
+
+  /// @brief Returns the number of interned names, including the empty name.
+  size_t size() const;
+
+  static const int kChunkBits = 10;
+  static const uint32_t kChunkSize = 1u << kChunkBits;
+  static const uint32_t kMaxChunks = 4096;
+
+ private:
+  SymbolTable(const SymbolTable&);
+  void operator=(const SymbolTable&);
+
+  uint32_t FindSlot(const StringPiece& name, uint32_t hash) const;
+  void Grow();
+
+  /// Names are stored in fixed-size chunks that are never reallocated, so
+  /// references returned by Name() stay valid as the table grows.
+  std::string* chunks_[kMaxChunks];
+  std::vector<uint32_t> hashes_;
+
+  /// Open-addressing hash table of IDs; kNoSymbol marks an empty slot.
+  std::vector<uint32_t> slots_;
+  uint32_t size_;
+  mutable Mutex mutex_;
+};
+
+/// @class SymbolCache
+/// @brief Remembers the last name interned through it.
+///
+/// Reference names in sorted or clustered input repeat line after line, so a
+/// parser that keeps one of these skips hashing and locking for all but the
+/// first line on each reference.
+class SymbolCache {
+ public:
+  explicit SymbolCache(SymbolTable* table = SymbolTable::Global())
+      : table_(table), last_id_(SymbolTable::kNoSymbol) {
+  }
+
+  uint32_t Intern(const StringPiece& name) {
+    if (last_id_ == SymbolTable::kNoSymbol || name != last_name_) {
+      last_id_ = table_->Intern(name);
+      name.CopyToString(&last_name_);
+    }
+    return last_id_;
+  }
+
+  SymbolTable* table() const { return table_; }
+
+ private:
+  SymbolTable* table_;
+  std::string last_name_;
+  uint32_t last_id_;
+};
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
+#endif /* BIOS_SYMBOL_H__ */
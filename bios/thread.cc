@@ -0,0 +1,66 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file thread.cc
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// Thin wrappers around POSIX threads.
+
+#include "thread.hh"
+
+#include <unistd.h>
+
+namespace bios {
+
+Thread::Thread()
+    : started_(false) {
+}
+
+Thread::~Thread() {
+  Join();
+}
+
+void* Thread::Entry(void* arg) {
+  static_cast<Thread*>(arg)->Run();
+  return NULL;
+}
+
+bool Thread::Start() {
+  if (started_) {
+    return false;
+  }
+  started_ = (pthread_create(&thread_, NULL, Thread::Entry, this) == 0);
+  return started_;
+}
+
+void Thread::Join() {
+  if (started_) {
+    pthread_join(thread_, NULL);
+    started_ = false;
+  }
+}
+
+int Thread::NumProcessors() {
+  long count = sysconf(_SC_NPROCESSORS_ONLN);
+  return count > 0 ? static_cast<int>(count) : 1;
+}
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
@@ -0,0 +1,119 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file thread.hh
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// Thin wrappers around POSIX threads, mutexes and condition variables.
+
+#ifndef BIOS_THREAD_H__
+#define BIOS_THREAD_H__
+
+#include <pthread.h>
+
+namespace bios {
+
+/// @class Mutex
+/// @brief A non-recursive mutex.
+class Mutex {
+ public:
+  Mutex() { pthread_mutex_init(&mutex_, NULL); }
+  ~Mutex() { pthread_mutex_destroy(&mutex_); }
+
+  void Lock() { pthread_mutex_lock(&mutex_); }
+  void Unlock() { pthread_mutex_unlock(&mutex_); }
+
+ private:
+  Mutex(const Mutex&);
+  void operator=(const Mutex&);
+
+  friend class CondVar;
+  pthread_mutex_t mutex_;
+};
+
+/// @class MutexLock
+/// @brief Holds a mutex for the lifetime of the object.
+class MutexLock {
+ public:
+  explicit MutexLock(Mutex* mutex) : mutex_(mutex) { mutex_->Lock(); }
+  ~MutexLock() { mutex_->Unlock(); }
+
+ private:
+  MutexLock(const MutexLock&);
+  void operator=(const MutexLock&);
+
+  Mutex* mutex_;
+};
+
+/// @class CondVar
+/// @brief A condition variable used together with a Mutex.
+class CondVar {
+ public:
+  CondVar() { pthread_cond_init(&cond_, NULL); }
+  ~CondVar() { pthread_cond_destroy(&cond_); }
+
+  /// @brief Atomically releases the mutex and waits to be signalled. The
+  ///        mutex is held again when this method returns.
+  void Wait(Mutex* mutex) { pthread_cond_wait(&cond_, &mutex->mutex_); }
+  void Signal() { pthread_cond_signal(&cond_); }
+  void SignalAll() { pthread_cond_broadcast(&cond_); }
+
+ private:
+  CondVar(const CondVar&);
+  void operator=(const CondVar&);
+
+  pthread_cond_t cond_;
+};
+
+/// @class Thread
+/// @brief Base class for a thread of execution. Subclasses implement Run().
+class Thread {
+ public:
+  Thread();
+  virtual ~Thread();
+
+  /// @brief Starts running Run() on a new thread.
+  ///
+  /// @return   true if the thread was started, false otherwise.
+  bool Start();
+
+  /// @brief Waits for Run() to return. Does nothing if the thread was not
+  ///        started.
+  void Join();
+
+  /// @brief Returns the number of processors currently online.
+  static int NumProcessors();
+
+ protected:
+  virtual void Run() = 0;
+
+ private:
+  Thread(const Thread&);
+  void operator=(const Thread&);
+
+  static void* Entry(void* arg);
+
+  pthread_t thread_;
+  bool started_;
+};
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
+#endif /* BIOS_THREAD_H__ */
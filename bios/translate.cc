@@ -0,0 +1,277 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file translate.cc
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// Implementation of the six-frame translation engine.
+
+#include "translate.hh"
+#include "alphabet.hh"
+#include "seq.hh"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef BIOS_X86
+#include <immintrin.h>
+#endif
+
+namespace bios {
+
+namespace translate {
+
+// Codons are translated in chunks of this many, a multiple of three, with
+// their bases encoded into a buffer on the stack.
+static const size_t kChunkSize = 4095;
+
+// A codon index holds the 3-bit codes of three bases, first base highest.
+static const int kCodonIndexBits = 9;
+static const int kNumCodonIndexes = 1 << kCodonIndexBits;
+
+namespace {
+
+struct CodonTables {
+  CodonTables() {
+    memset(base_code, N_BASE_VAL, sizeof(base_code));
+    const char bases[] = "TCAGU";
+    const uint8_t vals[] = {T_BASE_VAL, C_BASE_VAL, A_BASE_VAL, G_BASE_VAL,
+                            U_BASE_VAL};
+    for (int i = 0; i < 5; ++i) {
+      base_code[static_cast<uint8_t>(bases[i])] = vals[i];
+      base_code[static_cast<uint8_t>(bases[i] | 0x20)] = vals[i];
+    }
+
+    // Fill every index, including those with an invalid code in them, from
+    // the codon table.
+    for (int code = 0; code < 2; ++code) {
+      memset(forward[code], 'X', kNumCodonIndexes);
+      memset(reverse[code], 'X', kNumCodonIndexes);
+    }
+    for (int val = 0; val < 64; ++val) {
+      const char* codon = alphabet::val_to_codon(val);
+      char aa[2] = {alphabet::lookup_codon(codon),
+                    alphabet::lookup_mitochondrial_codon(codon)};
+      int b0 = val >> 4;
+      int b1 = (val >> 2) & 3;
+      int b2 = val & 3;
+      // Complementing a 2-bit base value swaps T/A and C/G.
+      int forward_index = (b0 << 6) | (b1 << 3) | b2;
+      int reverse_index = ((b2 ^ 2) << 6) | ((b1 ^ 2) << 3) | (b0 ^ 2);
+      for (int code = 0; code < 2; ++code) {
+        char c = aa[code] == 0 ? '*' : aa[code];
+        forward[code][forward_index] = c;
+        reverse[code][reverse_index] = c;
+      }
+    }
+  }
+
+  uint8_t base_code[256];
+  // Amino acids by codon index for each genetic code, for the codon read
+  // forward and for its reverse complement.
+  char forward[2][kNumCodonIndexes];
+  char reverse[2][kNumCodonIndexes];
+};
+
+}  // namespace
+
+static const CodonTables& Tables() {
+  static const CodonTables tables;
+  return tables;
+}
+
+void encode_bases_scalar(const char* dna, size_t length, uint8_t* codes) {
+  const uint8_t* base_code = Tables().base_code;
+  for (size_t i = 0; i < length; ++i) {
+    codes[i] = base_code[static_cast<uint8_t>(dna[i])];
+  }
+}
+
+#ifdef BIOS_X86
+
+// Both kernels fold each byte to upper case and look up its low nibble in
+// two tables: one giving the only byte with that low nibble that is a base,
+// and one giving that base's code. A byte is a base if it equals the first
+// lookup; non-letters may fold onto letters, but never onto a base.
+static const char kExpectedBase[16] = {
+  -1, 'A', -1, 'C', 'T', 'U', -1, 'G', -1, -1, -1, -1, -1, -1, -1, -1,
+};
+static const char kBaseCode[16] = {
+  N_BASE_VAL, A_BASE_VAL, N_BASE_VAL, C_BASE_VAL,
+  T_BASE_VAL, U_BASE_VAL, N_BASE_VAL, G_BASE_VAL,
+  N_BASE_VAL, N_BASE_VAL, N_BASE_VAL, N_BASE_VAL,
+  N_BASE_VAL, N_BASE_VAL, N_BASE_VAL, N_BASE_VAL,
+};
+
+__attribute__((target("ssse3")))
+void encode_bases_ssse3(const char* dna, size_t length, uint8_t* codes) {
+  const __m128i expected_base = _mm_loadu_si128(
+      reinterpret_cast<const __m128i*>(kExpectedBase));
+  const __m128i base_code = _mm_loadu_si128(
+      reinterpret_cast<const __m128i*>(kBaseCode));
+  const __m128i fold = _mm_set1_epi8(static_cast<char>(0xdf));
+  const __m128i low_bits = _mm_set1_epi8(0x0f);
+  const __m128i invalid = _mm_set1_epi8(N_BASE_VAL);
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    __m128i v = _mm_and_si128(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(dna + i)), fold);
+    __m128i lo = _mm_and_si128(v, low_bits);
+    __m128i is_base = _mm_cmpeq_epi8(_mm_shuffle_epi8(expected_base, lo), v);
+    __m128i code = _mm_or_si128(
+        _mm_and_si128(is_base, _mm_shuffle_epi8(base_code, lo)),
+        _mm_andnot_si128(is_base, invalid));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(codes + i), code);
+  }
+  encode_bases_scalar(dna + i, length - i, codes + i);
+}
+
+__attribute__((target("avx2")))
+void encode_bases_avx2(const char* dna, size_t length, uint8_t* codes) {
+  const __m256i expected_base = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+      reinterpret_cast<const __m128i*>(kExpectedBase)));
+  const __m256i base_code = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+      reinterpret_cast<const __m128i*>(kBaseCode)));
+  const __m256i fold = _mm256_set1_epi8(static_cast<char>(0xdf));
+  const __m256i low_bits = _mm256_set1_epi8(0x0f);
+  const __m256i invalid = _mm256_set1_epi8(N_BASE_VAL);
+  size_t i = 0;
+  for (; i + 32 <= length; i += 32) {
+    __m256i v = _mm256_and_si256(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dna + i)), fold);
+    __m256i lo = _mm256_and_si256(v, low_bits);
+    __m256i is_base = _mm256_cmpeq_epi8(
+        _mm256_shuffle_epi8(expected_base, lo), v);
+    __m256i code = _mm256_blendv_epi8(
+        invalid, _mm256_shuffle_epi8(base_code, lo), is_base);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(codes + i), code);
+  }
+  encode_bases_ssse3(dna + i, length - i, codes + i);
+}
+
+#endif // BIOS_X86
+
+typedef void (*EncodeBasesFunction)(const char*, size_t, uint8_t*);
+
+static EncodeBasesFunction select_encode_bases() {
+#ifdef BIOS_X86
+  if (cpu::has_avx2()) {
+    return encode_bases_avx2;
+  }
+  if (cpu::has_ssse3()) {
+    return encode_bases_ssse3;
+  }
+#endif
+  return encode_bases_scalar;
+}
+
+// The implementation is selected on the first call, as in scan.cc.
+void encode_bases(const char* dna, size_t length, uint8_t* codes) {
+  static const EncodeBasesFunction impl = select_encode_bases();
+  impl(dna, length, codes);
+}
+
+static inline int codon_index(const uint8_t* codes) {
+  return (codes[0] << 6) | (codes[1] << 3) | codes[2];
+}
+
+size_t frame_size(size_t length, int frame) {
+  size_t offset = frame % 3;
+  return length > offset ? (length - offset) / 3 : 0;
+}
+
+void six_frames(const char* dna, size_t length, GeneticCode code,
+                char* const frames[6]) {
+  if (length < 3) {
+    return;
+  }
+  const CodonTables& tables = Tables();
+  const char* forward = tables.forward[code];
+  const char* reverse = tables.reverse[code];
+
+  // The codon starting at base s is codon s / 3 of forward frame s % 3, and
+  // codon (length - 3 - s) / 3 of reverse frame (length - 3 - s) % 3. So the
+  // forward frames fill from the front and the reverse frames from the
+  // back, and each phase of s always goes to the same reverse frame.
+  char* forward0 = frames[0];
+  char* forward1 = frames[1];
+  char* forward2 = frames[2];
+  char* reverse_end[3];
+  for (int phase = 0; phase < 3; ++phase) {
+    int frame = 3 + (length - phase) % 3;
+    reverse_end[phase] = frames[frame] + frame_size(length, frame);
+  }
+  char* reverse0 = reverse_end[0];
+  char* reverse1 = reverse_end[1];
+  char* reverse2 = reverse_end[2];
+
+  // Each chunk encodes the bases of its codons, so the last two bases of a
+  // chunk are encoded again at the start of the next.
+  uint8_t codes[kChunkSize + 2];
+  size_t num_codons = length - 2;
+  for (size_t start = 0; start < num_codons; start += kChunkSize) {
+    size_t count = std::min(kChunkSize, num_codons - start);
+    encode_bases(dna + start, count + 2, codes);
+    size_t j = 0;
+    for (; j + 3 <= count; j += 3) {
+      int index0 = codon_index(codes + j);
+      int index1 = codon_index(codes + j + 1);
+      int index2 = codon_index(codes + j + 2);
+      *forward0++ = forward[index0];
+      *forward1++ = forward[index1];
+      *forward2++ = forward[index2];
+      *--reverse0 = reverse[index0];
+      *--reverse1 = reverse[index1];
+      *--reverse2 = reverse[index2];
+    }
+    // Only the last chunk can end part way through a group of three.
+    if (j < count) {
+      int index0 = codon_index(codes + j);
+      *forward0++ = forward[index0];
+      *--reverse0 = reverse[index0];
+    }
+    if (j + 1 < count) {
+      int index1 = codon_index(codes + j + 1);
+      *forward1++ = forward[index1];
+      *--reverse1 = reverse[index1];
+    }
+  }
+}
+
+size_t translate_frame(const char* dna, size_t length, GeneticCode code,
+                       char* out) {
+  const char* forward = Tables().forward[code];
+  size_t size = length / 3;
+  uint8_t codes[kChunkSize];
+  for (size_t codon = 0; codon < size; ) {
+    size_t chunk_codons = std::min(kChunkSize / 3, size - codon);
+    encode_bases(dna + 3 * codon, 3 * chunk_codons, codes);
+    for (size_t k = 0; k < chunk_codons; ++k) {
+      out[codon + k] = forward[codon_index(codes + 3 * k)];
+    }
+    codon += chunk_codons;
+  }
+  return size;
+}
+
+}; // namespace translate
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
@@ -0,0 +1,95 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file translate.hh
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// Translation of nucleotide sequences to amino acids. six_frames()
+/// translates the three forward and three reverse frames of a sequence in a
+/// single pass: the bases are first encoded to 3-bit codes with vector
+/// instructions, and each codon's codes then index precomputed tables that
+/// give the amino acid for the codon on the forward strand and for its
+/// reverse complement.
+///
+/// Amino acids are written as upper-case one-letter codes, stop codons as
+/// '*', and codons containing anything but ACGTU (in either case) as 'X'.
+/// The output is not NUL-terminated.
+
+#ifndef BIOS_TRANSLATE_H__
+#define BIOS_TRANSLATE_H__
+
+#include <cstddef>
+#include <stdint.h>
+
+#include "cpu.hh"
+
+namespace bios {
+
+namespace translate {
+
+/// The genetic codes in the codon table of alphabet.cc.
+enum GeneticCode {
+  kStandardCode = 0,
+  kMitochondrialCode = 1,  // Vertebrate mitochondrial.
+};
+
+/// @brief Returns the number of amino acids in a frame of a sequence.
+///
+/// @param    length     The number of bases in the sequence.
+/// @param    frame      0-2 for the forward frames starting at that offset,
+///                      3-5 for the frames starting at offset frame - 3 of
+///                      the reverse complement.
+size_t frame_size(size_t length, int frame);
+
+/// @brief Translates all six frames of a sequence.
+///
+/// @param    dna        The sequence.
+/// @param    length     The number of bases.
+/// @param    code       The genetic code to use.
+/// @param    frames     Six output buffers, numbered as in frame_size();
+///                      frames[i] must have room for frame_size(length, i)
+///                      characters.
+void six_frames(const char* dna, size_t length, GeneticCode code,
+                char* const frames[6]);
+
+/// @brief Translates the forward frame starting at the first base.
+///
+/// @param    out        Must have room for length / 3 characters.
+/// @return   The number of amino acids written, length / 3.
+size_t translate_frame(const char* dna, size_t length, GeneticCode code,
+                       char* out);
+
+/// @brief Encodes bases as T=0, C=1, A=2, G=3 (U as T) and anything else
+///        as 4.
+void encode_bases(const char* dna, size_t length, uint8_t* codes);
+
+// Individual implementations of encode_bases(), exposed for testing. The
+// SSSE3 and AVX2 versions must only be called if the CPU supports them.
+void encode_bases_scalar(const char* dna, size_t length, uint8_t* codes);
+#ifdef BIOS_X86
+void encode_bases_ssse3(const char* dna, size_t length, uint8_t* codes);
+void encode_bases_avx2(const char* dna, size_t length, uint8_t* codes);
+#endif
+
+}; // namespace translate
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
+#endif /* BIOS_TRANSLATE_H__ */
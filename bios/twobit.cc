@@ -0,0 +1,326 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file twobit.cc
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// Implementation of the memory-mapped .2bit reader.
+
+#include "twobit.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace bios {
+
+static const uint32_t kTwoBitSignature = 0x1A412743;
+static const uint32_t kHeaderSize = 16;
+
+TwoBitReader::TwoBitReader()
+    : map_(NULL),
+      map_size_(0),
+      swap_(false) {
+}
+
+TwoBitReader::~TwoBitReader() {
+  Close();
+}
+
+void TwoBitReader::Close() {
+  if (map_ != NULL) {
+    munmap(const_cast<uint8_t*>(map_), map_size_);
+    map_ = NULL;
+  }
+  map_size_ = 0;
+  swap_ = false;
+  sequences_.clear();
+  index_.clear();
+}
+
+uint32_t TwoBitReader::ReadUint32(size_t offset) const {
+  uint32_t value;
+  memcpy(&value, map_ + offset, sizeof(value));
+  return swap_ ? __builtin_bswap32(value) : value;
+}
+
+bool TwoBitReader::Open(const char* filename) {
+  Close();
+  int fd = open(filename, O_RDONLY);
+  if (fd < 0) {
+    std::cerr << "Cannot open " << filename << std::endl;
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) ||
+      static_cast<size_t>(st.st_size) < kHeaderSize) {
+    std::cerr << filename << " is not a .2bit file" << std::endl;
+    close(fd);
+    return false;
+  }
+  void* map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) {
+    std::cerr << "Cannot map " << filename << std::endl;
+    return false;
+  }
+  map_ = static_cast<const uint8_t*>(map);
+  map_size_ = st.st_size;
+  // Region fetches jump around the file; do not read ahead.
+  madvise(map, map_size_, MADV_RANDOM);
+
+  uint32_t signature = ReadUint32(0);
+  if (signature != kTwoBitSignature) {
+    swap_ = true;
+    if (ReadUint32(0) != kTwoBitSignature) {
+      std::cerr << filename << " is not a .2bit file" << std::endl;
+      Close();
+      return false;
+    }
+  }
+  uint32_t version = ReadUint32(4);
+  if (version > 1) {
+    std::cerr << "Unsupported .2bit version " << version << " in "
+              << filename << std::endl;
+    Close();
+    return false;
+  }
+  uint32_t count = ReadUint32(8);
+
+  // Version 1 files use 64-bit record offsets.
+  size_t offset_size = version == 1 ? 8 : 4;
+  size_t pos = kHeaderSize;
+  // Each index entry holds at least a name length and an offset; check the
+  // count against the file before allocating for it.
+  if (count > (map_size_ - kHeaderSize) / (1 + offset_size)) {
+    std::cerr << "Truncated .2bit index in " << filename << std::endl;
+    Close();
+    return false;
+  }
+  sequences_.resize(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    Sequence& sequence = sequences_[i];
+    if (pos + 1 > map_size_ || pos + 1 + map_[pos] + offset_size > map_size_) {
+      std::cerr << "Truncated .2bit index in " << filename << std::endl;
+      Close();
+      return false;
+    }
+    size_t name_size = map_[pos];
+    sequence.name.assign(reinterpret_cast<const char*>(map_ + pos + 1),
+                         name_size);
+    pos += 1 + name_size;
+    uint64_t offset = ReadUint32(pos);
+    if (offset_size == 8) {
+      uint64_t high = ReadUint32(pos + 4);
+      offset = swap_ ? (offset << 32) | high : offset | (high << 32);
+    }
+    pos += offset_size;
+    if (!ReadRecord(offset, &sequence)) {
+      std::cerr << "Bad .2bit record for " << sequence.name << " in "
+                << filename << std::endl;
+      Close();
+      return false;
+    }
+    index_[sequence.name] = i;
+  }
+  return true;
+}
+
+bool TwoBitReader::ReadRecord(size_t offset, Sequence* sequence) {
+  // dnaSize, nBlockCount, nBlockStarts, nBlockSizes, maskBlockCount,
+  // maskBlockStarts, maskBlockSizes, reserved, packedDna.
+  if (offset > map_size_ || map_size_ - offset < 8) {
+    return false;
+  }
+  sequence->size = ReadUint32(offset);
+  BlockList* lists[] = {&sequence->n_blocks, &sequence->mask_blocks};
+  size_t pos = offset + 4;
+  for (int i = 0; i < 2; ++i) {
+    if (map_size_ - pos < 4) {
+      return false;
+    }
+    uint32_t count = ReadUint32(pos);
+    pos += 4;
+    if ((map_size_ - pos) / 8 < count) {
+      return false;
+    }
+    lists[i]->count = count;
+    lists[i]->starts = pos;
+    lists[i]->sizes = pos + 4 * static_cast<size_t>(count);
+    pos += 8 * static_cast<size_t>(count);
+  }
+  pos += 4;  // reserved
+  size_t packed_size = (static_cast<size_t>(sequence->size) + 3) / 4;
+  if (pos > map_size_ || map_size_ - pos < packed_size) {
+    return false;
+  }
+  sequence->packed = pos;
+  return true;
+}
+
+bool TwoBitReader::Find(const StringPiece& name, size_t* index) const {
+  std::map<std::string, size_t>::const_iterator it =
+      index_.find(name.ToString());
+  if (it == index_.end()) {
+    return false;
+  }
+  *index = it->second;
+  return true;
+}
+
+bool TwoBitReader::CheckRange(size_t i, uint32_t start, uint32_t end) const {
+  if (i >= sequences_.size()) {
+    std::cerr << "No sequence " << i << " in .2bit file" << std::endl;
+    return false;
+  }
+  if (start > end || end > sequences_[i].size) {
+    std::cerr << "Range [" << start << ", " << end << ") is outside "
+              << sequences_[i].name << " of size " << sequences_[i].size
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+uint64_t TwoBitReader::BlockEnd(const BlockList& list, uint32_t i) const {
+  return static_cast<uint64_t>(ReadUint32(list.starts + 4 * i)) +
+         ReadUint32(list.sizes + 4 * i);
+}
+
+uint32_t TwoBitReader::FirstBlockEndingAfter(const BlockList& list,
+                                             uint32_t pos) const {
+  // Blocks are sorted and do not overlap, so their ends are sorted too.
+  uint32_t lo = 0;
+  uint32_t hi = list.count;
+  while (lo < hi) {
+    uint32_t mid = lo + (hi - lo) / 2;
+    if (BlockEnd(list, mid) <= pos) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+void TwoBitReader::GetBlocks(const BlockList& list, uint32_t start,
+                             uint32_t end,
+                             std::vector<PackedSeq::Block>* blocks) const {
+  for (uint32_t i = FirstBlockEndingAfter(list, start); i < list.count; ++i) {
+    uint32_t block_start = ReadUint32(list.starts + 4 * i);
+    if (block_start >= end) {
+      break;
+    }
+    // end is within the sequence, so clipping to it also drops the part of
+    // a malformed block that runs past the sequence.
+    uint64_t block_end = BlockEnd(list, i);
+    if (block_end <= start) {
+      continue;
+    }
+    PackedSeq::Block block;
+    block.start = std::max(block_start, start) - start;
+    block.size = static_cast<uint32_t>(std::min<uint64_t>(block_end, end)) -
+                 start - block.start;
+    blocks->push_back(block);
+  }
+}
+
+bool TwoBitReader::Fetch(size_t i, uint32_t start, uint32_t end,
+                         char* out) const {
+  if (!CheckRange(i, start, end)) {
+    return false;
+  }
+  const Sequence& sequence = sequences_[i];
+  PackedSeq::Unpack(map_ + sequence.packed, start, end, out);
+
+  std::vector<PackedSeq::Block> blocks;
+  GetBlocks(sequence.n_blocks, start, end, &blocks);
+  for (size_t j = 0; j < blocks.size(); ++j) {
+    memset(out + blocks[j].start, 'N', blocks[j].size);
+  }
+  blocks.clear();
+  GetBlocks(sequence.mask_blocks, start, end, &blocks);
+  for (size_t j = 0; j < blocks.size(); ++j) {
+    char* p = out + blocks[j].start;
+    for (uint32_t k = 0; k < blocks[j].size; ++k) {
+      p[k] |= 0x20;
+    }
+  }
+  return true;
+}
+
+bool TwoBitReader::Fetch(const StringPiece& name, uint32_t start,
+                         uint32_t end, std::string* out) const {
+  size_t i;
+  if (!Find(name, &i)) {
+    std::cerr << "No sequence " << name << " in .2bit file" << std::endl;
+    return false;
+  }
+  if (!CheckRange(i, start, end)) {
+    return false;
+  }
+  out->resize(end - start);
+  return end == start || Fetch(i, start, end, &(*out)[0]);
+}
+
+bool TwoBitReader::FetchPacked(size_t i, uint32_t start, uint32_t end,
+                               PackedSeq* out) const {
+  if (!CheckRange(i, start, end)) {
+    return false;
+  }
+  const Sequence& sequence = sequences_[i];
+  const uint8_t* src = map_ + sequence.packed + start / 4;
+  uint32_t size = end - start;
+  size_t src_size = (static_cast<size_t>(end) + 3) / 4 - start / 4;
+  std::vector<uint8_t> packed((static_cast<size_t>(size) + 3) / 4);
+  int shift = 2 * (start & 3);
+  if (shift == 0) {
+    if (!packed.empty()) {
+      memcpy(&packed[0], src, packed.size());
+    }
+  } else {
+    // Shift the bases left so the first one lands in the high bits.
+    for (size_t k = 0; k < packed.size(); ++k) {
+      uint8_t next = k + 1 < src_size ? src[k + 1] : 0;
+      packed[k] = static_cast<uint8_t>((src[k] << shift) |
+                                       (next >> (8 - shift)));
+    }
+  }
+  // Clear the bits past the last base so equal ranges pack equally.
+  if (size & 3) {
+    packed.back() &= static_cast<uint8_t>(0xff << (8 - 2 * (size & 3)));
+  }
+
+  std::vector<PackedSeq::Block> n_blocks;
+  std::vector<PackedSeq::Block> mask_blocks;
+  GetBlocks(sequence.n_blocks, start, end, &n_blocks);
+  GetBlocks(sequence.mask_blocks, start, end, &mask_blocks);
+  out->set_name(sequence.name);
+  out->Assign(size, &packed, &n_blocks, &mask_blocks);
+  return true;
+}
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
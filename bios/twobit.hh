@@ -0,0 +1,152 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file twobit.hh
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// Random access to genomes in the UCSC .2bit format. The file is memory
+/// mapped and only its index is read when it is opened; the bases of a
+/// region are decoded when the region is fetched, so fetching a region
+/// touches a few pages no matter how large the genome is.
+///
+/// A .2bit file starts with a header and an index of sequence names and
+/// record offsets. Each record holds the sequence size, its N-blocks and
+/// mask blocks as arrays of starts and sizes, and the bases packed as in
+/// PackedSeq. All integers are 32 bits, except record offsets in version 1
+/// files, which are 64 bits. The file may be in either byte order.
+
+#ifndef BIOS_TWOBIT_H__
+#define BIOS_TWOBIT_H__
+
+#include <cstddef>
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "packedseq.hh"
+#include "stringpiece.hh"
+
+namespace bios {
+
+/// @class TwoBitReader
+/// @brief Reads regions of sequences from a memory-mapped .2bit file.
+///
+/// Fetches only read the mapping and may be made from several threads at
+/// once.
+class TwoBitReader {
+ public:
+  TwoBitReader();
+  ~TwoBitReader();
+
+  /// @brief Maps a .2bit file and reads its index.
+  ///
+  /// @param     filename  The name of the file.
+  /// @return    true on success, false if the file cannot be mapped or is
+  ///            not a valid .2bit file, after reporting it.
+  bool Open(const char* filename);
+
+  /// @brief Returns the number of sequences in the file.
+  size_t num_sequences() const { return sequences_.size(); }
+
+  /// @brief Returns the name of sequence i.
+  const std::string& name(size_t i) const { return sequences_[i].name; }
+
+  /// @brief Returns the number of bases in sequence i.
+  uint32_t size(size_t i) const { return sequences_[i].size; }
+
+  /// @brief Looks up a sequence by name.
+  ///
+  /// @return    true if the file has a sequence with that name, in which
+  ///            case its index is stored in index.
+  bool Find(const StringPiece& name, size_t* index) const;
+
+  /// @brief Decodes bases [start, end) of sequence i to ASCII in out, which
+  ///        must have room for end - start characters. Bases in N-blocks
+  ///        are written as 'N', masked bases in lower case.
+  ///
+  /// @return    false if the range is outside the sequence, after reporting
+  ///            it.
+  bool Fetch(size_t i, uint32_t start, uint32_t end, char* out) const;
+
+  /// @brief Decodes bases [start, end) of the named sequence into out.
+  ///
+  /// @return    false if there is no such sequence or the range is outside
+  ///            it, after reporting it.
+  bool Fetch(const StringPiece& name, uint32_t start, uint32_t end,
+             std::string* out) const;
+
+  /// @brief Copies bases [start, end) of sequence i into out without
+  ///        decoding them. out is named after the sequence and holds
+  ///        end - start bases, with the N-blocks and mask blocks that fall
+  ///        in the range.
+  ///
+  /// @return    false if the range is outside the sequence, after reporting
+  ///            it.
+  bool FetchPacked(size_t i, uint32_t start, uint32_t end,
+                   PackedSeq* out) const;
+
+ private:
+  TwoBitReader(const TwoBitReader&);
+  void operator=(const TwoBitReader&);
+
+  /// An array of block starts and an array of block sizes in the mapping.
+  struct BlockList {
+    uint32_t count;
+    size_t starts;
+    size_t sizes;
+  };
+
+  /// Where the parts of a sequence record are in the mapping.
+  struct Sequence {
+    std::string name;
+    uint32_t size;
+    BlockList n_blocks;
+    BlockList mask_blocks;
+    size_t packed;
+  };
+
+  void Close();
+  uint32_t ReadUint32(size_t offset) const;
+  bool ReadRecord(size_t offset, Sequence* sequence);
+  bool CheckRange(size_t i, uint32_t start, uint32_t end) const;
+
+  /// Returns the end of block i of list. Block sizes come from the file,
+  /// so the end may lie past the sequence or past 2^32.
+  uint64_t BlockEnd(const BlockList& list, uint32_t i) const;
+
+  /// Returns the index of the first block in list that ends after pos.
+  uint32_t FirstBlockEndingAfter(const BlockList& list, uint32_t pos) const;
+
+  /// Appends the blocks of list that overlap [start, end) to blocks, clipped
+  /// to the range and relative to start.
+  void GetBlocks(const BlockList& list, uint32_t start, uint32_t end,
+                 std::vector<PackedSeq::Block>* blocks) const;
+
+  const uint8_t* map_;
+  size_t map_size_;
+  bool swap_;
+  std::vector<Sequence> sequences_;
+  std::map<std::string, size_t> index_;
+};
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
+#endif /* BIOS_TWOBIT_H__ */
@@ -0,0 +1,392 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file uring.cc
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// Asynchronous sequential file reading with Linux io_uring.
+
+#include "uring.hh"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && \
+    defined(__NR_io_uring_register)
+#define BIOS_HAVE_URING
+#include <linux/io_uring.h>
+#endif
+
+namespace bios {
+
+#ifdef BIOS_HAVE_URING
+
+static int uring_setup(unsigned int entries, struct io_uring_params* params) {
+  return syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int uring_enter(int ring_fd, unsigned int to_submit,
+                       unsigned int min_complete, unsigned int flags) {
+  return syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags,
+                 NULL, 0);
+}
+
+static int uring_register(int ring_fd, unsigned int opcode, void* arg,
+                          unsigned int nr_args) {
+  return syscall(__NR_io_uring_register, ring_fd, opcode, arg, nr_args);
+}
+
+#endif
+
+UringReader::UringReader()
+    : fd_(-1),
+      ring_fd_(-1),
+      file_size_(0),
+      next_offset_(0),
+      chunk_size_(0),
+      fixed_buffers_(false),
+      error_(false),
+      current_(0),
+      buffers_(NULL),
+      to_submit_(0),
+      sq_ring_(NULL),
+      sq_ring_size_(0),
+      cq_ring_(NULL),
+      cq_ring_size_(0),
+      sqes_(NULL),
+      sqes_size_(0),
+      sq_head_(NULL),
+      sq_tail_(NULL),
+      sq_mask_(NULL),
+      sq_array_(NULL),
+      cq_head_(NULL),
+      cq_tail_(NULL),
+      cq_mask_(NULL),
+      cqes_(NULL) {
+}
+
+UringReader::~UringReader() {
+  Close();
+}
+
+bool UringReader::IsSupported() {
+#ifdef BIOS_HAVE_URING
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  int ring_fd = uring_setup(1, &params);
+  if (ring_fd < 0) {
+    return false;
+  }
+  close(ring_fd);
+  return true;
+#else
+  return false;
+#endif
+}
+
+void UringReader::Close() {
+#ifdef BIOS_HAVE_URING
+  // The kernel may still write into the buffers until the reads in flight
+  // complete, so wait for them before freeing anything.
+  if (ring_fd_ >= 0) {
+    for (size_t i = 0; i < slots_.size(); ++i) {
+      while (slots_[i].pending && Submit(1)) {
+        Reap();
+      }
+    }
+  }
+#endif
+  if (sqes_ != NULL) {
+    munmap(sqes_, sqes_size_);
+    sqes_ = NULL;
+  }
+  if (cq_ring_ != NULL && cq_ring_ != sq_ring_) {
+    munmap(cq_ring_, cq_ring_size_);
+  }
+  cq_ring_ = NULL;
+  if (sq_ring_ != NULL) {
+    munmap(sq_ring_, sq_ring_size_);
+    sq_ring_ = NULL;
+  }
+  if (ring_fd_ >= 0) {
+    close(ring_fd_);
+    ring_fd_ = -1;
+  }
+  free(buffers_);
+  buffers_ = NULL;
+  slots_.clear();
+}
+
+bool UringReader::SetUpRing(int queue_depth) {
+#ifdef BIOS_HAVE_URING
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  ring_fd_ = uring_setup(queue_depth, &params);
+  if (ring_fd_ < 0) {
+    return false;
+  }
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+  cq_ring_size_ = params.cq_off.cqes +
+      params.cq_entries * sizeof(struct io_uring_cqe);
+  if (params.features & IORING_FEAT_SINGLE_MMAP) {
+    if (cq_ring_size_ > sq_ring_size_) {
+      sq_ring_size_ = cq_ring_size_;
+    }
+    cq_ring_size_ = sq_ring_size_;
+  }
+  void* sq_ring = mmap(NULL, sq_ring_size_, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+  if (sq_ring == MAP_FAILED) {
+    return false;
+  }
+  sq_ring_ = sq_ring;
+  if (params.features & IORING_FEAT_SINGLE_MMAP) {
+    cq_ring_ = sq_ring_;
+  } else {
+    void* cq_ring = mmap(NULL, cq_ring_size_, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, ring_fd_,
+                         IORING_OFF_CQ_RING);
+    if (cq_ring == MAP_FAILED) {
+      return false;
+    }
+    cq_ring_ = cq_ring;
+  }
+  sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+  void* sqes = mmap(NULL, sqes_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    return false;
+  }
+  sqes_ = sqes;
+
+  char* sq = static_cast<char*>(sq_ring_);
+  sq_head_ = reinterpret_cast<unsigned int*>(sq + params.sq_off.head);
+  sq_tail_ = reinterpret_cast<unsigned int*>(sq + params.sq_off.tail);
+  sq_mask_ = reinterpret_cast<unsigned int*>(sq + params.sq_off.ring_mask);
+  sq_array_ = reinterpret_cast<unsigned int*>(sq + params.sq_off.array);
+  char* cq = static_cast<char*>(cq_ring_);
+  cq_head_ = reinterpret_cast<unsigned int*>(cq + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<unsigned int*>(cq + params.cq_off.tail);
+  cq_mask_ = reinterpret_cast<unsigned int*>(cq + params.cq_off.ring_mask);
+  cqes_ = cq + params.cq_off.cqes;
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool UringReader::Open(int fd, int queue_depth, size_t chunk_size) {
+  Close();
+  error_ = false;
+  struct stat st;
+  if (fd < 0 || fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+    return false;
+  }
+  if (queue_depth < 1) {
+    queue_depth = 1;
+  }
+  // Reads are page-aligned so that they can be served without bouncing.
+  const size_t kPageSize = 4096;
+  chunk_size_ = (chunk_size + kPageSize - 1) / kPageSize * kPageSize;
+  if (chunk_size_ == 0) {
+    chunk_size_ = kDefaultChunkSize;
+  }
+  if (!SetUpRing(queue_depth)) {
+    Close();
+    return false;
+  }
+  void* buffers;
+  if (posix_memalign(&buffers, kPageSize, chunk_size_ * queue_depth) != 0) {
+    Close();
+    return false;
+  }
+  buffers_ = static_cast<char*>(buffers);
+
+  fd_ = fd;
+  file_size_ = st.st_size;
+  next_offset_ = 0;
+  current_ = 0;
+  to_submit_ = 0;
+  slots_.resize(queue_depth);
+  std::vector<struct iovec> iovecs(queue_depth);
+  for (int i = 0; i < queue_depth; ++i) {
+    memset(&slots_[i], 0, sizeof(Slot));
+    slots_[i].data = buffers_ + chunk_size_ * i;
+    iovecs[i].iov_base = slots_[i].data;
+    iovecs[i].iov_len = chunk_size_;
+  }
+#ifdef BIOS_HAVE_URING
+  // Registering pins the buffers, which may fail under a low
+  // RLIMIT_MEMLOCK. Plain reads into unregistered buffers still work.
+  fixed_buffers_ = uring_register(ring_fd_, IORING_REGISTER_BUFFERS,
+                                  &iovecs[0], queue_depth) == 0;
+#endif
+  for (int i = 0; i < queue_depth && next_offset_ < file_size_; ++i) {
+    Queue(i);
+  }
+  if (!Submit(0)) {
+    Close();
+    return false;
+  }
+  return true;
+}
+
+// Assigns the next chunk of the file to a slot and starts reading it.
+void UringReader::Queue(int slot) {
+  Slot& s = slots_[slot];
+  uint64_t remaining = file_size_ - next_offset_;
+  s.offset = next_offset_;
+  s.length = remaining < chunk_size_ ? remaining : chunk_size_;
+  s.filled = 0;
+  s.consumed = 0;
+  next_offset_ += s.length;
+  PushRead(slot);
+}
+
+// Queues a read of the part of a slot's chunk that has not been read yet.
+void UringReader::PushRead(int slot) {
+#ifdef BIOS_HAVE_URING
+  Slot& s = slots_[slot];
+  unsigned int tail = *sq_tail_;
+  unsigned int index = tail & *sq_mask_;
+  struct io_uring_sqe* sqe = static_cast<struct io_uring_sqe*>(sqes_) + index;
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->opcode = fixed_buffers_ ? IORING_OP_READ_FIXED : IORING_OP_READ;
+  sqe->fd = fd_;
+  sqe->addr = reinterpret_cast<uintptr_t>(s.data + s.filled);
+  sqe->len = s.length - s.filled;
+  sqe->off = s.offset + s.filled;
+  if (fixed_buffers_) {
+    sqe->buf_index = slot;
+  }
+  sqe->user_data = slot;
+  sq_array_[index] = index;
+  __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+  ++to_submit_;
+  s.pending = true;
+#endif
+}
+
+// Submits queued reads and waits until at least wait_for reads complete.
+bool UringReader::Submit(unsigned int wait_for) {
+#ifdef BIOS_HAVE_URING
+  if (to_submit_ == 0 && wait_for == 0) {
+    return true;
+  }
+  unsigned int flags = wait_for > 0 ? IORING_ENTER_GETEVENTS : 0;
+  for (;;) {
+    int ret = uring_enter(ring_fd_, to_submit_, wait_for, flags);
+    if (ret >= 0) {
+      to_submit_ -= static_cast<unsigned int>(ret) < to_submit_ ?
+          ret : to_submit_;
+      return true;
+    }
+    if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+      error_ = true;
+      return false;
+    }
+  }
+#else
+  return false;
+#endif
+}
+
+// Processes completed reads. Short reads are resubmitted for the rest of
+// their chunk.
+void UringReader::Reap() {
+#ifdef BIOS_HAVE_URING
+  unsigned int head = *cq_head_;
+  unsigned int tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+  for (; head != tail; ++head) {
+    const struct io_uring_cqe* cqe =
+        static_cast<const struct io_uring_cqe*>(cqes_) + (head & *cq_mask_);
+    Slot& s = slots_[cqe->user_data];
+    int res = cqe->res;
+    s.pending = false;
+    if (res == -EINTR || res == -EAGAIN) {
+      res = 0;
+    } else if (res < 0) {
+      error_ = true;
+      continue;
+    } else if (res == 0) {
+      // The file was truncated while being read.
+      s.length = s.filled;
+      continue;
+    }
+    s.filled += res;
+    if (s.filled < s.length) {
+      PushRead(cqe->user_data);
+    }
+  }
+  __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+#endif
+}
+
+size_t UringReader::Read(char* buffer, size_t size) {
+  if (ring_fd_ < 0) {
+    return 0;
+  }
+  size_t copied = 0;
+  while (copied < size && !error_) {
+    Slot& s = slots_[current_];
+    if (s.pending && copied > 0) {
+      // Hand out what we have rather than wait for the next chunk.
+      break;
+    }
+    while (s.pending && !error_) {
+      if (!Submit(1)) {
+        break;
+      }
+      Reap();
+    }
+    if (error_ || s.length == 0) {
+      break;
+    }
+    size_t n = s.filled - s.consumed;
+    if (n > size - copied) {
+      n = size - copied;
+    }
+    memcpy(buffer + copied, s.data + s.consumed, n);
+    s.consumed += n;
+    copied += n;
+    if (s.consumed == s.length) {
+      if (next_offset_ < file_size_) {
+        Queue(current_);
+        Submit(0);
+      } else {
+        s.length = 0;
+      }
+      current_ = (current_ + 1) % slots_.size();
+    }
+  }
+  return copied;
+}
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
@@ -0,0 +1,129 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file uring.hh
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// Asynchronous sequential file reading with Linux io_uring. Several large
+/// reads are kept in flight so that fast storage is kept busy while the
+/// previous chunk is being parsed. The ring is driven with raw system calls,
+/// so liburing is not needed.
+
+#ifndef BIOS_URING_H__
+#define BIOS_URING_H__
+
+#include <cstddef>
+#include <vector>
+#include <stdint.h>
+
+namespace bios {
+
+/// @class UringReader
+/// @brief Reads a file front to back with several io_uring reads in flight.
+///
+/// The file is split into fixed-size chunks. Chunk i is read into buffer
+/// i % queue_depth, and a buffer is queued for its next chunk as soon as its
+/// data has been handed out by Read(). The buffers are registered with the
+/// kernel when possible, which avoids mapping them on every read.
+class UringReader {
+ public:
+  enum {
+    kDefaultQueueDepth = 8,
+    kDefaultChunkSize = 1 << 20
+  };
+
+  UringReader();
+  ~UringReader();
+
+  /// @brief Returns whether the running kernel supports io_uring.
+  static bool IsSupported();
+
+  /// @brief Starts reading a regular file.
+  ///
+  /// @param     fd           An open descriptor of the file. It is not
+  ///                         closed by the reader.
+  /// @param     queue_depth  The number of reads kept in flight.
+  /// @param     chunk_size   The size of each read.
+  /// @return    false if io_uring is unavailable or could not be set up.
+  bool Open(int fd, int queue_depth = kDefaultQueueDepth,
+            size_t chunk_size = kDefaultChunkSize);
+
+  /// @brief Copies up to size bytes of the file, in order, into buffer.
+  ///
+  /// @return    The number of bytes copied, or 0 at the end of the file or
+  ///            on error. Use error() to tell the two apart.
+  size_t Read(char* buffer, size_t size);
+
+  /// @brief Returns whether a read failed.
+  bool error() const { return error_; }
+
+ private:
+  struct Slot {
+    char* data;
+    uint64_t offset;   // Offset in the file of the chunk being read.
+    size_t length;     // Number of bytes requested for the chunk.
+    size_t filled;     // Number of bytes read so far.
+    size_t consumed;   // Number of bytes handed out by Read().
+    bool pending;      // Whether a read is in flight.
+  };
+
+  void Close();
+  bool SetUpRing(int queue_depth);
+  void Queue(int slot);
+  void PushRead(int slot);
+  bool Submit(unsigned int wait_for);
+  void Reap();
+
+  int fd_;
+  int ring_fd_;
+  uint64_t file_size_;
+  uint64_t next_offset_;
+  size_t chunk_size_;
+  bool fixed_buffers_;
+  bool error_;
+
+  std::vector<Slot> slots_;
+  size_t current_;     // The slot Read() is consuming.
+  char* buffers_;
+  unsigned int to_submit_;
+
+  // Submission and completion ring mappings.
+  void* sq_ring_;
+  size_t sq_ring_size_;
+  void* cq_ring_;
+  size_t cq_ring_size_;
+  void* sqes_;
+  size_t sqes_size_;
+  unsigned int* sq_head_;
+  unsigned int* sq_tail_;
+  unsigned int* sq_mask_;
+  unsigned int* sq_array_;
+  unsigned int* cq_head_;
+  unsigned int* cq_tail_;
+  unsigned int* cq_mask_;
+  void* cqes_;
+
+  UringReader(const UringReader&);
+  void operator=(const UringReader&);
+};
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
+#endif /* BIOS_URING_H__ */
@@ -3,15 +3,9 @@
 namespace bios {
 
 WordIter::WordIter(const std::string& str, const char* seps, 
-                   bool collapse_separators) {
-  if (seps == NULL) {
-    return;
-  }
-  str_ = strdup(str.c_str());
-  seps_ = seps;
-  position_ = str_;
-  collapse_separators_ = collapse_separators;
-  at_end_ = false;
+                   bool collapse_separators)
+    : str_(seps == NULL ? NULL : strdup(str.c_str())),
+      tokenizer_(StringPiece(str_), seps, collapse_separators) {
 }
 
 WordIter::~WordIter() {
@@ -24,48 +18,17 @@ char* WordIter::Next(int* index) {
   if (index != NULL) {
     *index = 0;
   }
-
-  if (at_end_ == true) {
-    return NULL;
-  }
-  char* position = position_;
-  if (collapse_separators_ != false) {
-    --position;
-    while (*++position != '\0' && strchr(seps_, *position) != NULL)
-      ;
-  } else {
-    if (*position == '\0') {
-      at_end_ = true;
-      return NULL;
-    }
-    if (strchr(seps_, *position) != NULL) {
-      ++position_;
-      *position = '\0';
-      return position;
-    }
-  }
-  if (*position == '\0') {
-    at_end_ = true;
+  StringPiece word;
+  if (!tokenizer_.Next(&word)) {
     return NULL;
   }
-
-  // Here holds: we are on the beginning of a word, on a non-separator char.
-  // Now run until end of this word.
-  char* word = position;
-  --position;
-  while (*++position != '\0' && strchr(seps_, *position) == NULL)
-    ;
+  // The word ends at a separator or at the terminating NUL of the copy.
+  char* start = str_ + (word.data() - str_);
+  start[word.size()] = '\0';
   if (index != NULL) {
-    *index = position - word;
-  }
-
-  if (*position == '\0') {
-    at_end_ = true;
-  } else {
-    *position = '\0';
-    position_ = position + 1;
+    *index = word.size();
   }
-  return word;
+  return start;
 }
 
 char* WordIter::Next() {
@@ -5,9 +5,119 @@
 #include <cstdio>
 #include <cstring>
 #include <cstdlib>
+#include <stdint.h>
+
+#include "stringpiece.hh"
 
 namespace bios {
 
+/// @class SeparatorSet
+/// @brief Set of separator characters stored as a 256-bit lookup table, so
+///        that testing a character is a single bit test instead of a
+///        strchr() over the separator string.
+class SeparatorSet {
+ public:
+  explicit SeparatorSet(const char* seps) {
+    memset(bits_, 0, sizeof(bits_));
+    if (seps == NULL) {
+      return;
+    }
+    for (const char* c = seps; *c != '\0'; ++c) {
+      unsigned char u = *c;
+      bits_[u >> 5] |= 1U << (u & 31);
+    }
+  }
+
+  bool Contains(char c) const {
+    unsigned char u = c;
+    return (bits_[u >> 5] >> (u & 31)) & 1;
+  }
+
+ private:
+  uint32_t bits_[8];
+};
+
+/// @class Tokenizer
+/// @brief Splits a string view into words without copying or modifying it.
+///
+/// The words are returned as views into the original string, which must
+/// stay valid while they are used. With collapse_separators, runs of
+/// separators count as one and leading separators are skipped; otherwise
+/// each separator ends a word, so consecutive separators yield empty words.
+class Tokenizer {
+ public:
+  Tokenizer(const StringPiece& str, const char* seps, bool collapse_separators)
+      : seps_(seps),
+        position_(str.begin()),
+        end_(str.end()),
+        collapse_separators_(collapse_separators),
+        at_end_(false) {
+  }
+
+  Tokenizer(const StringPiece& str, const SeparatorSet& seps,
+            bool collapse_separators)
+      : seps_(seps),
+        position_(str.begin()),
+        end_(str.end()),
+        collapse_separators_(collapse_separators),
+        at_end_(false) {
+  }
+
+  /// @brief Starts over on a new string, keeping the separators.
+  void Reset(const StringPiece& str) {
+    position_ = str.begin();
+    end_ = str.end();
+    at_end_ = false;
+  }
+
+  /// @brief Gets the next word.
+  ///
+  /// @param[out] word  A view of the next word.
+  /// @return    true if there was another word, false otherwise.
+  bool Next(StringPiece* word) {
+    if (at_end_) {
+      return false;
+    }
+    const char* position = position_;
+    if (collapse_separators_) {
+      while (position != end_ && seps_.Contains(*position)) {
+        ++position;
+      }
+    } else if (position != end_ && seps_.Contains(*position)) {
+      word->set(position, 0);
+      position_ = position + 1;
+      return true;
+    }
+    if (position == end_) {
+      at_end_ = true;
+      return false;
+    }
+    const char* start = position;
+    while (position != end_ && !seps_.Contains(*position)) {
+      ++position;
+    }
+    word->set(start, position - start);
+    if (position == end_) {
+      at_end_ = true;
+    } else {
+      position_ = position + 1;
+    }
+    return true;
+  }
+
+ private:
+  SeparatorSet seps_;
+  const char* position_;
+  const char* end_;
+  bool collapse_separators_;
+  bool at_end_;
+};
+
+/// @class WordIter
+/// @brief Splits a copy of a string into NUL-terminated words.
+///
+/// Kept for compatibility; new code should use Tokenizer, which neither
+/// copies nor modifies the string.
 class WordIter {
  public:
   WordIter(const std::string& str, const char* seps, bool collapse_separators);
@@ -18,10 +128,10 @@ class WordIter {
 
  private:
   char* str_;
-  char* position_;
-  const char* seps_;
-  bool collapse_separators_;
-  bool at_end_;
+  Tokenizer tokenizer_;
+
+  WordIter(const WordIter&);
+  void operator=(const WordIter&);
 };
 
 }; // namespace bios
@@ -0,0 +1,374 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file writer.cc
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// Buffered, optionally compressed output of text records.
+
+#include "writer.hh"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace bios {
+
+// Pairs of decimal digits, so that numbers are formatted two digits at a time.
+static const char kDigitPairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// Scaled values below this are exact integers in a double.
+static const double kMaxExactScaled = 9007199254740992.0;  // 2^53
+
+static const uint64_t kPowersOfTen[] = {
+  1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+  100000000ULL, 1000000000ULL
+};
+
+// The empty BGZF block that marks the end of a BGZF file.
+static const unsigned char kBgzfEof[28] = {
+  0x1f, 0x8b, 0x08, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x06, 0x00,
+  0x42, 0x43, 0x02, 0x00, 0x1b, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00
+};
+
+static const size_t kBgzfHeaderSize = 18;
+static const size_t kBgzfFooterSize = 8;
+static const size_t kGzipOutputSize = 1 << 17;
+
+// Formats value right-aligned in the buffer ending at end. Returns a pointer
+// to the first digit.
+static char* FormatUint(uint64_t value, char* end) {
+  while (value >= 100) {
+    unsigned int pair = (value % 100) * 2;
+    value /= 100;
+    *--end = kDigitPairs[pair + 1];
+    *--end = kDigitPairs[pair];
+  }
+  if (value >= 10) {
+    unsigned int pair = value * 2;
+    *--end = kDigitPairs[pair + 1];
+    *--end = kDigitPairs[pair];
+  } else {
+    *--end = '0' + value;
+  }
+  return end;
+}
+
+static void PutUint16(unsigned char* p, unsigned int value) {
+  p[0] = value & 0xff;
+  p[1] = (value >> 8) & 0xff;
+}
+
+static void PutUint32(unsigned char* p, uint32_t value) {
+  PutUint16(p, value & 0xffff);
+  PutUint16(p + 2, value >> 16);
+}
+
+RecordWriter::RecordWriter()
+    : fd_(-1),
+      owns_fd_(false),
+      error_(false),
+      compression_(kNoCompression),
+      level_(Z_DEFAULT_COMPRESSION),
+      stream_open_(false),
+      buffer_(NULL),
+      cursor_(NULL),
+      limit_(NULL),
+      compressed_(NULL),
+      compressed_size_(0) {
+  memset(&stream_, 0, sizeof(stream_));
+}
+
+RecordWriter::~RecordWriter() {
+  Close();
+}
+
+bool RecordWriter::Open(const char* filename, Compression compression,
+                        int level) {
+  Close();
+  if (filename == NULL) {
+    return false;
+  }
+  if (strcmp(filename, "-") == 0) {
+    return Start(STDOUT_FILENO, false, compression, level);
+  }
+  int fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+  if (fd < 0) {
+    return false;
+  }
+  return Start(fd, true, compression, level);
+}
+
+bool RecordWriter::OpenFd(int fd, Compression compression, int level) {
+  Close();
+  if (fd < 0) {
+    return false;
+  }
+  return Start(fd, false, compression, level);
+}
+
+bool RecordWriter::Start(int fd, bool owns_fd, Compression compression,
+                         int level) {
+  fd_ = fd;
+  owns_fd_ = owns_fd;
+  error_ = false;
+  compression_ = compression;
+  level_ = level;
+  if (compression_ != kNoCompression) {
+    memset(&stream_, 0, sizeof(stream_));
+    // BGZF blocks are raw deflate streams wrapped in a hand-built header;
+    // plain gzip output lets zlib write the header and trailer.
+    int window_bits = compression_ == kGzip ? 16 + MAX_WBITS : -MAX_WBITS;
+    if (deflateInit2(&stream_, level_, Z_DEFLATED, window_bits, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+      Close();
+      return false;
+    }
+    stream_open_ = true;
+    compressed_size_ = compression_ == kGzip ?
+        kGzipOutputSize : kBgzfMaxBlockSize;
+    compressed_ = static_cast<char*>(malloc(compressed_size_));
+  }
+  buffer_ = static_cast<char*>(malloc(kBufferSize));
+  cursor_ = buffer_;
+  limit_ = buffer_ + kBufferSize;
+  return true;
+}
+
+bool RecordWriter::Close() {
+  if (fd_ < 0) {
+    return true;
+  }
+  size_t pending = cursor_ - buffer_;
+  switch (compression_) {
+    case kNoCompression:
+      Flush();
+      break;
+    case kGzip:
+      DeflateGzip(buffer_, pending, Z_FINISH);
+      break;
+    case kBgzf:
+      Flush();
+      if (cursor_ > buffer_) {
+        WriteBgzfBlock(buffer_, cursor_ - buffer_);
+      }
+      WriteFd(reinterpret_cast<const char*>(kBgzfEof), sizeof(kBgzfEof));
+      break;
+  }
+  if (stream_open_) {
+    deflateEnd(&stream_);
+    stream_open_ = false;
+  }
+  if (owns_fd_ && close(fd_) != 0) {
+    error_ = true;
+  }
+  fd_ = -1;
+  owns_fd_ = false;
+  free(buffer_);
+  free(compressed_);
+  buffer_ = cursor_ = limit_ = compressed_ = NULL;
+  compressed_size_ = 0;
+  return !error_;
+}
+
+bool RecordWriter::Flush() {
+  if (fd_ < 0) {
+    return false;
+  }
+  size_t pending = cursor_ - buffer_;
+  switch (compression_) {
+    case kNoCompression:
+      WriteFd(buffer_, pending);
+      cursor_ = buffer_;
+      break;
+    case kGzip:
+      DeflateGzip(buffer_, pending, Z_NO_FLUSH);
+      cursor_ = buffer_;
+      break;
+    case kBgzf: {
+      size_t offset = 0;
+      for (; pending - offset >= kBgzfBlockSize; offset += kBgzfBlockSize) {
+        WriteBgzfBlock(buffer_ + offset, kBgzfBlockSize);
+      }
+      memmove(buffer_, buffer_ + offset, pending - offset);
+      cursor_ = buffer_ + pending - offset;
+      break;
+    }
+  }
+  return !error_;
+}
+
+void RecordWriter::AppendSlow(const char* data, size_t size) {
+  if (buffer_ == NULL) {
+    return;
+  }
+  while (size > 0) {
+    if (cursor_ == limit_) {
+      Flush();
+    }
+    size_t n = limit_ - cursor_;
+    if (n > size) {
+      n = size;
+    }
+    memcpy(cursor_, data, n);
+    cursor_ += n;
+    data += n;
+    size -= n;
+  }
+}
+
+void RecordWriter::AppendUint(uint64_t value) {
+  char digits[20];
+  char* end = digits + sizeof(digits);
+  char* begin = FormatUint(value, end);
+  Append(begin, end - begin);
+}
+
+void RecordWriter::AppendInt(int64_t value) {
+  if (value < 0) {
+    AppendChar('-');
+    AppendUint(0 - static_cast<uint64_t>(value));
+  } else {
+    AppendUint(value);
+  }
+}
+
+void RecordWriter::AppendFixed(double value, int decimals) {
+  const int kMaxDecimals = sizeof(kPowersOfTen) / sizeof(kPowersOfTen[0]) - 1;
+  double magnitude = std::fabs(value);
+  // Large values, and NaN, go through snprintf: once the scaled value
+  // reaches 2^53 it is no longer exact, and past 2^64 it would not convert.
+  if (decimals < 0 || decimals > kMaxDecimals ||
+      !(magnitude * kPowersOfTen[decimals] < kMaxExactScaled)) {
+    char text[512];
+    int n = snprintf(text, sizeof(text), "%.*f", decimals, value);
+    if (n > 0) {
+      Append(text, std::min(static_cast<size_t>(n), sizeof(text) - 1));
+    }
+    return;
+  }
+  // Rounds half away from zero, which may differ from printf in the last
+  // digit for values that are exactly halfway.
+  uint64_t scale = kPowersOfTen[decimals];
+  uint64_t scaled = static_cast<uint64_t>(magnitude * scale + 0.5);
+  if (value < 0) {
+    AppendChar('-');
+  }
+  AppendUint(scaled / scale);
+  if (decimals > 0) {
+    char digits[20];
+    char* end = digits + sizeof(digits);
+    char* begin = FormatUint(scaled % scale, end);
+    while (end - begin < decimals) {
+      *--begin = '0';
+    }
+    AppendChar('.');
+    Append(begin, end - begin);
+  }
+}
+
+void RecordWriter::AppendDouble(double value) {
+  char text[32];
+  int n = snprintf(text, sizeof(text), "%g", value);
+  if (n > 0) {
+    Append(text, n);
+  }
+}
+
+bool RecordWriter::WriteFd(const char* data, size_t size) {
+  while (size > 0) {
+    ssize_t written = write(fd_, data, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      error_ = true;
+      return false;
+    }
+    data += written;
+    size -= written;
+  }
+  return true;
+}
+
+bool RecordWriter::DeflateGzip(const char* data, size_t size, int flush) {
+  stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+  stream_.avail_in = size;
+  int ret;
+  do {
+    stream_.next_out = reinterpret_cast<Bytef*>(compressed_);
+    stream_.avail_out = compressed_size_;
+    ret = deflate(&stream_, flush);
+    if (ret == Z_STREAM_ERROR) {
+      error_ = true;
+      return false;
+    }
+    WriteFd(compressed_, compressed_size_ - stream_.avail_out);
+  } while (stream_.avail_out == 0 ||
+           (flush == Z_FINISH && ret != Z_STREAM_END));
+  return !error_;
+}
+
+// Compresses data, at most kBgzfBlockSize bytes, into one BGZF block.
+bool RecordWriter::WriteBgzfBlock(const char* data, size_t size) {
+  unsigned char* block = reinterpret_cast<unsigned char*>(compressed_);
+  deflateReset(&stream_);
+  stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+  stream_.avail_in = size;
+  stream_.next_out = block + kBgzfHeaderSize;
+  stream_.avail_out = compressed_size_ - kBgzfHeaderSize - kBgzfFooterSize;
+  if (deflate(&stream_, Z_FINISH) != Z_STREAM_END) {
+    error_ = true;
+    return false;
+  }
+  size_t block_size = kBgzfHeaderSize + stream_.total_out + kBgzfFooterSize;
+
+  // gzip header with the BC extra subfield holding the block size - 1.
+  static const unsigned char kHeader[16] = {
+    0x1f, 0x8b, 0x08, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x06, 0x00,
+    0x42, 0x43, 0x02, 0x00
+  };
+  memcpy(block, kHeader, sizeof(kHeader));
+  PutUint16(block + 16, block_size - 1);
+  unsigned char* footer = block + block_size - kBgzfFooterSize;
+  uLong crc = crc32(0L, Z_NULL, 0);
+  crc = crc32(crc, reinterpret_cast<const Bytef*>(data), size);
+  PutUint32(footer, crc);
+  PutUint32(footer + 4, size);
+  return WriteFd(compressed_, block_size);
+}
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
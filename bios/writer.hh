@@ -0,0 +1,163 @@
+// This file is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// To obtain a copy of the GNU Lesser General Public License,
+// please write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// or visit the WWW site http://www.gnu.org/copyleft/lesser.txt
+
+/// @file writer.hh
+/// @author David Z. Chen <d.zhekai.chen@gmail.com>
+/// @version 1.0.0
+/// @since 16 Oct 2026
+///
+/// @section DESCRIPTION
+///
+/// Buffered output of text records to a file or standard output, optionally
+/// compressed as gzip or BGZF. Numbers are formatted directly into the
+/// output buffer without going through iostreams or printf.
+
+#ifndef BIOS_WRITER_H__
+#define BIOS_WRITER_H__
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <stdint.h>
+#include <zlib.h>
+
+#include "stringpiece.hh"
+
+namespace bios {
+
+/// @class RecordWriter
+/// @brief Writes text to a file through a large buffer.
+///
+/// Output is collected in a buffer and written or compressed when the buffer
+/// is full, so appending a field is usually just a memcpy. Call Close() to
+/// flush the buffer and learn whether all output was written; the destructor
+/// closes the writer but cannot report errors.
+class RecordWriter {
+ public:
+  enum Compression {
+    kNoCompression,
+    kGzip,
+    kBgzf
+  };
+
+  RecordWriter();
+  ~RecordWriter();
+
+  /// @brief Creates or truncates a file and writes to it.
+  ///
+  /// @param     filename     The name of the file or '-' for stdout.
+  /// @param     compression  How to compress the output.
+  /// @param     level        The zlib compression level.
+  /// @return    false if the file could not be created.
+  bool Open(const char* filename, Compression compression = kNoCompression,
+            int level = Z_DEFAULT_COMPRESSION);
+
+  /// @brief Writes to an open file descriptor, which is not closed by the
+  ///        writer.
+  bool OpenFd(int fd, Compression compression = kNoCompression,
+              int level = Z_DEFAULT_COMPRESSION);
+
+  /// @brief Flushes all output, finishes the compressed stream and closes
+  ///        the file.
+  ///
+  /// @return    false if any output could not be written.
+  bool Close();
+
+  /// @brief Writes the buffered output. Compressed output is only written
+  ///        in whole blocks, so some of it may stay buffered.
+  bool Flush();
+
+  void Append(const char* data, size_t size) {
+    if (size > static_cast<size_t>(limit_ - cursor_)) {
+      AppendSlow(data, size);
+      return;
+    }
+    memcpy(cursor_, data, size);
+    cursor_ += size;
+  }
+
+  void Append(const StringPiece& piece) {
+    Append(piece.data(), piece.size());
+  }
+
+  void Append(const std::string& str) {
+    Append(str.data(), str.size());
+  }
+
+  void Append(const char* str) {
+    Append(str, strlen(str));
+  }
+
+  void AppendChar(char c) {
+    if (cursor_ == limit_) {
+      AppendSlow(&c, 1);
+      return;
+    }
+    *cursor_++ = c;
+  }
+
+  /// @brief Appends the decimal representation of a number.
+  void AppendInt(int64_t value);
+  void AppendUint(uint64_t value);
+
+  /// @brief Appends a number with a fixed number of decimal places, like
+  ///        printf("%.*f"). Values too large for fixed-point formatting are
+  ///        written with printf.
+  void AppendFixed(double value, int decimals);
+
+  /// @brief Appends a number like std::ostream does by default, i.e. with
+  ///        printf("%g").
+  void AppendDouble(double value);
+
+  /// @brief Returns whether the writer is open.
+  bool is_open() const { return fd_ >= 0; }
+
+ private:
+  enum {
+    kBufferSize = 1 << 20,
+    // Uncompressed bytes per BGZF block, as used by htslib so that the
+    // compressed block always fits in 64 KB.
+    kBgzfBlockSize = 0xff00,
+    kBgzfMaxBlockSize = 1 << 16
+  };
+
+  bool Start(int fd, bool owns_fd, Compression compression, int level);
+  void AppendSlow(const char* data, size_t size);
+  bool WriteFd(const char* data, size_t size);
+  bool DeflateGzip(const char* data, size_t size, int flush);
+  bool WriteBgzfBlock(const char* data, size_t size);
+
+  int fd_;
+  bool owns_fd_;
+  bool error_;
+  Compression compression_;
+  int level_;
+  z_stream stream_;
+  bool stream_open_;
+
+  char* buffer_;
+  char* cursor_;
+  char* limit_;
+  char* compressed_;
+  size_t compressed_size_;
+
+  RecordWriter(const RecordWriter&);
+  void operator=(const RecordWriter&);
+};
+
+}; // namespace bios
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
+#endif /* BIOS_WRITER_H__ */
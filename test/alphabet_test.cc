@@ -0,0 +1,128 @@
+#include <cctype>
+#include <cstring>
+#include <string>
+
+#include <bios/alphabet.hh>
+#include <bios/seq.hh>
+#include <gtest/gtest.h>
+
+// The tables as Sequencer used to build them at startup.
+struct RuntimeTables {
+  RuntimeTables() {
+    memset(this, 0, sizeof(*this));
+    for (int i = 0; i < 256; ++i) {
+      nt_val[i] = nt_val_lower[i] = nt_val_upper[i] = -1;
+      nt_val_no_n[i] = T_BASE_VAL;
+      if (isspace(i) || isdigit(i)) {
+        nt_val_5[i] = nt_val_masked[i] = -1;
+      } else {
+        nt_val_5[i] = N_BASE_VAL;
+        nt_val_masked[i] = islower(i) ? (N_BASE_VAL | MASKED_BASE_BIT)
+                                      : N_BASE_VAL;
+      }
+      aa_val[i] = -1;
+    }
+    const char bases[] = "tucagn";
+    const int vals[] = {T_BASE_VAL, U_BASE_VAL, C_BASE_VAL, A_BASE_VAL,
+                        G_BASE_VAL, N_BASE_VAL};
+    for (int i = 0; i < 6; ++i) {
+      unsigned char lower = bases[i];
+      unsigned char upper = toupper(lower);
+      int val = vals[i];
+      if (lower != 'n') {
+        nt_val_5[lower] = nt_val_5[upper] = nt_val_no_n[lower] =
+            nt_val_no_n[upper] = nt_val[lower] = nt_val[upper] =
+            nt_val_lower[lower] = nt_val_upper[upper] = val;
+        nt_val_masked[upper] = val;
+        nt_val_masked[lower] = val | MASKED_BASE_BIT;
+      }
+      if (lower != 'u') {
+        val_to_nt[val] = val_to_nt[val | MASKED_BASE_BIT] = lower;
+        val_to_nt_masked[val] = upper;
+        val_to_nt_masked[val | MASKED_BASE_BIT] = lower;
+      }
+      nt_chars[lower] = nt_chars[upper] = lower;
+      nt_mixed_case_chars[lower] = lower;
+      nt_mixed_case_chars[upper] = upper;
+    }
+    nt_chars['-'] = nt_mixed_case_chars['-'] = 'n';
+    const char amino_acids[] = "ACDEFGHIKLMNPQRSTVWY";
+    for (int i = 0; i < 20; ++i) {
+      unsigned char c = amino_acids[i];
+      aa_val[c] = aa_val[tolower(c)] = i;
+      aa_chars[c] = aa_chars[tolower(c)] = c;
+      val_to_aa[i] = c;
+    }
+    aa_chars['x'] = aa_chars['X'] = 'X';
+  }
+
+  int nt_val[256];
+  int nt_val_lower[256];
+  int nt_val_upper[256];
+  int nt_val_5[256];
+  int nt_val_no_n[256];
+  int nt_val_masked[256];
+  char val_to_nt[16];
+  char val_to_nt_masked[256];
+  char nt_chars[256];
+  char nt_mixed_case_chars[256];
+  int aa_val[256];
+  char aa_chars[256];
+  char val_to_aa[20];
+};
+
+TEST(Alphabet, MatchesRuntimeTables) {
+  RuntimeTables expected;
+  for (int i = 0; i < 256; ++i) {
+    EXPECT_EQ(expected.nt_val[i], bios::alphabet::kNtVal[i]);
+    EXPECT_EQ(expected.nt_val_lower[i], bios::alphabet::kNtValLower[i]);
+    EXPECT_EQ(expected.nt_val_upper[i], bios::alphabet::kNtValUpper[i]);
+    EXPECT_EQ(expected.nt_val_5[i], bios::alphabet::kNtVal5[i]);
+    EXPECT_EQ(expected.nt_val_no_n[i], bios::alphabet::kNtValNoN[i]);
+    EXPECT_EQ(expected.nt_val_masked[i], bios::alphabet::kNtValMasked[i]);
+    EXPECT_EQ(expected.val_to_nt_masked[i],
+              bios::alphabet::kValToNtMasked[i]);
+    EXPECT_EQ(expected.nt_chars[i], bios::alphabet::kNtChars[i]);
+    EXPECT_EQ(expected.nt_mixed_case_chars[i],
+              bios::alphabet::kNtMixedCaseChars[i]);
+    EXPECT_EQ(expected.aa_val[i], bios::alphabet::kAaVal[i]);
+    EXPECT_EQ(expected.aa_chars[i], bios::alphabet::kAaChars[i]);
+  }
+  for (int i = 0; i < 16; ++i) {
+    EXPECT_EQ(expected.val_to_nt[i], bios::alphabet::kValToNt[i]);
+  }
+  for (int i = 0; i < 20; ++i) {
+    EXPECT_EQ(expected.val_to_aa[i], bios::alphabet::kValToAa[i]);
+  }
+}
+
+TEST(Alphabet, Codons) {
+  EXPECT_EQ('M', bios::alphabet::lookup_codon("ATG"));
+  EXPECT_EQ('M', bios::alphabet::lookup_codon("aug"));
+  EXPECT_EQ(0, bios::alphabet::lookup_codon("tga"));
+  EXPECT_EQ('W', bios::alphabet::lookup_mitochondrial_codon("tga"));
+  EXPECT_EQ('X', bios::alphabet::lookup_codon("anc"));
+  EXPECT_EQ(-1, bios::alphabet::codon_val("an-"));
+  for (int val = 0; val < 64; ++val) {
+    EXPECT_EQ(val, bios::alphabet::codon_val(
+        bios::alphabet::val_to_codon(val)));
+  }
+}
+
+TEST(Alphabet, Filter) {
+  char out[32];
+  bios::alphabet::filter("AC gT-\tnX", out, bios::alphabet::kNtChars);
+  EXPECT_STREQ("acgtnn", out);
+  bios::alphabet::filter("AC gT-\tnX", out,
+                         bios::alphabet::kNtMixedCaseChars);
+  EXPECT_STREQ("ACgTnn", out);
+  bios::alphabet::filter("mk-x*b", out, bios::alphabet::kAaChars);
+  EXPECT_STREQ("MKX", out);
+
+  int histogram[4];
+  bios::alphabet::base_histogram("ttCAGgn-Uu", 10, histogram);
+  EXPECT_EQ(4, histogram[T_BASE_VAL]);
+  EXPECT_EQ(1, histogram[C_BASE_VAL]);
+  EXPECT_EQ(1, histogram[A_BASE_VAL]);
+  EXPECT_EQ(2, histogram[G_BASE_VAL]);
+}
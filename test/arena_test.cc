@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <bios/arena.hh>
+
+#include <stdint.h>
+#include <string>
+
+namespace {
+
+struct Counted {
+  Counted() { ++live; }
+  ~Counted() { --live; }
+  std::string name;
+  static int live;
+};
+
+int Counted::live = 0;
+
+}  // namespace
+
+TEST(Arena, AllocateAligned) {
+  bios::Arena arena(256);
+  EXPECT_EQ(0u, arena.bytes_reserved());
+  char* c = static_cast<char*>(arena.Allocate(1, 1));
+  ASSERT_TRUE(c != NULL);
+  void* d = arena.Allocate(sizeof(double), 8);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(d) % 8);
+  EXPECT_EQ(256u, arena.bytes_reserved());
+  EXPECT_LE(9u, arena.bytes_used());
+}
+
+TEST(Arena, ManyBlocksAndLargeRequests) {
+  bios::Arena arena(256);
+  for (int i = 0; i < 1000; ++i) {
+    uint32_t* values = arena.NewArray<uint32_t>(10);
+    values[0] = i;
+    values[9] = i;
+  }
+  char* big = static_cast<char*>(arena.Allocate(10000));
+  memset(big, 'x', 10000);
+  EXPECT_LE(40000u + 10000u, arena.bytes_used());
+  EXPECT_LE(arena.bytes_used(), arena.bytes_reserved());
+}
+
+TEST(Arena, CopyString) {
+  bios::Arena arena;
+  std::string line = "chr1\t100\t200";
+  char* copy = arena.CopyString(bios::StringPiece(line.data(), 4));
+  line[0] = 'X';
+  EXPECT_STREQ("chr1", copy);
+  EXPECT_STREQ("", arena.CopyString(bios::StringPiece()));
+}
+
+TEST(Arena, RunsDestructors) {
+  {
+    bios::Arena arena;
+    for (int i = 0; i < 100; ++i) {
+      Counted* counted = arena.New<Counted>();
+      counted->name = "a name long enough to live on the heap";
+    }
+    EXPECT_EQ(100, Counted::live);
+    arena.Reset();
+    EXPECT_EQ(0, Counted::live);
+    EXPECT_EQ(0u, arena.bytes_used());
+    arena.New<Counted>();
+    EXPECT_EQ(1, Counted::live);
+  }
+  EXPECT_EQ(0, Counted::live);
+}
+
+TEST(Arena, ResetKeepsFirstBlock) {
+  bios::Arena arena(1024);
+  for (int i = 0; i < 100; ++i) {
+    arena.Allocate(100);
+  }
+  arena.Allocate(5000);
+  arena.Reset();
+  EXPECT_EQ(1024u, arena.bytes_reserved());
+  arena.Allocate(100);
+  EXPECT_EQ(1024u, arena.bytes_reserved());
+}
@@ -1,5 +1,8 @@
+#include <algorithm>
 #include <iostream>
+#include <vector>
 
+#include <bios/arena.hh>
 #include <bios/bed.hh>
 #include <gtest/gtest.h>
 
@@ -16,4 +19,168 @@ TEST(BedParser, ParseBasic) {
   std::cout << b->ToString() << std::endl;
 }
 
+TEST(BedParser, ParseFromMemory) {
+  const char data[] = "track name=test\nchr1\t100\t200\n";
+  bios::BedParser parser;
+  parser.InitFromStream(new bios::MemoryLineStream(data, sizeof(data) - 1));
+  bios::Bed* b = parser.NextEntry();
+  ASSERT_TRUE(b != NULL);
+  EXPECT_EQ("chr1", b->chromosome());
+  EXPECT_EQ(100u, b->start());
+  EXPECT_EQ(200u, b->end());
+  delete b;
+}
+
+TEST(BedParser, ParseBlocks) {
+  const char data[] =
+      "chr22\t1000\t5000\tcloneA\t960\t+\t1000\t5000\t0\t2\t567,488,"
+      "\t0,3512\n";
+  bios::BedParser parser;
+  parser.InitFromStream(new bios::MemoryLineStream(data, sizeof(data) - 1));
+  bios::Bed* b = parser.NextEntry();
+  ASSERT_TRUE(b != NULL);
+  EXPECT_TRUE(b->extended());
+  EXPECT_EQ("cloneA", b->name());
+  EXPECT_EQ(960u, b->score());
+  EXPECT_EQ('+', b->strand());
+  EXPECT_EQ(2u, b->block_count());
+  EXPECT_EQ("chr22\t1000\t5000\tcloneA\t960\t+\t1000\t5000\t0\t2\t"
+            "567,488\t0,3512", b->ToString());
+  delete b;
+}
+
+TEST(BedParser, FieldMask) {
+  const char data[] =
+      "chr22\t1000\t5000\tcloneA\tx\t+\t1000\t5000\t0\t2\t567,488,"
+      "\t0,3512\n"
+      "chr1\t100\t200\n"
+      "chr2\t300\n";
+  bios::BedParser parser;
+  parser.InitFromStream(new bios::MemoryLineStream(data, sizeof(data) - 1));
+  parser.SetFieldMask(bios::kBedChromosome | bios::kBedStart |
+                      bios::kBedName);
+  bios::Bed* b = parser.NextEntry();
+  ASSERT_TRUE(b != NULL);
+  EXPECT_EQ("chr22", b->chromosome());
+  EXPECT_EQ(1000u, b->start());
+  EXPECT_EQ(0u, b->end());
+  EXPECT_EQ("cloneA", b->name());
+  EXPECT_EQ(0u, b->score());
+  delete b;
+  b = parser.NextEntry();
+  ASSERT_TRUE(b != NULL);
+  EXPECT_EQ("chr1", b->chromosome());
+  EXPECT_FALSE(b->extended());
+  delete b;
+  EXPECT_EQ(NULL, parser.NextEntry());
+}
+
+TEST(BedParser, FieldMaskBlocks) {
+  const char data[] =
+      "chr22\t1000\t5000\tcloneA\t960\t+\t1000\t5000\t0\t2\t567,488,"
+      "\t0,3512\n";
+  bios::BedParser parser;
+  parser.InitFromStream(new bios::MemoryLineStream(data, sizeof(data) - 1));
+  parser.SetFieldMask(bios::kBedBlockStarts);
+  bios::Bed* b = parser.NextEntry();
+  ASSERT_TRUE(b != NULL);
+  EXPECT_EQ(2u, b->block_count());
+  EXPECT_EQ("", b->chromosome());
+  delete b;
+}
+
+TEST(BedParser, NextBatch) {
+  const char data[] =
+      "track name=test\n"
+      "chr22\t1000\t5000\tcloneA\t960\t+\t1000\t5000\t0\t2\t567,488,"
+      "\t0,3512\n"
+      "chr1\t100\t200\n"
+      "chr1\tx\t200\n"
+      "chr2\t300\t400\n";
+  bios::BedParser parser;
+  parser.InitFromStream(new bios::MemoryLineStream(data, sizeof(data) - 1));
+  bios::BedBatch batch;
+  ASSERT_EQ(2u, parser.NextBatch(&batch, 2));
+  EXPECT_EQ("chr22", batch.chromosome[0].ToString());
+  EXPECT_EQ(1000u, batch.start[0]);
+  EXPECT_EQ(5000u, batch.end[0]);
+  EXPECT_EQ(1, batch.extended[0]);
+  EXPECT_EQ("cloneA", batch.name[0].ToString());
+  EXPECT_EQ('+', batch.strand[0]);
+  ASSERT_EQ(2u, batch.block_sizes.row_size(0));
+  EXPECT_EQ(488u, batch.block_sizes.row(0)[1]);
+  EXPECT_EQ(3512u, batch.block_starts.row(0)[1]);
+  EXPECT_EQ("chr1", batch.chromosome[1].ToString());
+  EXPECT_EQ(0, batch.extended[1]);
+  EXPECT_EQ(0u, batch.block_sizes.row_size(1));
+  EXPECT_EQ("", batch.name[1].ToString());
+
+  ASSERT_EQ(1u, parser.NextBatch(&batch, 2));
+  EXPECT_EQ("chr2", batch.chromosome[0].ToString());
+  EXPECT_EQ(0u, parser.NextBatch(&batch, 2));
+}
+
+TEST(BedParser, SkipsMalformedLines) {
+  const char data[] =
+      "chr1\t100\n"
+      "chr1\tabc\t200\n"
+      "chr1\t100\t99999999999\n"
+      "chr1\t100\t200\tx\t0\t+\t100\t200\t0\t2\t10\t0,50\n"
+      "chr2\t300\t400\n";
+  bios::BedParser parser;
+  parser.InitFromStream(new bios::MemoryLineStream(data, sizeof(data) - 1));
+  bios::Bed* b = parser.NextEntry();
+  ASSERT_TRUE(b != NULL);
+  EXPECT_EQ("chr2", b->chromosome());
+  EXPECT_EQ(300u, b->start());
+  delete b;
+  EXPECT_EQ(NULL, parser.NextEntry());
+}
+
+TEST(Bed, ChromosomeIds) {
+  const char data[] =
+      "chr2\t300\t400\n"
+      "chr10\t100\t200\n"
+      "chr2\t100\t200\n";
+  bios::BedParser parser;
+  parser.InitFromStream(new bios::MemoryLineStream(data, sizeof(data) - 1));
+  std::vector<bios::Bed> beds;
+  for (bios::Bed* b; (b = parser.NextEntry()) != NULL; ) {
+    beds.push_back(*b);
+    delete b;
+  }
+  ASSERT_EQ(3u, beds.size());
+  EXPECT_EQ(beds[0].chromosome_id(), beds[2].chromosome_id());
+  EXPECT_NE(beds[0].chromosome_id(), beds[1].chromosome_id());
+
+  // Sorting still orders by chromosome name, not by ID.
+  std::sort(beds.begin(), beds.end(), bios::Bed::Compare);
+  EXPECT_EQ("chr10", beds[0].chromosome());
+  EXPECT_EQ("chr2", beds[1].chromosome());
+  EXPECT_EQ(100u, beds[1].start());
+  EXPECT_EQ("chr2", beds[2].chromosome());
+  EXPECT_EQ(300u, beds[2].start());
+}
+
+TEST(BedParser, GetAllEntriesInArena) {
+  const char data[] =
+      "chr1\t11873\t14409\tuc001aaa.3\t0\t+\t11873\t11873\t0\t3\t"
+      "354,109,1189,\t0,739,1347,\n"
+      "chr2\t300\t400\n";
+  bios::BedParser parser;
+  parser.InitFromStream(new bios::MemoryLineStream(data, sizeof(data) - 1));
+  bios::Arena arena;
+  std::vector<bios::Bed*> beds;
+  ASSERT_EQ(2u, parser.GetAllEntries(&arena, &beds));
+  ASSERT_EQ(2u, beds.size());
+  EXPECT_EQ("chr1", beds[0]->chromosome());
+  EXPECT_EQ("uc001aaa.3", beds[0]->name());
+  EXPECT_EQ(3u, beds[0]->block_count());
+  EXPECT_EQ("chr1\t11873\t14409\tuc001aaa.3\t0\t+\t11873\t11873\t0\t3\t"
+            "354,109,1189\t0,739,1347", beds[0]->ToString());
+  EXPECT_EQ("chr2", beds[1]->chromosome());
+  EXPECT_FALSE(beds[1]->extended());
+  EXPECT_EQ(0u, parser.GetAllEntries(&arena, &beds));
+}
+
 /* vim: set ai ts=2 sts=2 sw=2 et: */
@@ -0,0 +1,70 @@
+#include <vector>
+
+#include <bios/arena.hh>
+#include <bios/bedgraph.hh>
+#include <gtest/gtest.h>
+
+static const char kBedGraph[] =
+    "track type=bedGraph\n"
+    "chr1\t0\t100\t1.5\n"
+    "chr1\t100\tx\t2.5\n"
+    "chr1\t100\t200\t-3\n"
+    "chr2\t0\t50\t0.25\n";
+
+TEST(BedGraphParser, ParseFromMemory) {
+  bios::BedGraphParser parser;
+  parser.InitFromStream(
+      new bios::MemoryLineStream(kBedGraph, sizeof(kBedGraph) - 1));
+  bios::BedGraph* bed_graph = parser.NextEntry();
+  ASSERT_TRUE(bed_graph != NULL);
+  EXPECT_EQ("chr1", bed_graph->chromosome());
+  EXPECT_EQ(100u, bed_graph->end());
+  EXPECT_EQ(1.5, bed_graph->value());
+  delete bed_graph;
+  // The malformed line is skipped.
+  bed_graph = parser.NextEntry();
+  ASSERT_TRUE(bed_graph != NULL);
+  EXPECT_EQ(-3.0, bed_graph->value());
+  delete bed_graph;
+}
+
+TEST(BedGraphParser, NextBatch) {
+  bios::BedGraphParser parser;
+  parser.InitFromStream(
+      new bios::MemoryLineStream(kBedGraph, sizeof(kBedGraph) - 1));
+  bios::BedGraphBatch batch;
+  ASSERT_EQ(2u, parser.NextBatch(&batch, 2));
+  EXPECT_EQ("chr1", batch.chromosome[1].ToString());
+  EXPECT_EQ(100u, batch.start[1]);
+  EXPECT_EQ(-3.0, batch.value[1]);
+  ASSERT_EQ(1u, parser.NextBatch(&batch, 2));
+  EXPECT_EQ("chr2", batch.chromosome[0].ToString());
+  EXPECT_EQ(0.25, batch.value[0]);
+  EXPECT_EQ(0u, parser.NextBatch(&batch, 2));
+}
+
+TEST(BedGraphParser, GetAllEntriesInArena) {
+  bios::BedGraphParser parser;
+  parser.InitFromStream(
+      new bios::MemoryLineStream(kBedGraph, sizeof(kBedGraph) - 1));
+  bios::Arena arena;
+  std::vector<bios::BedGraph*> entries;
+  ASSERT_EQ(3u, parser.GetAllEntries(&arena, &entries));
+  ASSERT_EQ(3u, entries.size());
+  EXPECT_EQ("chr1", entries[1]->chromosome());
+  EXPECT_EQ(-3.0, entries[1]->value());
+  EXPECT_EQ("chr2", entries[2]->chromosome());
+}
+
+TEST(BedGraphParser, GetValuesForUnknownChromosome) {
+  bios::BedGraphParser parser;
+  parser.InitFromStream(
+      new bios::MemoryLineStream(kBedGraph, sizeof(kBedGraph) - 1));
+  std::vector<bios::BedGraph> bed_graphs = parser.GetAllEntries();
+  EXPECT_TRUE(bios::BedGraphParser::GetValuesForRegion(
+      bed_graphs, "chrUnknownQuery", 0, 10).empty());
+  uint32_t id;
+  EXPECT_FALSE(bios::SymbolTable::Global()->Find("chrUnknownQuery", &id));
+}
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
@@ -0,0 +1,91 @@
+#include <string>
+
+#include <bios/blast.hh>
+#include <gtest/gtest.h>
+
+TEST(BlastParser, ParseFromMemory) {
+  const char data[] =
+      "q1\tchr1\t98.50\t200\t3\t0\t1\t200\t1000\t1199\t2e-100\t 363\n"
+      "q1\tchr2\t90.00\t100\t10\t1\t5\t104\t500\t599\t1e-20\t100\n"
+      "q2\tchr3\t100.00\t50\t0\t0\t1\t50\t10\t59\t0.001\t50.5\n";
+  bios::BlastParser parser;
+  parser.InitFromStream(new bios::MemoryLineStream(data, sizeof(data) - 1));
+
+  bios::BlastQuery* query = parser.NextQuery();
+  ASSERT_TRUE(query != NULL);
+  EXPECT_EQ("q1", query->q_name);
+  ASSERT_EQ(2u, query->entries.size());
+  const bios::BlastEntry& entry = query->entries[0];
+  EXPECT_EQ("chr1", entry.t_name);
+  EXPECT_EQ(98.5, entry.percent_identity);
+  EXPECT_EQ(200, entry.alignment_length);
+  EXPECT_EQ(3, entry.mis_matches);
+  EXPECT_EQ(1199, entry.t_end);
+  EXPECT_EQ(2e-100, entry.evalue);
+  EXPECT_EQ(363.0, entry.bit_score);
+  EXPECT_EQ("chr2", query->entries[1].t_name);
+
+  query = parser.NextQuery();
+  ASSERT_TRUE(query != NULL);
+  EXPECT_EQ("q2", query->q_name);
+  ASSERT_EQ(1u, query->entries.size());
+  EXPECT_EQ(50.5, query->entries[0].bit_score);
+
+  EXPECT_EQ(NULL, parser.NextQuery());
+}
+
+TEST(BlastParser, FieldMask) {
+  // Only the requested columns need to be valid.
+  const char data[] =
+      "q1\tchr1\tx\tx\tx\tx\tx\tx\tx\tx\t2e-100\t363\n";
+  bios::BlastParser parser;
+  parser.InitFromStream(new bios::MemoryLineStream(data, sizeof(data) - 1));
+  parser.SetFieldMask(bios::kBlastTargetName | bios::kBlastEvalue |
+                      bios::kBlastBitScore);
+  bios::BlastQuery* query = parser.NextQuery();
+  ASSERT_TRUE(query != NULL);
+  ASSERT_EQ(1u, query->entries.size());
+  EXPECT_EQ("chr1", query->entries[0].t_name);
+  EXPECT_EQ(2e-100, query->entries[0].evalue);
+  EXPECT_EQ(363.0, query->entries[0].bit_score);
+  EXPECT_EQ(0, query->entries[0].alignment_length);
+}
+
+TEST(BlastParser, NextBatch) {
+  const char data[] =
+      "q1\tchr1\t98.50\t200\t3\t0\t1\t200\t1000\t1199\t2e-100\t 363\n"
+      "q1\tchr2\t90.00\t100\t10\t1\t5\t104\t500\t599\t1e-20\t100\n"
+      "q2\tchr3\t100.00\t50\t0\t0\t1\t50\t10\t59\t0.001\t50.5\n";
+  bios::BlastParser parser;
+  parser.InitFromStream(new bios::MemoryLineStream(data, sizeof(data) - 1));
+  bios::BlastBatch batch;
+  ASSERT_EQ(3u, parser.NextBatch(&batch, 10));
+  EXPECT_EQ("q1", batch.q_name[1].ToString());
+  EXPECT_EQ("chr2", batch.t_name[1].ToString());
+  EXPECT_EQ(90.0, batch.percent_identity[1]);
+  EXPECT_EQ(599, batch.t_end[1]);
+  EXPECT_EQ(363.0, batch.bit_score[0]);
+  EXPECT_EQ("q2", batch.q_name[2].ToString());
+  EXPECT_EQ(0.001, batch.evalue[2]);
+  EXPECT_EQ(0u, parser.NextBatch(&batch, 10));
+}
+
+TEST(BlastQuery, FieldMaskNeedsOnlyLeadingColumns) {
+  bios::BlastQuery query;
+  EXPECT_TRUE(query.ProcessLine("chr1\t98.5", 0,
+                                bios::kBlastTargetName |
+                                bios::kBlastPercentIdentity));
+  ASSERT_EQ(1u, query.entries.size());
+  EXPECT_EQ(98.5, query.entries[0].percent_identity);
+  EXPECT_FALSE(query.ProcessLine("chr1\t98.5", 0, bios::kBlastEvalue));
+}
+
+TEST(BlastQuery, RejectsMalformedLine) {
+  bios::BlastQuery query;
+  EXPECT_FALSE(query.ProcessLine("chr1\t98.5\t200\t3"));
+  EXPECT_FALSE(query.ProcessLine("chr1\t98.5\tx\t3\t0\t1\t200\t1\t2\t0\t1"));
+  EXPECT_TRUE(query.ProcessLine("chr1\t98.5\t200\t3\t0\t1\t200\t1\t2\t0\t1"));
+  EXPECT_EQ(1u, query.entries.size());
+}
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
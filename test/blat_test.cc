@@ -0,0 +1,48 @@
+#include <string>
+
+#include <bios/blat.hh>
+#include <gtest/gtest.h>
+
+// The five header lines written by BLAT before the alignments.
+static const char kPslHeader[] =
+    "psLayout version 3\n"
+    "\n"
+    "match\tmis- \trep. \tN's\tQ gap\tQ gap\tT gap\tT gap\tstrand\tQ\n"
+    "     \tmatch\tmatch\t   \tcount\tbases\tcount\tbases\t      \tname\n"
+    "---------------------------------------------------------------\n";
+
+TEST(BlatParser, ParseFromMemory) {
+  std::string data = kPslHeader;
+  data += "59\t1\t0\t0\t0\t0\t1\t100\t+\tq1\t60\t0\t60\tchr1\t5000\t"
+          "1000\t1160\t2\t30,30,\t0,30,\t1000,1130,\n";
+  data += "60\t0\t0\t0\t0\t0\t0\t0\t-\tq1\t60\t0\t60\tchr2\t5000\t"
+          "10\t70\t1\t60,\t0,\t10,\n";
+  data += "20\t0\t0\t0\t0\t0\t0\t0\t+\tq2\t20\t0\t20\tchr3\t900\t"
+          "10\tbad\t1\t20,\t0,\t10,\n";
+  bios::BlatParser parser;
+  parser.InitFromStream(new bios::MemoryLineStream(data));
+
+  bios::BlatQuery* query = parser.NextQuery();
+  ASSERT_TRUE(query != NULL);
+  EXPECT_EQ("q1", query->q_name);
+  ASSERT_EQ(2u, query->entries.size());
+  const bios::PslEntry& entry = query->entries[0];
+  EXPECT_EQ(59, entry.matches);
+  EXPECT_EQ(100, entry.t_base_insert);
+  EXPECT_EQ('+', entry.strand);
+  EXPECT_EQ("chr1", entry.t_name());
+  EXPECT_EQ(1160, entry.t_end);
+  ASSERT_EQ(2u, entry.block_sizes.size());
+  EXPECT_EQ(30, entry.block_sizes[1]);
+  EXPECT_EQ(1130, entry.t_starts[1]);
+  EXPECT_EQ('-', query->entries[1].strand);
+
+  // The malformed alignment of q2 is skipped.
+  query = parser.NextQuery();
+  ASSERT_TRUE(query != NULL);
+  EXPECT_EQ("q2", query->q_name);
+  EXPECT_EQ(0u, query->entries.size());
+  EXPECT_EQ(NULL, parser.NextQuery());
+}
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
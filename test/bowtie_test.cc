@@ -0,0 +1,83 @@
+#include <string>
+#include <vector>
+
+#include <bios/bowtie.hh>
+#include <gtest/gtest.h>
+
+TEST(BowtieParser, ParseFromMemory) {
+  const char data[] =
+      "r1\t+\tchr1\t240849136\tGGCTTAAAAG\tIIIIIIIIII\t0\t9:C>G,6:T>G\n"
+      "r1\t-\tchrX\t98759270\tCTCACCCCGT\tIIIIIIIIII\t2\t\n"
+      "r2\t-\tchr16\t80796190\tTAGATGTGTG\tIIIIIIIIII\t785\t\n";
+  bios::BowtieParser parser;
+  parser.InitFromStream(new bios::MemoryLineStream(data, sizeof(data) - 1));
+
+  bios::BowtieQuery* query = parser.NextQuery();
+  ASSERT_TRUE(query != NULL);
+  EXPECT_EQ("r1", query->sequence_name());
+  ASSERT_EQ(2u, query->entries().size());
+  const bios::BowtieEntry& entry = query->entries()[0];
+  EXPECT_EQ('+', entry.strand());
+  EXPECT_EQ("chr1", entry.chromosome());
+  EXPECT_EQ(240849136, entry.position());
+  EXPECT_EQ("GGCTTAAAAG", entry.sequence());
+  ASSERT_EQ(2u, entry.mismatches().size());
+  EXPECT_EQ(9, entry.mismatches()[0].offset);
+  EXPECT_EQ('C', entry.mismatches()[0].reference_base);
+  EXPECT_EQ('G', entry.mismatches()[0].read_base);
+  EXPECT_EQ(0u, query->entries()[1].mismatches().size());
+
+  query = parser.NextQuery();
+  ASSERT_TRUE(query != NULL);
+  EXPECT_EQ("r2", query->sequence_name());
+  EXPECT_EQ(NULL, parser.NextQuery());
+}
+
+TEST(BowtieParser, NextBatch) {
+  const char data[] =
+      "r1\t+\tchr1\t240849136\tGGCTTAAAAG\tIIIIIIIIII\t0\t9:C>G,6:T>G\n"
+      "r1\t-\tchrX\t98759270\tCTCACCCCGT\tIIIIIIIIII\t2\t\n"
+      "r2\t-\tchr16\tbad\tTAGATGTGTG\tIIIIIIIIII\t785\t\n";
+  bios::BowtieParser parser;
+  parser.InitFromStream(new bios::MemoryLineStream(data, sizeof(data) - 1));
+  bios::BowtieBatch batch;
+  ASSERT_EQ(2u, parser.NextBatch(&batch, 10));
+  EXPECT_EQ("r1", batch.read_name[0].ToString());
+  EXPECT_EQ('-', batch.strand[1]);
+  EXPECT_EQ("chrX", batch.chromosome[1].ToString());
+  EXPECT_EQ(98759270, batch.position[1]);
+  EXPECT_EQ("GGCTTAAAAG", batch.sequence[0].ToString());
+  ASSERT_EQ(2u, batch.mismatches.row_size(0));
+  EXPECT_EQ(6, batch.mismatches.row(0)[1].offset);
+  EXPECT_EQ('G', batch.mismatches.row(0)[1].read_base);
+  EXPECT_EQ(0u, batch.mismatches.row_size(1));
+  EXPECT_EQ(0u, parser.NextBatch(&batch, 10));
+}
+
+TEST(BowtieQuery, RejectsMalformedLine) {
+  bios::BowtieQuery query;
+  EXPECT_FALSE(query.ProcessLine("+\tchr1\t100"));
+  EXPECT_FALSE(query.ProcessLine("+\tchr1\tabc\tACGT\tIIII\t0\t"));
+  EXPECT_FALSE(query.ProcessLine("+\tchr1\t100\tACGT\tIIII\t0\t9:C"));
+  EXPECT_TRUE(query.ProcessLine("+\tchr1\t100\tACGT\tIIII\t0\t"));
+  EXPECT_EQ(1u, query.entries().size());
+}
+
+TEST(BowtieParser, GetAllQueries) {
+  const char data[] =
+      "r1\t+\tchr1\t240849136\tGGCTTAAAAG\tIIIIIIIIII\t0\t9:C>G\n"
+      "r1\t-\tchrX\t98759270\tCTCACCCCGT\tIIIIIIIIII\t2\t\n"
+      "r2\t-\tchr16\t80796190\tTAGATGTGTG\tIIIIIIIIII\t785\t\n";
+  bios::BowtieParser parser;
+  parser.InitFromStream(new bios::MemoryLineStream(data, sizeof(data) - 1));
+  std::vector<bios::BowtieQuery> queries = parser.GetAllQueries();
+  ASSERT_EQ(2u, queries.size());
+  EXPECT_EQ("r1", queries[0].sequence_name());
+  ASSERT_EQ(2u, queries[0].entries().size());
+  EXPECT_EQ("chrX", queries[0].entries()[1].chromosome());
+  EXPECT_EQ(1u, queries[0].entries()[0].mismatches().size());
+  EXPECT_EQ("r2", queries[1].sequence_name());
+  EXPECT_EQ("TAGATGTGTG", queries[1].entries()[0].sequence());
+}
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+#include <bios/column.hh>
+
+TEST(StringColumn, AppendAndRead) {
+  bios::StringColumn column;
+  EXPECT_TRUE(column.empty());
+  column.Append("chr1");
+  column.Append("");
+  column.Append("chr22");
+  ASSERT_EQ(3u, column.size());
+  EXPECT_EQ("chr1", column[0].ToString());
+  EXPECT_EQ("", column[1].ToString());
+  EXPECT_EQ("chr22", column[2].ToString());
+  EXPECT_EQ("chr1chr22", column.data());
+  ASSERT_EQ(4u, column.offsets().size());
+  EXPECT_EQ(4u, column.offsets()[2]);
+  column.clear();
+  EXPECT_TRUE(column.empty());
+  EXPECT_EQ(1u, column.offsets().size());
+}
+
+TEST(ListColumn, AppendAndRead) {
+  bios::ListColumn<int> column;
+  column.AddValue(1);
+  column.AddValue(2);
+  column.EndRow();
+  column.EndRow();
+  column.AddValue(3);
+  column.EndRow();
+  ASSERT_EQ(3u, column.size());
+  EXPECT_EQ(2u, column.row_size(0));
+  EXPECT_EQ(2, column.row(0)[1]);
+  EXPECT_EQ(0u, column.row_size(1));
+  EXPECT_EQ(1u, column.row_size(2));
+  EXPECT_EQ(3, column.row(2)[0]);
+  EXPECT_EQ(3u, column.values().size());
+  column.clear();
+  EXPECT_TRUE(column.empty());
+}
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
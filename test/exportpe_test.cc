@@ -0,0 +1,79 @@
+#include <string>
+
+#include <bios/exportpe.hh>
+#include <gtest/gtest.h>
+
+static const char kEnd1[] =
+    "HWI-ST1\t1\t2\t3\t100\t200\t0\t1\tACGT\tIIII\tchr1.fa\t\t1000\tF\t4\t"
+    "50\t100\tchr1.fa\t\t300\tR\tY\n"
+    "HWI-ST1\t1\t2\t3\t101\t201\t0\t1\tACGT\tIIII\tNM\t\t\t\t\t\t\t\t\t\t\tN\n";
+static const char kEnd2[] =
+    "HWI-ST1\t1\t2\t3\t100\t200\t0\t2\tTTTT\tIIII\tchr1.fa\t\t1300\tR\t4\t"
+    "40\t100\tchr1.fa\t\t-300\tF\tY\n"
+    "HWI-ST1\t1\t2\t3\t101\t201\t0\t2\tTTTT\tIIII\tNM\t\t\t\t\t\t\t\t\t\t\tN\n";
+
+TEST(ExportPEParser, ParseFromMemory) {
+  bios::ExportPEParser parser;
+  parser.InitFromStream(
+      new bios::MemoryLineStream(kEnd1, sizeof(kEnd1) - 1),
+      new bios::MemoryLineStream(kEnd2, sizeof(kEnd2) - 1));
+
+  bios::ExportPE* entry = parser.NextEntry();
+  ASSERT_TRUE(entry != NULL);
+  EXPECT_EQ("HWI-ST1", entry->end1->machine);
+  EXPECT_EQ(100, entry->end1->x_coord);
+  EXPECT_EQ(1000, entry->end1->position);
+  EXPECT_EQ('F', entry->end1->strand);
+  EXPECT_EQ(50, entry->end1->single_score);
+  EXPECT_EQ(-300, entry->end2->partner_offset);
+  EXPECT_EQ('Y', entry->end2->filter);
+  delete entry;
+}
+
+// Counts the pairs left in parser, which must all be well formed.
+static int CountEntries(bios::ExportPEParser* parser) {
+  int count = 0;
+  for (bios::ExportPE* entry; (entry = parser->NextEntry()) != NULL; ) {
+    ++count;
+    delete entry;
+  }
+  return count;
+}
+
+TEST(ExportPEParser, ReadsLastPair) {
+  bios::ExportPEParser memory_parser;
+  memory_parser.InitFromStream(
+      new bios::MemoryLineStream(kEnd1, sizeof(kEnd1) - 1),
+      new bios::MemoryLineStream(kEnd2, sizeof(kEnd2) - 1));
+  EXPECT_EQ(2, CountEntries(&memory_parser));
+
+  bios::ExportPEParser file_parser;
+  file_parser.InitFromFile("./in/pair_1.export", "./in/pair_2.export");
+  EXPECT_EQ(2, CountEntries(&file_parser));
+
+  // A single pair is also the last one.
+  const char end1[] =
+      "HWI-ST1\t1\t2\t3\t101\t201\t0\t1\tACGT\tIIII\tNM\t\t\t\t\t\t\t\t\t\t\tN";
+  const char end2[] =
+      "HWI-ST1\t1\t2\t3\t101\t201\t0\t2\tTTTT\tIIII\tNM\t\t\t\t\t\t\t\t\t\t\tN"
+      "\n";
+  bios::ExportPEParser single_parser;
+  single_parser.InitFromStream(
+      new bios::MemoryLineStream(end1, sizeof(end1) - 1),
+      new bios::MemoryLineStream(end2, sizeof(end2) - 1));
+  EXPECT_EQ(1, CountEntries(&single_parser));
+}
+
+TEST(ExportPEParser, RejectsMalformedLine) {
+  const char end1[] =
+      "HWI-ST1\t1\t2\t3\tx\t200\t0\t1\tACGT\tIIII\tNM\t\t\t\t\t\t\t\t\t\t\tN\n";
+  const char end2[] =
+      "HWI-ST1\t1\t2\t3\t100\t200\t0\t2\tACGT\tIIII\tNM\t\t\t\t\t\t\t\t\t\t\tN\n";
+  bios::ExportPEParser parser;
+  parser.InitFromStream(
+      new bios::MemoryLineStream(end1, sizeof(end1) - 1),
+      new bios::MemoryLineStream(end2, sizeof(end2) - 1));
+  EXPECT_EQ(NULL, parser.NextEntry());
+}
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
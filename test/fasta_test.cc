@@ -0,0 +1,72 @@
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <bios/fasta.hh>
+#include <gtest/gtest.h>
+
+static const char kFasta[] =
+    ">seq1 first sequence\n"
+    "ACGTACGTAC\n"
+    "GTAC\n"
+    "\n"
+    ">  seq2\n"
+    "TTTT\n"
+    ">seq3\n";
+
+TEST(FastaParser, NextSequence) {
+  bios::FastaParser parser;
+  parser.InitFromStream(new bios::MemoryLineStream(kFasta, sizeof(kFasta) - 1));
+  bios::Seq* seq = parser.NextSequence(false);
+  ASSERT_TRUE(seq != NULL);
+  EXPECT_EQ("seq1 first sequence", seq->name);
+  EXPECT_STREQ("ACGTACGTACGTAC", seq->sequence);
+  EXPECT_EQ(14u, seq->size);
+  delete seq;
+
+  seq = parser.NextSequence(true);
+  ASSERT_TRUE(seq != NULL);
+  EXPECT_EQ("seq2", seq->name);
+  EXPECT_STREQ("TTTT", seq->sequence);
+  delete seq;
+
+  seq = parser.NextSequence(true);
+  ASSERT_TRUE(seq != NULL);
+  EXPECT_EQ("seq3", seq->name);
+  EXPECT_STREQ("", seq->sequence);
+  EXPECT_EQ(0u, seq->size);
+  delete seq;
+
+  EXPECT_EQ(NULL, parser.NextSequence(true));
+}
+
+TEST(FastaParser, ReadAllSequences) {
+  bios::FastaParser parser;
+  parser.InitFromStream(new bios::MemoryLineStream(kFasta, sizeof(kFasta) - 1));
+  std::vector<bios::Seq> seqs = parser.ReadAllSequences(true);
+  ASSERT_EQ(3u, seqs.size());
+  EXPECT_EQ("seq1", seqs[0].name);
+  EXPECT_STREQ("ACGTACGTACGTAC", seqs[0].sequence);
+  EXPECT_EQ("seq2", seqs[1].name);
+  EXPECT_EQ(4u, seqs[1].size);
+}
+
+TEST(Seq, MoveTransfersBuffer) {
+  bios::FastaParser parser;
+  parser.InitFromStream(new bios::MemoryLineStream(kFasta, sizeof(kFasta) - 1));
+  bios::Seq seq;
+  ASSERT_TRUE(parser.NextSequence(true, &seq));
+  char* buffer = seq.sequence;
+  bios::Seq moved(std::move(seq));
+  EXPECT_EQ(buffer, moved.sequence);
+  EXPECT_TRUE(seq.sequence == NULL);
+  EXPECT_EQ(0u, seq.size);
+
+  bios::Seq assigned;
+  assigned = std::move(moved);
+  EXPECT_EQ(buffer, assigned.sequence);
+  EXPECT_EQ("seq1", assigned.name);
+  EXPECT_TRUE(moved.sequence == NULL);
+}
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
@@ -0,0 +1,55 @@
+#include <string>
+#include <vector>
+
+#include <bios/fastq.hh>
+#include <gtest/gtest.h>
+
+static const char kFastq[] =
+    "@read1 lane 1\n"
+    "ACGT\n"
+    "+\n"
+    "IIII\n"
+    "@read2\n"
+    "GGCC\n"
+    "+read2\n"
+    "@@II\n";
+
+TEST(FastqParser, NextSequence) {
+  bios::FastqParser parser;
+  parser.InitFromStream(new bios::MemoryLineStream(kFastq, sizeof(kFastq) - 1));
+  bios::Fastq* fq = parser.NextSequence(true);
+  ASSERT_TRUE(fq != NULL);
+  EXPECT_EQ("read1", fq->seq->name);
+  EXPECT_STREQ("ACGT", fq->seq->sequence);
+  EXPECT_EQ(4u, fq->seq->size);
+  EXPECT_STREQ("IIII", fq->quality);
+  delete fq;
+
+  fq = parser.NextSequence(false);
+  ASSERT_TRUE(fq != NULL);
+  EXPECT_EQ("read2", fq->seq->name);
+  // A quality line may start with '@'.
+  EXPECT_STREQ("@@II", fq->quality);
+  delete fq;
+
+  EXPECT_EQ(NULL, parser.NextSequence(true));
+}
+
+TEST(FastqParser, ReadAllSequences) {
+  bios::FastqParser parser;
+  parser.InitFromStream(new bios::MemoryLineStream(kFastq, sizeof(kFastq) - 1));
+  std::vector<bios::Fastq> fqs = parser.ReadAllSequences(false);
+  ASSERT_EQ(2u, fqs.size());
+  EXPECT_EQ("read1 lane 1", fqs[0].seq->name);
+  EXPECT_STREQ("GGCC", fqs[1].seq->sequence);
+  EXPECT_STREQ("@@II", fqs[1].quality);
+}
+
+TEST(FastqParser, MissingQualityId) {
+  const char data[] = "@read1\nACGT\nIIII\n";
+  bios::FastqParser parser;
+  parser.InitFromStream(new bios::MemoryLineStream(data, sizeof(data) - 1));
+  EXPECT_EQ(NULL, parser.NextSequence(true));
+}
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
@@ -0,0 +1,111 @@
+#include <cstdlib>
+#include <string>
+#include <utility>
+
+#include <gtest/gtest.h>
+#include <bios/fields.hh>
+#include <bios/worditer.hh>
+
+TEST(FieldSplitter, EmptyLine) {
+  bios::FieldSplitter fields;
+  EXPECT_EQ(1, fields.Split("", '\t'));
+  EXPECT_TRUE(fields[0].empty());
+}
+
+TEST(FieldSplitter, SplitsTabs) {
+  bios::FieldSplitter fields;
+  ASSERT_EQ(3, fields.Split("chr1\t100\t200", '\t'));
+  EXPECT_EQ("chr1", fields[0].ToString());
+  EXPECT_EQ("100", fields[1].ToString());
+  EXPECT_EQ("200", fields.field(2).ToString());
+}
+
+TEST(FieldSplitter, EmptyFields) {
+  bios::FieldSplitter fields;
+  ASSERT_EQ(4, fields.Split(",a,,", ','));
+  EXPECT_EQ("", fields[0].ToString());
+  EXPECT_EQ("a", fields[1].ToString());
+  EXPECT_EQ("", fields[2].ToString());
+  EXPECT_EQ("", fields[3].ToString());
+}
+
+TEST(FieldSplitter, ManyFields) {
+  std::string line;
+  for (int i = 0; i < 1000; ++i) {
+    if (i > 0) {
+      line += '\t';
+    }
+    line += static_cast<char>('a' + i % 26);
+  }
+  bios::FieldSplitter fields;
+  ASSERT_EQ(1000, fields.Split(line, '\t'));
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(std::string(1, 'a' + i % 26), fields[i].ToString());
+  }
+  // The splitter is reused for a shorter line.
+  ASSERT_EQ(2, fields.Split("x\ty", '\t'));
+  EXPECT_EQ("y", fields[1].ToString());
+}
+
+TEST(FieldSplitter, MaxFields) {
+  bios::FieldSplitter fields;
+  ASSERT_EQ(2, fields.Split("a\tbb\tc\td", '\t', 2));
+  EXPECT_EQ("a", fields[0].ToString());
+  EXPECT_EQ("bb", fields[1].ToString());
+  ASSERT_EQ(4, fields.Split("a\tbb\tc\td", '\t', 4));
+  EXPECT_EQ("d", fields[3].ToString());
+  ASSERT_EQ(4, fields.Split("a\tbb\tc\td", '\t', 10));
+  ASSERT_EQ(0, fields.Split("a\tb", '\t', 0));
+
+  std::string line(100, '\t');
+  ASSERT_EQ(40, fields.Split(line, '\t', 40));
+  EXPECT_TRUE(fields[39].empty());
+}
+
+TEST(FieldSplitter, CopiedAndMoved) {
+  // Copies and moved-from splitters start with no capacity for offsets.
+  bios::FieldSplitter original;
+  bios::FieldSplitter copy(original);
+  ASSERT_EQ(2u, copy.Split("a\tb", '\t'));
+  EXPECT_EQ(bios::StringPiece("b"), copy[1]);
+
+  bios::FieldSplitter moved(std::move(copy));
+  ASSERT_EQ(3u, copy.Split("a\tb\tc", '\t'));
+  EXPECT_EQ(bios::StringPiece("c"), copy[2]);
+  ASSERT_EQ(1u, moved.Split("a", '\t'));
+
+  bios::FieldSplitter assigned;
+  assigned = bios::FieldSplitter(original);
+  std::string line(99, '\t');
+  EXPECT_EQ(100u, assigned.Split(line, '\t'));
+}
+
+TEST(FieldSplitter, MatchesTokenizer) {
+  srand(1);
+  bios::FieldSplitter fields;
+  for (int n = 0; n < 2000; ++n) {
+    std::string line;
+    int length = rand() % 200;
+    for (int i = 0; i < length; ++i) {
+      line += rand() % 4 == 0 ? '\t' : 'x';
+    }
+    bios::Tokenizer tokenizer(line, "\t", false);
+    size_t count = fields.Split(line, '\t');
+    bios::StringPiece word;
+    size_t i = 0;
+    for (; tokenizer.Next(&word); ++i) {
+      ASSERT_LT(i, count);
+      EXPECT_EQ(word, fields[i]);
+    }
+    // Tokenizer does not yield the empty field after a trailing separator,
+    // or for an empty line.
+    size_t expected = i;
+    if (line.empty() || line[line.size() - 1] == '\t') {
+      EXPECT_TRUE(fields[i].empty());
+      ++expected;
+    }
+    EXPECT_EQ(expected, count);
+  }
+}
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
@@ -0,0 +1,95 @@
+#include <cstdio>
+#include <string>
+#include <fstream>
+#include <sstream>
+
+#include <gtest/gtest.h>
+#include <bios/gzip.hh>
+
+static std::string ReadFile(const char* filename) {
+  std::ifstream file(filename, std::ios::binary);
+  std::stringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+TEST(GzipReader, IsGzip) {
+  std::string compressed = ReadFile("./in/lines.txt.gz");
+  EXPECT_TRUE(bios::GzipReader::IsGzip(compressed.data(), compressed.size()));
+  std::string plain = ReadFile("./in/lines.txt");
+  EXPECT_FALSE(bios::GzipReader::IsGzip(plain.data(), plain.size()));
+}
+
+TEST(GzipReader, ReadFromMemory) {
+  std::string compressed = ReadFile("./in/lines.txt.gz");
+  bios::GzipReader reader;
+  ASSERT_TRUE(reader.Open(compressed.data(), compressed.size()));
+  char buffer[256];
+  size_t size = reader.Read(buffer, sizeof(buffer));
+  EXPECT_EQ(ReadFile("./in/lines.txt"), std::string(buffer, size));
+  EXPECT_EQ(0u, reader.Read(buffer, sizeof(buffer)));
+  EXPECT_FALSE(reader.error());
+}
+
+TEST(BgzfReader, IsBgzf) {
+  std::string bgzf = ReadFile("./in/lines.txt.bgz");
+  EXPECT_TRUE(bios::BgzfReader::IsBgzf(bgzf.data(), bgzf.size()));
+  std::string gzip = ReadFile("./in/lines.txt.gz");
+  EXPECT_FALSE(bios::BgzfReader::IsBgzf(gzip.data(), gzip.size()));
+}
+
+TEST(BgzfReader, ReadFromMemory) {
+  std::string bgzf = ReadFile("./in/lines.txt.bgz");
+  bios::BgzfReader reader(2);
+  ASSERT_TRUE(reader.Open(bgzf.data(), bgzf.size()));
+  std::string output;
+  char buffer[7];
+  for (size_t size; (size = reader.Read(buffer, sizeof(buffer))) > 0; ) {
+    output.append(buffer, size);
+  }
+  EXPECT_EQ(ReadFile("./in/lines.txt"), output);
+  EXPECT_FALSE(reader.error());
+}
+
+TEST(BgzfReader, CorruptInput) {
+  std::string bgzf = ReadFile("./in/lines.txt.bgz");
+  bgzf[20] ^= 0xff;
+  bios::BgzfReader reader(2);
+  ASSERT_TRUE(reader.Open(bgzf.data(), bgzf.size()));
+  char buffer[256];
+  while (reader.Read(buffer, sizeof(buffer)) > 0) {
+  }
+  EXPECT_TRUE(reader.error());
+}
+
+TEST(BgzfReader, RejectsOversizedBlock) {
+  std::string bgzf = ReadFile("./in/lines.txt.bgz");
+  // Claim 70000 uncompressed bytes in the ISIZE field of the first block.
+  size_t block_size = (static_cast<unsigned char>(bgzf[16]) |
+                       (static_cast<unsigned char>(bgzf[17]) << 8)) + 1;
+  bgzf[block_size - 4] = 0x70;
+  bgzf[block_size - 3] = 0x11;
+  bgzf[block_size - 2] = 0x01;
+  EXPECT_FALSE(bios::BgzfReader::IsBgzf(bgzf.data(), bgzf.size()));
+  bios::BgzfReader reader(2);
+  ASSERT_TRUE(reader.Open(bgzf.data(), bgzf.size()));
+  char buffer[256];
+  EXPECT_EQ(0u, reader.Read(buffer, sizeof(buffer)));
+  EXPECT_TRUE(reader.error());
+}
+
+TEST(BgzfReader, ReadsEmptyFile) {
+  // Only the end-of-file marker, an empty block.
+  std::string bgzf = ReadFile("./in/lines.txt.bgz");
+  size_t block_size = (static_cast<unsigned char>(bgzf[16]) |
+                       (static_cast<unsigned char>(bgzf[17]) << 8)) + 1;
+  bgzf.erase(0, block_size);
+  ASSERT_TRUE(bios::BgzfReader::IsBgzf(bgzf.data(), bgzf.size()));
+  bios::BgzfReader reader(1);
+  ASSERT_TRUE(reader.Open(bgzf.data(), bgzf.size()));
+  char buffer[256];
+  EXPECT_EQ(0u, reader.Read(buffer, sizeof(buffer)));
+  EXPECT_FALSE(reader.error());
+}
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
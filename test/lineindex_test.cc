@@ -0,0 +1,62 @@
+#include <string>
+#include <unistd.h>
+
+#include <bios/lineindex.hh>
+#include <bios/linestream.hh>
+#include <gtest/gtest.h>
+
+TEST(LineIndex, Build) {
+  bios::LineIndex index;
+  ASSERT_TRUE(index.Build("./in/lines.txt"));
+  ASSERT_EQ(4u, index.num_lines());
+  EXPECT_EQ(0u, index.LineOffset(0));
+  EXPECT_EQ(11u, index.LineOffset(1));
+  EXPECT_EQ(24u, index.LineOffset(2));
+  EXPECT_EQ(25u, index.LineOffset(3));
+  EXPECT_EQ(1u, index.LineAtOffset(11));
+  EXPECT_EQ(1u, index.LineAtOffset(23));
+  EXPECT_EQ(3u, index.LineAtOffset(33));
+  EXPECT_EQ(4u, index.LineAtOffset(34));
+}
+
+TEST(LineIndex, SaveAndLoad) {
+  const char* index_filename = "./lineindex_test.lidx";
+  bios::LineIndex built;
+  ASSERT_TRUE(built.Build("./in/lines.txt"));
+  ASSERT_TRUE(built.Save(index_filename));
+  bios::LineIndex loaded;
+  ASSERT_TRUE(loaded.Load("./in/lines.txt", index_filename));
+  ASSERT_EQ(built.num_lines(), loaded.num_lines());
+  for (uint64_t i = 0; i < loaded.num_lines(); ++i) {
+    EXPECT_EQ(built.LineOffset(i), loaded.LineOffset(i));
+  }
+  // The index does not describe a file of a different size.
+  EXPECT_FALSE(loaded.Load("./in/basic.bed", index_filename));
+  unlink(index_filename);
+}
+
+TEST(LineIndex, RejectsCompressedFile) {
+  bios::LineIndex index;
+  EXPECT_FALSE(index.Build("./in/lines.txt.gz"));
+}
+
+TEST(FileLineStream, SeekToLine) {
+  bios::LineIndex index;
+  ASSERT_TRUE(index.Build("./in/lines.txt"));
+  bios::FileLineStream ls("./in/lines.txt");
+  std::string line;
+  ASSERT_TRUE(ls.SeekToLine(index, 3));
+  EXPECT_EQ(3, ls.GetLineCount());
+  ASSERT_TRUE(ls.GetLine(line));
+  EXPECT_EQ("last line", line);
+  EXPECT_FALSE(ls.GetLine(line));
+  ASSERT_TRUE(ls.SeekToLine(index, 1));
+  ASSERT_TRUE(ls.GetLine(line));
+  EXPECT_EQ("second line", line);
+  ASSERT_TRUE(ls.SeekToOffset(0));
+  ASSERT_TRUE(ls.GetLine(line));
+  EXPECT_EQ("first line", line);
+  EXPECT_FALSE(ls.SeekToLine(index, 5));
+}
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
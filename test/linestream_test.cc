@@ -1,10 +1,277 @@
 #include <cstdlib>
+#include <string>
 
 #include <gtest/gtest.h>
-#include <bios/worditer.hh>
+#include <bios/linestream.hh>
+#include <bios/uring.hh>
 
-TEST(LineStream, ) {
+TEST(FileLineStream, NullFilename) {
+  bios::FileLineStream ls(NULL);
+  std::string line;
+  EXPECT_FALSE(ls.GetLine(line));
+  EXPECT_TRUE(ls.IsEof());
+}
+
+TEST(FileLineStream, ReadsLines) {
+  bios::FileLineStream ls("./in/lines.txt");
+  EXPECT_TRUE(ls.IsMapped());
+  std::string line;
+  ASSERT_TRUE(ls.GetLine(line));
+  EXPECT_EQ("first line", line);
+  ASSERT_TRUE(ls.GetLine(line));
+  EXPECT_EQ("second line", line);
+  ASSERT_TRUE(ls.GetLine(line));
+  EXPECT_EQ("", line);
+  ASSERT_TRUE(ls.GetLine(line));
+  EXPECT_EQ("last line", line);
+  EXPECT_FALSE(ls.GetLine(line));
+  EXPECT_TRUE(ls.IsEof());
+  EXPECT_EQ(4, ls.GetLineCount());
+}
+
+TEST(FileLineStream, StringPieceLines) {
+  bios::FileLineStream ls("./in/lines.txt");
+  bios::StringPiece line;
+  ASSERT_TRUE(ls.GetLine(&line));
+  EXPECT_EQ(bios::StringPiece("first line"), line);
+  ASSERT_TRUE(ls.GetLine(&line));
+  EXPECT_EQ(11u, line.size());
+}
+
+TEST(FileLineStream, BackAtEndOfFile) {
+  bios::FileLineStream ls("./in/lines.txt");
+  ls.SetBuffer(1);
+  bios::StringPiece line;
+  while (ls.GetLine(&line)) {
+    if (line == bios::StringPiece("last line")) {
+      break;
+    }
+  }
+  ls.Back(line);
+  EXPECT_FALSE(ls.IsEof());
+  std::string again;
+  ASSERT_TRUE(ls.GetLine(again));
+  EXPECT_EQ("last line", again);
+  EXPECT_TRUE(ls.IsEof());
+}
+
+TEST(FileLineStream, ReadsGzipFile) {
+  bios::FileLineStream ls("./in/lines.txt.gz");
+  EXPECT_TRUE(ls.IsCompressed());
+  std::string line;
+  ASSERT_TRUE(ls.GetLine(line));
+  EXPECT_EQ("first line", line);
+  ASSERT_TRUE(ls.GetLine(line));
+  EXPECT_EQ("second line", line);
+  ASSERT_TRUE(ls.GetLine(line));
+  ASSERT_TRUE(ls.GetLine(line));
+  EXPECT_EQ("last line", line);
+  EXPECT_FALSE(ls.GetLine(line));
+  EXPECT_TRUE(ls.IsEof());
+}
+
+TEST(FileLineStream, ReadsBgzfFile) {
+  bios::FileLineStream ls("./in/lines.txt.bgz");
+  EXPECT_TRUE(ls.IsCompressed());
+  std::string line;
+  int count = 0;
+  while (ls.GetLine(line)) {
+    ++count;
+  }
+  EXPECT_EQ(4, count);
+  EXPECT_EQ("last line", line);
+
+  bios::FileLineStream single("./in/lines.txt.bgz",
+                              bios::FileLineStream::kReadMmap, 1);
+  EXPECT_TRUE(single.IsCompressed());
+  for (count = 0; single.GetLine(line); ++count) {
+  }
+  EXPECT_EQ(4, count);
+}
+
+TEST(FileLineStream, ReadModes) {
+  bios::FileLineStream::ReadMode modes[] = {
+    bios::FileLineStream::kReadMmap,
+    bios::FileLineStream::kReadPlain,
+    bios::FileLineStream::kReadUring
+  };
+  for (size_t i = 0; i < sizeof(modes) / sizeof(modes[0]); ++i) {
+    bios::FileLineStream ls("./in/lines.txt", modes[i]);
+    if (modes[i] != bios::FileLineStream::kReadUring ||
+        bios::UringReader::IsSupported()) {
+      EXPECT_EQ(modes[i], ls.read_mode());
+    }
+    std::string all;
+    for (std::string line; ls.GetLine(line); ) {
+      all += line + "|";
+    }
+    EXPECT_EQ("first line|second line||last line|", all);
+  }
+}
+
+TEST(FileLineStream, UringFallsBackForGzipFile) {
+  bios::FileLineStream ls("./in/lines.txt.gz",
+                          bios::FileLineStream::kReadUring);
+  EXPECT_EQ(bios::FileLineStream::kReadMmap, ls.read_mode());
+  EXPECT_TRUE(ls.IsCompressed());
+}
+
+TEST(GzipLineStream, ReadsGzipFile) {
+  bios::GzipLineStream ls("./in/lines.txt.gz");
+  std::string line;
+  int count = 0;
+  while (ls.GetLine(line)) {
+    ++count;
+  }
+  EXPECT_EQ(4, count);
+  EXPECT_EQ("last line", line);
+}
+
+TEST(GzipLineStream, Prefetch) {
+  bios::GzipLineStream ls("./in/lines.txt.gz");
+  ASSERT_TRUE(ls.EnablePrefetch(2));
+  EXPECT_FALSE(ls.EnablePrefetch(2));
+  std::string line;
+  int count = 0;
+  while (ls.GetLine(line)) {
+    ++count;
+  }
+  EXPECT_EQ(4, count);
+  EXPECT_EQ("last line", line);
+  EXPECT_TRUE(ls.IsEof());
+  EXPECT_EQ(1u, ls.GetPrefetchStats().blocks);
+}
+
+TEST(FileLineStream, NoPrefetchForMappedFile) {
+  bios::FileLineStream ls("./in/lines.txt");
+  EXPECT_TRUE(ls.IsMapped());
+  EXPECT_FALSE(ls.EnablePrefetch(2));
+  EXPECT_EQ(0u, ls.GetPrefetchStats().blocks);
+}
+
+TEST(MemoryLineStream, ReadsBuffer) {
+  const char data[] = "first line\nsecond line\r\n\nlast line";
+  bios::MemoryLineStream ls(data, sizeof(data) - 1);
+  bios::StringPiece line;
+  ASSERT_TRUE(ls.GetLine(&line));
+  EXPECT_EQ(bios::StringPiece("first line"), line);
+  EXPECT_EQ(data, line.data());
+  ASSERT_TRUE(ls.GetLine(&line));
+  EXPECT_EQ(bios::StringPiece("second line"), line);
+  ASSERT_TRUE(ls.GetLine(&line));
+  EXPECT_TRUE(line.empty());
+  ASSERT_TRUE(ls.GetLine(&line));
+  EXPECT_EQ(bios::StringPiece("last line"), line);
+  EXPECT_FALSE(ls.GetLine(&line));
+  EXPECT_TRUE(ls.IsEof());
+  EXPECT_EQ("first line\nsecond line\r\n\nlast line", std::string(data));
+}
+
+TEST(MemoryLineStream, EmptyBuffer) {
+  bios::MemoryLineStream ls(NULL, 0);
+  std::string line;
+  EXPECT_FALSE(ls.GetLine(line));
+  EXPECT_TRUE(ls.IsEof());
+}
+
+TEST(MemoryLineStream, GetLines) {
+  const char data[] = "a\nb\r\n\nc";
+  bios::MemoryLineStream ls(data, sizeof(data) - 1);
+  ls.SetBuffer(1);
+  std::vector<bios::StringPiece> lines;
+  ASSERT_EQ(2u, ls.GetLines(&lines, 2));
+  EXPECT_EQ(bios::StringPiece("a"), lines[0]);
+  EXPECT_EQ(bios::StringPiece("b"), lines[1]);
+  ls.Back(lines[1]);
+  ASSERT_EQ(3u, ls.GetLines(&lines, 10));
+  EXPECT_EQ(bios::StringPiece("b"), lines[0]);
+  EXPECT_TRUE(lines[1].empty());
+  EXPECT_EQ(bios::StringPiece("c"), lines[2]);
+  EXPECT_EQ(0u, ls.GetLines(&lines, 10));
+  EXPECT_TRUE(lines.empty());
+  EXPECT_EQ(4, ls.GetLineCount());
+}
+
+TEST(MemoryLineStream, GetLinesReturnsAllPushedBackLines) {
+  const char data[] = "a\nb\n\nc";
+  bios::MemoryLineStream ls(data, sizeof(data) - 1);
+  ls.SetBuffer(2);
+  std::vector<bios::StringPiece> lines;
+  ASSERT_EQ(2u, ls.GetLines(&lines, 2));
+  ls.Back(lines[1]);
+  ls.Back(lines[0]);
+  ASSERT_EQ(4u, ls.GetLines(&lines, 10));
+  EXPECT_EQ(bios::StringPiece("a"), lines[0]);
+  EXPECT_EQ(bios::StringPiece("b"), lines[1]);
+  EXPECT_TRUE(lines[2].empty());
+  EXPECT_EQ(bios::StringPiece("c"), lines[3]);
+
+  // A batch smaller than the push back buffer leaves the rest for later.
+  bios::MemoryLineStream partial(data, sizeof(data) - 1);
+  partial.SetBuffer(2);
+  ASSERT_EQ(2u, partial.GetLines(&lines, 2));
+  partial.Back(lines[1]);
+  partial.Back(lines[0]);
+  ASSERT_EQ(1u, partial.GetLines(&lines, 1));
+  EXPECT_EQ(bios::StringPiece("a"), lines[0]);
+  ASSERT_EQ(3u, partial.GetLines(&lines, 10));
+  EXPECT_EQ(bios::StringPiece("b"), lines[0]);
+  EXPECT_EQ(bios::StringPiece("c"), lines[2]);
+}
+
+TEST(GzipLineStream, GetLines) {
+  bios::GzipLineStream ls("./in/lines.txt.gz");
+  std::vector<bios::StringPiece> lines;
+  std::string all;
+  while (ls.GetLines(&lines, 3) > 0) {
+    for (size_t i = 0; i < lines.size(); ++i) {
+      all += lines[i].ToString() + "|";
+    }
+  }
+  EXPECT_EQ("first line|second line||last line|", all);
+}
+
+TEST(PipeLineStream, ReadsCommandOutput) {
+  bios::PipeLineStream ls("cat ./in/lines.txt | cat");
+  std::string line;
+  int count = 0;
+  while (ls.GetLine(line)) {
+    ++count;
+  }
+  EXPECT_EQ(4, count);
+  EXPECT_EQ("last line", line);
+}
+
+TEST(PipeLineStream, ReadsCommandOutputWithoutShell) {
+  bios::PipeLineStream ls("cat  ./in/lines.txt", false);
+  std::string line;
+  ASSERT_TRUE(ls.GetLine(line));
+  EXPECT_EQ("first line", line);
+  int count = 1;
+  while (ls.GetLine(line)) {
+    ++count;
+  }
+  EXPECT_EQ(4, count);
+  EXPECT_EQ("last line", line);
+}
+
+TEST(PipeLineStream, ReadsArgvOutput) {
+  const char* argv[] = { "cat", "./in/lines.txt", NULL };
+  bios::PipeLineStream ls(argv);
+  std::string line;
+  int count = 0;
+  while (ls.GetLine(line)) {
+    ++count;
+  }
+  EXPECT_EQ(4, count);
+}
 
+TEST(PipeLineStream, MissingProgram) {
+  const char* argv[] = { "./no-such-program", NULL };
+  bios::PipeLineStream ls(argv);
+  std::string line;
+  EXPECT_FALSE(ls.GetLine(line));
+  EXPECT_TRUE(ls.IsEof());
 }
 
 /* vim: set ai ts=2 sts=2 sw=2 et: */
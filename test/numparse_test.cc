@@ -0,0 +1,142 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <string>
+
+#include <gtest/gtest.h>
+#include <bios/numparse.hh>
+
+using bios::num::parse_field;
+
+TEST(NumParse, Int) {
+  int value = 7;
+  EXPECT_EQ(bios::num::kParseOk, parse_field("12345", &value));
+  EXPECT_EQ(12345, value);
+  EXPECT_EQ(bios::num::kParseOk, parse_field("-42", &value));
+  EXPECT_EQ(-42, value);
+  EXPECT_EQ(bios::num::kParseOk, parse_field("2147483647", &value));
+  EXPECT_EQ(2147483647, value);
+  EXPECT_EQ(bios::num::kParseOk, parse_field("-2147483648", &value));
+  EXPECT_EQ(std::numeric_limits<int>::min(), value);
+}
+
+TEST(NumParse, IntErrors) {
+  int value = 7;
+  EXPECT_EQ(bios::num::kParseEmpty, parse_field("", &value));
+  EXPECT_EQ(bios::num::kParseInvalid, parse_field("abc", &value));
+  EXPECT_EQ(bios::num::kParseInvalid, parse_field("12x", &value));
+  EXPECT_EQ(bios::num::kParseInvalid, parse_field(" 12", &value));
+  EXPECT_EQ(bios::num::kParseInvalid, parse_field("+12", &value));
+  EXPECT_EQ(bios::num::kParseInvalid, parse_field("-", &value));
+  EXPECT_EQ(bios::num::kParseInvalid, parse_field("1.5", &value));
+  EXPECT_EQ(bios::num::kParseOutOfRange, parse_field("2147483648", &value));
+  EXPECT_EQ(bios::num::kParseOutOfRange, parse_field("-2147483649", &value));
+  EXPECT_EQ(bios::num::kParseOutOfRange,
+            parse_field("99999999999999999999999", &value));
+  // The value is untouched on failure.
+  EXPECT_EQ(7, value);
+}
+
+TEST(NumParse, Unsigned) {
+  unsigned int value = 0;
+  EXPECT_EQ(bios::num::kParseOk, parse_field("4294967295", &value));
+  EXPECT_EQ(4294967295u, value);
+  EXPECT_EQ(bios::num::kParseOutOfRange, parse_field("4294967296", &value));
+  EXPECT_EQ(bios::num::kParseInvalid, parse_field("-1", &value));
+}
+
+TEST(NumParse, Int64) {
+  int64_t value = 0;
+  EXPECT_EQ(bios::num::kParseOk,
+            parse_field("-9223372036854775808", &value));
+  EXPECT_EQ(std::numeric_limits<int64_t>::min(), value);
+  EXPECT_EQ(bios::num::kParseOutOfRange,
+            parse_field("9223372036854775808", &value));
+  uint64_t uvalue = 0;
+  EXPECT_EQ(bios::num::kParseOk,
+            parse_field("18446744073709551615", &uvalue));
+  EXPECT_EQ(std::numeric_limits<uint64_t>::max(), uvalue);
+  EXPECT_EQ(bios::num::kParseOutOfRange,
+            parse_field("18446744073709551616", &uvalue));
+}
+
+TEST(NumParse, FromCharsStopsAtNonDigit) {
+  const char text[] = "12:A>G";
+  int value = 0;
+  bios::num::FromCharsResult result =
+      bios::num::from_chars(text, text + sizeof(text) - 1, &value);
+  EXPECT_EQ(bios::num::kParseOk, result.status);
+  EXPECT_EQ(text + 2, result.ptr);
+  EXPECT_EQ(12, value);
+  // Only the given range is read, so the text need not be terminated.
+  result = bios::num::from_chars(text, text + 1, &value);
+  EXPECT_EQ(text + 1, result.ptr);
+  EXPECT_EQ(1, value);
+}
+
+TEST(NumParse, Double) {
+  double value = 0;
+  EXPECT_EQ(bios::num::kParseOk, parse_field("98.5", &value));
+  EXPECT_EQ(98.5, value);
+  EXPECT_EQ(bios::num::kParseOk, parse_field("2e-05", &value));
+  EXPECT_EQ(2e-05, value);
+  EXPECT_EQ(bios::num::kParseOk, parse_field("1e-180", &value));
+  EXPECT_EQ(1e-180, value);
+  EXPECT_EQ(bios::num::kParseOk, parse_field("-.5", &value));
+  EXPECT_EQ(-0.5, value);
+  EXPECT_EQ(bios::num::kParseOk, parse_field("7.", &value));
+  EXPECT_EQ(7.0, value);
+  EXPECT_EQ(bios::num::kParseOk, parse_field("0.0", &value));
+  EXPECT_EQ(0.0, value);
+  EXPECT_EQ(bios::num::kParseOk, parse_field("1e-400", &value));
+  EXPECT_EQ(0.0, value);
+  EXPECT_EQ(bios::num::kParseOk, parse_field("-Inf", &value));
+  EXPECT_TRUE(std::isinf(value) && value < 0);
+  EXPECT_EQ(bios::num::kParseOk, parse_field("NaN", &value));
+  EXPECT_TRUE(std::isnan(value));
+}
+
+TEST(NumParse, DoubleErrors) {
+  double value = 3.0;
+  EXPECT_EQ(bios::num::kParseEmpty, parse_field("", &value));
+  EXPECT_EQ(bios::num::kParseInvalid, parse_field(".", &value));
+  EXPECT_EQ(bios::num::kParseInvalid, parse_field("e5", &value));
+  EXPECT_EQ(bios::num::kParseInvalid, parse_field("1e", &value));
+  EXPECT_EQ(bios::num::kParseInvalid, parse_field("1.5.2", &value));
+  EXPECT_EQ(bios::num::kParseInvalid, parse_field("infinit", &value));
+  EXPECT_EQ(bios::num::kParseOutOfRange, parse_field("1e400", &value));
+  EXPECT_EQ(3.0, value);
+}
+
+TEST(NumParse, DoubleMatchesStrtod) {
+  srand(1);
+  char text[64];
+  for (int i = 0; i < 200000; ++i) {
+    int kind = i % 4;
+    if (kind == 0) {
+      snprintf(text, sizeof(text), "%.*g", 1 + rand() % 17,
+               rand() / static_cast<double>(RAND_MAX) *
+               pow(10.0, rand() % 40 - 20));
+    } else if (kind == 1) {
+      snprintf(text, sizeof(text), "%d.%06d", rand() % 1000, rand() % 1000000);
+    } else if (kind == 2) {
+      snprintf(text, sizeof(text), "%de-%d", rand() % 100, rand() % 330);
+    } else {
+      // More digits than fit in the fast path.
+      snprintf(text, sizeof(text), "%d%d%d.%d%d", rand(), rand(), rand(),
+               rand(), rand());
+    }
+    double value = -1;
+    ASSERT_EQ(bios::num::kParseOk, parse_field(text, &value));
+    EXPECT_EQ(strtod(text, NULL), value);
+  }
+}
+
+TEST(NumParse, ReportsErrors) {
+  int value = 0;
+  EXPECT_TRUE(parse_field("10", &value, "BED start", 3));
+  EXPECT_FALSE(parse_field("x", &value, "BED start", 3));
+}
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
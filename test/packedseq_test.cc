@@ -0,0 +1,92 @@
+#include <string>
+#include <vector>
+
+#include <bios/packedseq.hh>
+#include <gtest/gtest.h>
+
+TEST(PackedSeq, PacksFourBasesPerByte) {
+  bios::PackedSeq packed;
+  packed.Pack("TCAGGACT", 8);
+  EXPECT_EQ(8u, packed.size());
+  ASSERT_EQ(2u, packed.packed().size());
+  // T=0 C=1 A=2 G=3, first base in the high bits.
+  EXPECT_EQ(0x1b, packed.packed()[0]);
+  EXPECT_EQ(0xe4, packed.packed()[1]);
+  EXPECT_EQ(G_BASE_VAL, packed.BaseValue(3));
+  EXPECT_TRUE(packed.n_blocks().empty());
+  EXPECT_TRUE(packed.mask_blocks().empty());
+}
+
+TEST(PackedSeq, NAndMaskRuns) {
+  const std::string dna = "ACGTNNNNacgtnNRYacGT";
+  bios::PackedSeq packed;
+  packed.Pack(dna.data(), dna.size());
+  ASSERT_EQ(2u, packed.n_blocks().size());
+  EXPECT_EQ(4u, packed.n_blocks()[0].start);
+  EXPECT_EQ(4u, packed.n_blocks()[0].size);
+  EXPECT_EQ(12u, packed.n_blocks()[1].start);
+  EXPECT_EQ(4u, packed.n_blocks()[1].size);
+  ASSERT_EQ(2u, packed.mask_blocks().size());
+  EXPECT_EQ(8u, packed.mask_blocks()[0].start);
+  EXPECT_EQ(5u, packed.mask_blocks()[0].size);
+  EXPECT_EQ(16u, packed.mask_blocks()[1].start);
+  EXPECT_EQ(2u, packed.mask_blocks()[1].size);
+  EXPECT_TRUE(packed.IsN(4));
+  EXPECT_TRUE(packed.IsN(15));
+  EXPECT_FALSE(packed.IsN(3));
+  EXPECT_FALSE(packed.IsN(16));
+
+  // IUPAC codes other than N come back as N.
+  EXPECT_EQ("ACGTNNNNacgtnNNNacGT", packed.Substring(0, dna.size()));
+}
+
+TEST(PackedSeq, ExtractSubranges) {
+  std::string dna;
+  for (int i = 0; i < 100; ++i) {
+    dna += "acGTNCaT"[i % 8];
+  }
+  bios::PackedSeq packed;
+  packed.Pack(dna.data(), dna.size());
+  for (uint32_t start = 0; start < dna.size(); start += 7) {
+    for (uint32_t end = start; end <= dna.size(); end += 5) {
+      EXPECT_EQ(dna.substr(start, end - start),
+                packed.Substring(start, end));
+    }
+  }
+  char out[4];
+  EXPECT_FALSE(packed.Extract(98, 102, out));
+}
+
+TEST(PackedSeq, SeqRoundTrip) {
+  bios::Seq seq;
+  seq.name = "chrM";
+  char* buffer = static_cast<char*>(malloc(11));
+  memcpy(buffer, "GATCacnNTT", 11);
+  seq.AdoptSequence(buffer, 10);
+
+  bios::PackedSeq packed;
+  packed.FromSeq(seq);
+  EXPECT_EQ("chrM", packed.name());
+  EXPECT_LT(packed.packed().size(), 4u);
+
+  bios::Seq unpacked;
+  packed.ToSeq(&unpacked);
+  EXPECT_EQ("chrM", unpacked.name);
+  EXPECT_EQ(10u, unpacked.size);
+  EXPECT_STREQ("GATCacnNTT", unpacked.sequence);
+}
+
+TEST(PackedSeq, Assign) {
+  std::vector<uint8_t> data(1, 0x1b);
+  std::vector<bios::PackedSeq::Block> n_blocks;
+  std::vector<bios::PackedSeq::Block> mask_blocks;
+  bios::PackedSeq::Block mask = {2, 2};
+  mask_blocks.push_back(mask);
+  bios::PackedSeq packed;
+  packed.Assign(4, &data, &n_blocks, &mask_blocks);
+  EXPECT_TRUE(data.empty());
+  EXPECT_TRUE(mask_blocks.empty());
+  EXPECT_EQ("TCag", packed.Substring(0, 4));
+}
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
@@ -0,0 +1,74 @@
+#include <cstring>
+#include <string>
+
+#include <gtest/gtest.h>
+#include <bios/revcomp.hh>
+
+TEST(Revcomp, ComplementBase) {
+  const std::string orig = " -=.acgtunACGTUNRYMKSWVHDBXryswmkvhdbx()";
+  const std::string tran = " -=.tgcaanTGCAANYRKMSWBDHVNyrswkmbdhvn)(";
+  for (size_t i = 0; i < orig.size(); ++i) {
+    EXPECT_EQ(tran[i], bios::revcomp::complement_base(orig[i]));
+  }
+  EXPECT_EQ(0, bios::revcomp::complement_base('Z'));
+  EXPECT_EQ(0, bios::revcomp::complement_base('\n'));
+  EXPECT_EQ(0, bios::revcomp::complement_base('\xc1'));
+}
+
+typedef void (*ComplementFunction)(char*, size_t);
+
+// Fills buffer with every byte value in turn, starting at seed, so that
+// both the IUPAC letters and bytes outside the table are covered.
+static void Fill(char* buffer, size_t length, int seed) {
+  for (size_t i = 0; i < length; ++i) {
+    buffer[i] = static_cast<char>((seed + i * 7) & 0xff);
+  }
+}
+
+// Checks an implementation against complement_base() on every length up to
+// 200 at several alignments, and that bytes around the range are untouched.
+static void CheckComplement(ComplementFunction complement, bool reverse) {
+  char buffer[256];
+  char expected[256];
+  for (size_t length = 0; length < 200; ++length) {
+    for (size_t offset = 0; offset < 5; ++offset) {
+      Fill(buffer, sizeof(buffer), length + offset);
+      memcpy(expected, buffer, sizeof(buffer));
+      for (size_t i = 0; i < length; ++i) {
+        char c = buffer[offset + (reverse ? length - 1 - i : i)];
+        expected[offset + i] = bios::revcomp::complement_base(c);
+      }
+      complement(buffer + offset, length);
+      ASSERT_EQ(0, memcmp(expected, buffer, sizeof(buffer)));
+    }
+  }
+}
+
+TEST(Revcomp, Scalar) {
+  CheckComplement(bios::revcomp::complement_scalar, false);
+  CheckComplement(bios::revcomp::reverse_complement_scalar, true);
+}
+
+#ifdef BIOS_X86
+TEST(Revcomp, Ssse3) {
+  if (bios::cpu::has_ssse3()) {
+    CheckComplement(bios::revcomp::complement_ssse3, false);
+    CheckComplement(bios::revcomp::reverse_complement_ssse3, true);
+  }
+}
+
+TEST(Revcomp, Avx2) {
+  if (bios::cpu::has_avx2()) {
+    CheckComplement(bios::revcomp::complement_avx2, false);
+    CheckComplement(bios::revcomp::reverse_complement_avx2, true);
+  }
+}
+#endif
+
+TEST(Revcomp, ReverseComplement) {
+  std::string dna = "ACGTNacgtnRYKM-";
+  bios::revcomp::reverse_complement(&dna[0], dna.size());
+  EXPECT_EQ("-KMRYnacgtNACGT", dna);
+  bios::revcomp::complement(&dna[0], dna.size());
+  EXPECT_EQ("-MKYRntgcaNTGCA", dna);
+}
@@ -0,0 +1,113 @@
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <bios/scan.hh>
+
+// Checks an implementation of find_byte() against every alignment and hit
+// position in a buffer long enough to cover the vector loops and the tail.
+static void CheckFindByte(const char* (*find)(const char*, const char*, char)) {
+  char buffer[200];
+  for (int length = 0; length < 150; ++length) {
+    for (int offset = 0; offset < 8; ++offset) {
+      memset(buffer, 'a', sizeof(buffer));
+      const char* begin = buffer + offset;
+      const char* end = begin + length;
+      EXPECT_EQ(end, find(begin, end, '\n'));
+      for (int hit = 0; hit < length; ++hit) {
+        buffer[offset + hit] = '\n';
+        EXPECT_EQ(begin + hit, find(begin, end, '\n'));
+        buffer[offset + hit] = 'a';
+      }
+      // A match just past the end must not be found.
+      buffer[offset + length] = '\n';
+      EXPECT_EQ(end, find(begin, end, '\n'));
+    }
+  }
+}
+
+TEST(Scan, FindByteScalar) {
+  CheckFindByte(bios::scan::find_byte_scalar);
+}
+
+#ifdef BIOS_X86
+TEST(Scan, FindByteSse2) {
+  if (bios::cpu::has_sse2()) {
+    CheckFindByte(bios::scan::find_byte_sse2);
+  }
+}
+
+TEST(Scan, FindByteAvx2) {
+  if (bios::cpu::has_avx2()) {
+    CheckFindByte(bios::scan::find_byte_avx2);
+  }
+}
+#endif
+
+TEST(Scan, FindNewline) {
+  std::string s = "chr1\t100\t200\nchr2";
+  const char* begin = s.data();
+  EXPECT_EQ(begin + 12, bios::scan::find_newline(begin, begin + s.size()));
+}
+
+typedef size_t (*FindAllFunction)(const char*, const char*, char,
+                                  uint32_t*, size_t);
+
+// Compares find against a plain loop on buffers of every length up to 100
+// at every alignment, with a pattern of separators, and with the output
+// capacity smaller than the number of matches.
+static void CheckFindAllBytes(FindAllFunction find) {
+  char buffer[256];
+  for (size_t i = 0; i < sizeof(buffer); ++i) {
+    buffer[i] = (i * 7) % 5 == 0 ? '\t' : 'a';
+  }
+  uint32_t positions[256];
+  for (int offset = 0; offset < 32; ++offset) {
+    for (int length = 0; length <= 100; ++length) {
+      const char* begin = buffer + offset;
+      const char* end = begin + length;
+      std::vector<uint32_t> expected;
+      for (int i = 0; i < length; ++i) {
+        if (begin[i] == '\t') {
+          expected.push_back(i);
+        }
+      }
+      size_t count = find(begin, end, '\t', positions, 256);
+      ASSERT_EQ(expected.size(), count);
+      for (size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(expected[i], positions[i]);
+      }
+      for (size_t max = 0; max < expected.size(); ++max) {
+        ASSERT_EQ(max, find(begin, end, '\t', positions, max));
+        for (size_t i = 0; i < max; ++i) {
+          EXPECT_EQ(expected[i], positions[i]);
+        }
+      }
+    }
+  }
+}
+
+TEST(Scan, FindAllBytesScalar) {
+  CheckFindAllBytes(bios::scan::find_all_bytes_scalar);
+}
+
+#ifdef BIOS_X86
+TEST(Scan, FindAllBytesSse2) {
+  if (bios::cpu::has_sse2()) {
+    CheckFindAllBytes(bios::scan::find_all_bytes_sse2);
+  }
+}
+
+TEST(Scan, FindAllBytesAvx2) {
+  if (bios::cpu::has_avx2()) {
+    CheckFindAllBytes(bios::scan::find_all_bytes_avx2);
+  }
+}
+#endif
+
+TEST(Scan, FindAllBytes) {
+  CheckFindAllBytes(bios::scan::find_all_bytes);
+}
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
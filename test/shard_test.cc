@@ -0,0 +1,79 @@
+#include <string>
+
+#include <bios/shard.hh>
+#include <gtest/gtest.h>
+
+TEST(FileSharder, NextBoundaryLines) {
+  const char data[] = "ab\ncd\nef";
+  size_t size = sizeof(data) - 1;
+  EXPECT_EQ(0u, bios::FileSharder::NextBoundary(data, size, 0,
+                                                bios::FileSharder::kLines));
+  EXPECT_EQ(3u, bios::FileSharder::NextBoundary(data, size, 1,
+                                                bios::FileSharder::kLines));
+  EXPECT_EQ(3u, bios::FileSharder::NextBoundary(data, size, 3,
+                                                bios::FileSharder::kLines));
+  EXPECT_EQ(size, bios::FileSharder::NextBoundary(data, size, 7,
+                                                  bios::FileSharder::kLines));
+}
+
+TEST(FileSharder, NextBoundaryFasta) {
+  const char data[] = ">a\nAC\nGT\n>b\nTT\n";
+  size_t size = sizeof(data) - 1;
+  EXPECT_EQ(9u, bios::FileSharder::NextBoundary(data, size, 1,
+                                                bios::FileSharder::kFasta));
+}
+
+TEST(FileSharder, NextBoundaryFastqSkipsQualityLines) {
+  const char data[] = "@r1\nACGT\n+\n@@@@\n@r2\nAC\n+\nII\n";
+  size_t size = sizeof(data) - 1;
+  // The quality line "@@@@" starts at 11 but is not a record start.
+  EXPECT_EQ(16u, bios::FileSharder::NextBoundary(data, size, 5,
+                                                 bios::FileSharder::kFastq));
+}
+
+TEST(FileSharder, ShardsCoverFile) {
+  bios::FileSharder sharder;
+  ASSERT_TRUE(sharder.Open("./in/lines.txt", 3));
+  EXPECT_EQ(3, sharder.num_shards());
+  std::string all;
+  int count = 0;
+  for (int i = 0; i < sharder.num_shards(); ++i) {
+    bios::LineStream* ls = sharder.OpenShard(i);
+    for (std::string line; ls->GetLine(line); ) {
+      all += line;
+      all += "|";
+      ++count;
+    }
+    delete ls;
+  }
+  EXPECT_EQ(4, count);
+  EXPECT_EQ("first line|second line||last line|", all);
+}
+
+TEST(FileSharder, FastqShards) {
+  bios::FileSharder sharder;
+  ASSERT_TRUE(sharder.Open("./in/reads.fq", 4, bios::FileSharder::kFastq));
+  EXPECT_EQ(4, sharder.num_shards());
+  int records = 0;
+  for (int i = 0; i < sharder.num_shards(); ++i) {
+    bios::LineStream* ls = sharder.OpenShard(i);
+    int lines = 0;
+    for (std::string line; ls->GetLine(line); ++lines) {
+      if (lines % 4 == 0) {
+        EXPECT_EQ('@', line[0]);
+      }
+    }
+    EXPECT_EQ(0, lines % 4);
+    records += lines / 4;
+    delete ls;
+  }
+  EXPECT_EQ(3, records);
+}
+
+TEST(FileSharder, RejectsCompressedFile) {
+  bios::FileSharder sharder;
+  EXPECT_FALSE(sharder.Open("./in/lines.txt.gz", 2));
+  EXPECT_FALSE(sharder.Open("./in/no-such-file", 2));
+}
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <bios/symbol.hh>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+TEST(SymbolTable, EmptyNameIsReserved) {
+  bios::SymbolTable table;
+  EXPECT_EQ(1u, table.size());
+  EXPECT_EQ(bios::SymbolTable::kEmptySymbol, table.Intern(""));
+  EXPECT_EQ("", table.Name(bios::SymbolTable::kEmptySymbol));
+}
+
+TEST(SymbolTable, InternReturnsStableIds) {
+  bios::SymbolTable table;
+  uint32_t chr1 = table.Intern("chr1");
+  uint32_t chr2 = table.Intern("chr2");
+  EXPECT_NE(chr1, chr2);
+  EXPECT_EQ(chr1, table.Intern(std::string("chr1")));
+  EXPECT_EQ(chr2, table.Intern(bios::StringPiece("chr22", 4)));
+  EXPECT_EQ("chr1", table.Name(chr1));
+  EXPECT_EQ("chr2", table.Name(chr2));
+  EXPECT_EQ(3u, table.size());
+}
+
+TEST(SymbolTable, Find) {
+  bios::SymbolTable table;
+  uint32_t chrx = table.Intern("chrX");
+  uint32_t id = 0;
+  EXPECT_TRUE(table.Find("chrX", &id));
+  EXPECT_EQ(chrx, id);
+  EXPECT_FALSE(table.Find("chrY", &id));
+  EXPECT_EQ(2u, table.size());
+}
+
+TEST(SymbolTable, CompareOrdersByName) {
+  bios::SymbolTable table;
+  uint32_t chr2 = table.Intern("chr2");
+  uint32_t chr10 = table.Intern("chr10");
+  EXPECT_EQ(0, table.Compare(chr2, chr2));
+  EXPECT_GT(table.Compare(chr2, chr10), 0);
+  EXPECT_LT(table.Compare(chr10, chr2), 0);
+}
+
+TEST(SymbolTable, NoSymbolIsNamedEmpty) {
+  bios::SymbolTable table;
+  uint32_t chr1 = table.Intern("chr1");
+  EXPECT_EQ("", table.Name(bios::SymbolTable::kNoSymbol));
+  EXPECT_EQ(0, table.Compare(bios::SymbolTable::kNoSymbol,
+                             bios::SymbolTable::kEmptySymbol));
+  EXPECT_LT(table.Compare(bios::SymbolTable::kNoSymbol, chr1), 0);
+}
+
+TEST(SymbolTable, ManyNames) {
+  bios::SymbolTable table;
+  std::vector<uint32_t> ids;
+  char name[32];
+  for (int i = 0; i < 5000; ++i) {
+    snprintf(name, sizeof(name), "scaffold_%d", i);
+    ids.push_back(table.Intern(name));
+  }
+  EXPECT_EQ(5001u, table.size());
+  for (int i = 0; i < 5000; ++i) {
+    snprintf(name, sizeof(name), "scaffold_%d", i);
+    EXPECT_EQ(ids[i], table.Intern(name));
+    EXPECT_EQ(name, table.Name(ids[i]));
+  }
+}
+
+TEST(SymbolCache, MatchesTable) {
+  bios::SymbolTable table;
+  bios::SymbolCache cache(&table);
+  uint32_t chr1 = cache.Intern("chr1");
+  EXPECT_EQ(chr1, cache.Intern("chr1"));
+  uint32_t chr2 = cache.Intern("chr2");
+  EXPECT_NE(chr1, chr2);
+  EXPECT_EQ(chr1, cache.Intern("chr1"));
+  EXPECT_EQ(chr1, table.Intern("chr1"));
+}
@@ -0,0 +1,125 @@
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <bios/revcomp.hh>
+#include <bios/seq.hh>
+#include <bios/translate.hh>
+#include <gtest/gtest.h>
+
+typedef void (*EncodeFunction)(const char*, size_t, uint8_t*);
+
+// Checks an implementation of encode_bases() on every byte value, at lengths
+// that cover the vector loops and the tail.
+static void CheckEncodeBases(EncodeFunction encode) {
+  char dna[300];
+  uint8_t codes[300];
+  for (size_t length = 0; length < sizeof(dna); length += 7) {
+    for (size_t i = 0; i < length; ++i) {
+      dna[i] = static_cast<char>(i * 11 + length);
+    }
+    encode(dna, length, codes);
+    for (size_t i = 0; i < length; ++i) {
+      uint8_t expected = N_BASE_VAL;
+      switch (dna[i]) {
+        case 'T': case 't': case 'U': case 'u': expected = T_BASE_VAL; break;
+        case 'C': case 'c': expected = C_BASE_VAL; break;
+        case 'A': case 'a': expected = A_BASE_VAL; break;
+        case 'G': case 'g': expected = G_BASE_VAL; break;
+      }
+      ASSERT_EQ(expected, codes[i]);
+    }
+  }
+}
+
+TEST(Translate, EncodeBasesScalar) {
+  CheckEncodeBases(bios::translate::encode_bases_scalar);
+}
+
+#ifdef BIOS_X86
+TEST(Translate, EncodeBasesSsse3) {
+  if (bios::cpu::has_ssse3()) {
+    CheckEncodeBases(bios::translate::encode_bases_ssse3);
+  }
+}
+
+TEST(Translate, EncodeBasesAvx2) {
+  if (bios::cpu::has_avx2()) {
+    CheckEncodeBases(bios::translate::encode_bases_avx2);
+  }
+}
+#endif
+
+TEST(Translate, FrameSize) {
+  EXPECT_EQ(0u, bios::translate::frame_size(2, 0));
+  EXPECT_EQ(1u, bios::translate::frame_size(3, 0));
+  EXPECT_EQ(0u, bios::translate::frame_size(3, 1));
+  EXPECT_EQ(3u, bios::translate::frame_size(10, 0));
+  EXPECT_EQ(3u, bios::translate::frame_size(10, 4));
+  EXPECT_EQ(2u, bios::translate::frame_size(10, 5));
+}
+
+TEST(Translate, Frame) {
+  std::string dna = "ATGgcuTAATGANNNtga";
+  char out[6];
+  EXPECT_EQ(6u, bios::translate::translate_frame(
+      dna.data(), dna.size(), bios::translate::kStandardCode, out));
+  EXPECT_EQ("MA**X*", std::string(out, 6));
+  bios::translate::translate_frame(
+      dna.data(), dna.size(), bios::translate::kMitochondrialCode, out);
+  EXPECT_EQ("MA*WXW", std::string(out, 6));
+}
+
+// Translates one frame codon by codon with Sequencer.
+static std::string Reference(std::string dna, int frame, bool mito) {
+  bios::Sequencer& sequencer = bios::Sequencer::GetInstance();
+  if (frame >= 3) {
+    bios::revcomp::reverse_complement(&dna[0], dna.size());
+  }
+  std::string protein;
+  for (size_t i = frame % 3; i + 3 <= dna.size(); i += 3) {
+    char aa = mito ? sequencer.LookupMitochondrialCodon(&dna[i])
+                   : sequencer.LookupCodon(&dna[i]);
+    protein += aa == 0 ? '*' : aa;
+  }
+  return protein;
+}
+
+TEST(Translate, SixFrames) {
+  srand(17);
+  // Long enough to span several encoding chunks.
+  for (size_t length = 0; length < 9000; length += length < 40 ? 1 : 997) {
+    std::string dna(length, 'A');
+    for (size_t i = 0; i < length; ++i) {
+      dna[i] = "ACGTacgtUN"[rand() % 10];
+    }
+    for (int mito = 0; mito < 2; ++mito) {
+      std::vector<std::string> frames(6);
+      char* out[6];
+      for (int f = 0; f < 6; ++f) {
+        frames[f].assign(bios::translate::frame_size(length, f), '?');
+        out[f] = &frames[f][0];
+      }
+      bios::translate::six_frames(
+          dna.data(), length,
+          mito ? bios::translate::kMitochondrialCode
+               : bios::translate::kStandardCode,
+          out);
+      for (int f = 0; f < 6; ++f) {
+        EXPECT_EQ(Reference(dna, f, mito), frames[f]);
+      }
+    }
+  }
+}
+
+TEST(Translate, SequencerDnaTranslate) {
+  bios::Sequencer& sequencer = bios::Sequencer::GetInstance();
+  char dna[] = "atgaaataggcc";
+  char* protein = sequencer.DnaTranslate(dna, false);
+  EXPECT_STREQ("MK*A", protein);
+  free(protein);
+  protein = sequencer.DnaTranslate(dna, true);
+  EXPECT_STREQ("MK", protein);
+  free(protein);
+}
@@ -0,0 +1,85 @@
+#include <string>
+
+#include <bios/packedseq.hh>
+#include <bios/twobit.hh>
+#include <gtest/gtest.h>
+
+static const char kChr1[] = "ACGTNNNNacgtACGTTTGGCCAAnnAC";
+
+TEST(TwoBitReader, Index) {
+  bios::TwoBitReader reader;
+  ASSERT_TRUE(reader.Open("./in/small.2bit"));
+  ASSERT_EQ(2u, reader.num_sequences());
+  EXPECT_EQ("chr1", reader.name(0));
+  EXPECT_EQ(28u, reader.size(0));
+  EXPECT_EQ("chrM", reader.name(1));
+  EXPECT_EQ(7u, reader.size(1));
+  size_t i;
+  ASSERT_TRUE(reader.Find("chrM", &i));
+  EXPECT_EQ(1u, i);
+  EXPECT_FALSE(reader.Find("chr2", &i));
+}
+
+TEST(TwoBitReader, FetchRanges) {
+  bios::TwoBitReader reader;
+  ASSERT_TRUE(reader.Open("./in/small.2bit"));
+  const std::string chr1 = kChr1;
+  std::string out;
+  for (uint32_t start = 0; start <= chr1.size(); ++start) {
+    for (uint32_t end = start; end <= chr1.size(); ++end) {
+      ASSERT_TRUE(reader.Fetch("chr1", start, end, &out));
+      EXPECT_EQ(chr1.substr(start, end - start), out);
+    }
+  }
+  ASSERT_TRUE(reader.Fetch("chrM", 0, 7, &out));
+  EXPECT_EQ("GATTACA", out);
+
+  EXPECT_FALSE(reader.Fetch("chrM", 3, 8, &out));
+  EXPECT_FALSE(reader.Fetch("chr2", 0, 1, &out));
+}
+
+TEST(TwoBitReader, FetchPacked) {
+  bios::TwoBitReader reader;
+  ASSERT_TRUE(reader.Open("./in/small.2bit"));
+  const std::string chr1 = kChr1;
+  for (uint32_t start = 0; start <= chr1.size(); ++start) {
+    for (uint32_t end = start; end <= chr1.size(); end += 3) {
+      bios::PackedSeq packed;
+      ASSERT_TRUE(reader.FetchPacked(0, start, end, &packed));
+      EXPECT_EQ("chr1", packed.name());
+      EXPECT_EQ(end - start, packed.size());
+      EXPECT_EQ(chr1.substr(start, end - start),
+                packed.Substring(0, end - start));
+
+      // Packing the same bases directly gives the same bytes.
+      bios::PackedSeq expected;
+      expected.Pack(chr1.data() + start, end - start);
+      EXPECT_TRUE(expected.packed() == packed.packed());
+    }
+  }
+}
+
+TEST(TwoBitReader, RejectsOtherFiles) {
+  bios::TwoBitReader reader;
+  EXPECT_FALSE(reader.Open("./in/basic.bed"));
+  EXPECT_FALSE(reader.Open("./in/does-not-exist.2bit"));
+  EXPECT_EQ(0u, reader.num_sequences());
+}
+
+TEST(TwoBitReader, RejectsBadIndexCount) {
+  bios::TwoBitReader reader;
+  EXPECT_FALSE(reader.Open("./in/bad_count.2bit"));
+  EXPECT_EQ(0u, reader.num_sequences());
+}
+
+TEST(TwoBitReader, ClipsBlocksPastSequence) {
+  // The last N block of chr1 starts at 24 and its size overflows 32 bits.
+  bios::TwoBitReader reader;
+  ASSERT_TRUE(reader.Open("./in/long_block.2bit"));
+  std::string out;
+  ASSERT_TRUE(reader.Fetch("chr1", 20, 28, &out));
+  EXPECT_EQ("CCAAnnNN", out);
+  bios::PackedSeq packed;
+  ASSERT_TRUE(reader.FetchPacked(0, 22, 28, &packed));
+  EXPECT_EQ("AAnnNN", packed.Substring(0, 6));
+}
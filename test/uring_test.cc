@@ -0,0 +1,40 @@
+#include <fcntl.h>
+#include <string>
+#include <unistd.h>
+
+#include <bios/uring.hh>
+#include <gtest/gtest.h>
+
+static const char kLines[] = "first line\nsecond line\r\n\nlast line";
+
+TEST(UringReader, ReadsFile) {
+  if (!bios::UringReader::IsSupported()) {
+    return;
+  }
+  int fd = open("./in/lines.txt", O_RDONLY);
+  ASSERT_TRUE(fd >= 0);
+  bios::UringReader reader;
+  // Small chunks so that the file takes several rounds of reads.
+  ASSERT_TRUE(reader.Open(fd, 2, 1));
+  std::string data;
+  char buffer[5];
+  for (size_t n; (n = reader.Read(buffer, sizeof(buffer))) > 0; ) {
+    data.append(buffer, n);
+  }
+  EXPECT_FALSE(reader.error());
+  EXPECT_EQ(std::string(kLines), data);
+  close(fd);
+}
+
+TEST(UringReader, RejectsPipe) {
+  int fds[2];
+  ASSERT_EQ(0, pipe(fds));
+  bios::UringReader reader;
+  EXPECT_FALSE(reader.Open(fds[0]));
+  char buffer[1];
+  EXPECT_EQ(0u, reader.Read(buffer, sizeof(buffer)));
+  close(fds[0]);
+  close(fds[1]);
+}
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */
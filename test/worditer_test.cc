@@ -25,4 +25,59 @@ TEST(WordIter, NoCollapseSeparatorsTest) {
   free(s);
 }
 
+TEST(WordIter, CollapseSeparatorsTest) {
+  bios::WordIter w("\t\ta\t\tb\t", "\t", true);
+  int size;
+  EXPECT_STREQ("a", w.Next(&size));
+  EXPECT_EQ(1, size);
+  EXPECT_STREQ("b", w.Next());
+  EXPECT_EQ(NULL, w.Next());
+}
+
+TEST(WordIter, EmptyFieldsTest) {
+  bios::WordIter w("a,,b", ",", false);
+  EXPECT_STREQ("a", w.Next());
+  EXPECT_STREQ("", w.Next());
+  EXPECT_STREQ("b", w.Next());
+  EXPECT_EQ(NULL, w.Next());
+}
+
+TEST(Tokenizer, DoesNotModifyInput) {
+  const char line[] = "chr1\t100\t200";
+  bios::Tokenizer t(bios::StringPiece(line, sizeof(line) - 1), "\t", false);
+  bios::StringPiece word;
+  ASSERT_TRUE(t.Next(&word));
+  EXPECT_EQ(bios::StringPiece("chr1"), word);
+  EXPECT_EQ(line, word.data());
+  ASSERT_TRUE(t.Next(&word));
+  EXPECT_EQ(bios::StringPiece("100"), word);
+  ASSERT_TRUE(t.Next(&word));
+  EXPECT_EQ(bios::StringPiece("200"), word);
+  EXPECT_FALSE(t.Next(&word));
+  EXPECT_FALSE(t.Next(&word));
+  EXPECT_STREQ("chr1\t100\t200", line);
+}
+
+TEST(Tokenizer, Reset) {
+  bios::SeparatorSet seps(", ");
+  bios::Tokenizer t(bios::StringPiece("a b"), seps, true);
+  bios::StringPiece word;
+  ASSERT_TRUE(t.Next(&word));
+  t.Reset(bios::StringPiece("c,d"));
+  ASSERT_TRUE(t.Next(&word));
+  EXPECT_EQ(bios::StringPiece("c"), word);
+  ASSERT_TRUE(t.Next(&word));
+  EXPECT_EQ(bios::StringPiece("d"), word);
+  EXPECT_FALSE(t.Next(&word));
+}
+
+TEST(SeparatorSet, HighCharacters) {
+  bios::SeparatorSet seps("\xff\t");
+  EXPECT_TRUE(seps.Contains('\xff'));
+  EXPECT_TRUE(seps.Contains('\t'));
+  EXPECT_FALSE(seps.Contains('\xfe'));
+  EXPECT_FALSE(seps.Contains('\0'));
+  EXPECT_FALSE(seps.Contains(' '));
+}
+
 /* vim: set ai ts=2 sts=2 sw=2 et: */
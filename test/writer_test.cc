@@ -0,0 +1,133 @@
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+
+#include <bios/bed.hh>
+#include <bios/gzip.hh>
+#include <bios/linestream.hh>
+#include <bios/writer.hh>
+#include <gtest/gtest.h>
+
+static const char* kOutput = "./writer_test.out";
+
+static std::string ReadFile(const char* filename) {
+  std::string data;
+  FILE* fp = fopen(filename, "rb");
+  if (fp == NULL) {
+    return data;
+  }
+  char buffer[4096];
+  for (size_t n; (n = fread(buffer, 1, sizeof(buffer), fp)) > 0; ) {
+    data.append(buffer, n);
+  }
+  fclose(fp);
+  return data;
+}
+
+TEST(RecordWriter, FormatsNumbers) {
+  bios::RecordWriter writer;
+  ASSERT_TRUE(writer.Open(kOutput));
+  writer.AppendInt(0);
+  writer.AppendChar(' ');
+  writer.AppendInt(-1234567890123LL);
+  writer.AppendChar(' ');
+  writer.AppendUint(18446744073709551615ULL);
+  writer.AppendChar(' ');
+  writer.AppendFixed(3.14159, 2);
+  writer.AppendChar(' ');
+  writer.AppendFixed(-0.5, 0);
+  writer.AppendChar(' ');
+  writer.AppendFixed(2.05, 3);
+  writer.AppendChar(' ');
+  writer.AppendDouble(1e-5);
+  ASSERT_TRUE(writer.Close());
+  EXPECT_EQ("0 -1234567890123 18446744073709551615 3.14 -1 2.050 1e-05",
+            ReadFile(kOutput));
+  unlink(kOutput);
+}
+
+TEST(RecordWriter, FormatsLargeFixed) {
+  const double values[] = {1e12, -1e12, 123456789.123456789, 9007199.254740993,
+                           1e15, 1.5e19, 1e300};
+  const int decimals[] = {0, 3, 6, 9};
+  std::string expected;
+  bios::RecordWriter writer;
+  ASSERT_TRUE(writer.Open(kOutput));
+  for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i) {
+    for (size_t j = 0; j < sizeof(decimals) / sizeof(decimals[0]); ++j) {
+      writer.AppendFixed(values[i], decimals[j]);
+      writer.AppendChar('\n');
+      char text[512];
+      snprintf(text, sizeof(text), "%.*f\n", decimals[j], values[i]);
+      expected += text;
+    }
+  }
+  ASSERT_TRUE(writer.Close());
+  EXPECT_EQ(expected, ReadFile(kOutput));
+  unlink(kOutput);
+}
+
+TEST(RecordWriter, LargeOutput) {
+  bios::RecordWriter writer;
+  ASSERT_TRUE(writer.Open(kOutput));
+  std::string expected;
+  for (int i = 0; i < 300000; ++i) {
+    writer.AppendInt(i);
+    writer.AppendChar('\n');
+    char line[16];
+    snprintf(line, sizeof(line), "%d\n", i);
+    expected += line;
+  }
+  ASSERT_TRUE(writer.Close());
+  EXPECT_TRUE(expected == ReadFile(kOutput));
+  unlink(kOutput);
+}
+
+TEST(RecordWriter, CompressedOutput) {
+  bios::RecordWriter::Compression modes[] = {
+    bios::RecordWriter::kGzip,
+    bios::RecordWriter::kBgzf
+  };
+  std::string expected;
+  for (int i = 0; i < 100000; ++i) {
+    char line[32];
+    snprintf(line, sizeof(line), "line %d\n", i);
+    expected += line;
+  }
+  for (size_t m = 0; m < 2; ++m) {
+    bios::RecordWriter writer;
+    ASSERT_TRUE(writer.Open(kOutput, modes[m]));
+    writer.Append(expected);
+    ASSERT_TRUE(writer.Close());
+    std::string compressed = ReadFile(kOutput);
+    EXPECT_TRUE(bios::GzipReader::IsGzip(compressed.data(),
+                                         compressed.size()));
+    EXPECT_EQ(modes[m] == bios::RecordWriter::kBgzf,
+              bios::BgzfReader::IsBgzf(compressed.data(), compressed.size()));
+    bios::FileLineStream ls(kOutput);
+    EXPECT_TRUE(ls.IsCompressed());
+    std::string data;
+    for (std::string line; ls.GetLine(line); ) {
+      data += line + "\n";
+    }
+    EXPECT_TRUE(expected == data);
+    unlink(kOutput);
+  }
+}
+
+TEST(Bed, AppendTo) {
+  bios::BedParser parser;
+  parser.InitFromStream(new bios::MemoryLineStream(
+      "chr1\t10\t20\tx\t5\t+\t10\t20\t0\t2\t3,4\t0,6\n"));
+  bios::Bed* bed = parser.NextEntry();
+  ASSERT_TRUE(bed != NULL);
+  bios::RecordWriter writer;
+  ASSERT_TRUE(writer.Open(kOutput));
+  bed->AppendTo(&writer);
+  ASSERT_TRUE(writer.Close());
+  EXPECT_EQ(bed->ToString() + "\n", ReadFile(kOutput));
+  delete bed;
+  unlink(kOutput);
+}
+
+/* vim: set ai ts=2 sts=2 sw=2 et: */